@@ -17,6 +17,9 @@ namespace flags {
 	/// Whether to show spread index for every tile.
 	extern bool spread;
 
+	/// Whether incremental tile counts & region index are checked against full map scans.
+	extern bool verify;
+
 	/// Processes a keyboard event.
 	/// 
 	/// @param evt Event data.
@@ -43,6 +43,15 @@ private:
 	Hex*        _tiles {}; /// Tile container.
 	sf::Vector2i _size {}; /// Array size.
 
+	/// Spread visit mark planes.
+	///
+	/// Stored apart from the tiles, so spread passes
+	/// and mark scans walk a dense array instead of whole hexes.
+	std::unique_ptr<size_t[]> _marks[2];
+
+	/// Whether the tiles are borrowed from another array.
+	bool _view = false;
+
 public:
 	/// Constructs an empty array.
 	HexArray();
@@ -70,6 +79,20 @@ public:
 	/// @param size Array size.
 	void empty(sf::Vector2i size);
 
+	/// Creates a view of the array.
+	///
+	/// The view shares tiles with the array, but has its own
+	/// spread visit marks, so spreads can run on the view from
+	/// another thread while no thread is modifying the tiles.
+	///
+	/// The view must not outlive the array and must not be resized.
+	HexArray view() const;
+
+	/// Checks if the array is a view of another array.
+	///
+	/// @param array Viewed array.
+	bool views(const HexArray& array) const;
+
 	/// Resizes the array.
 	/// 
 	/// Old tiles are preserved.
@@ -88,6 +111,28 @@ public:
 	/// @param pos Tile position.
 	bool contains(sf::Vector2i pos) const;
 
+	/// Returns linear index of a tile.
+	///
+	/// Indexes every per-tile plane of the array.
+	/// 
+	/// @param pos Tile position (must be within the map).
+	size_t index(sf::Vector2i pos) const { return (size_t)pos.y * _size.x + pos.x; };
+
+	/// Returns spread visit mark plane.
+	///
+	/// The plane is indexed by `index()`.
+	/// 
+	/// @param alt Whether to return alternative spread index plane.
+	size_t* marks(bool alt) const { return _marks[alt].get(); };
+
+	/// Returns spread visit mark of a tile.
+	///
+	/// @param pos Tile position.
+	/// @param alt Whether to use alternative spread index.
+	/// 
+	/// @return Last spread index that visited the tile, 0 if outside the map.
+	size_t mark(sf::Vector2i pos, bool alt) const;
+
 protected:
 	/// Unsafe tile look-up.
 	/// 
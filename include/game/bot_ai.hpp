@@ -21,14 +21,26 @@ namespace ai {
 		Hex* hex, sf::Vector2i pos
 	);
 
+	/// Minimum candidate count for parallel ranking.
+	///
+	/// Shorter lists are ranked on the calling thread, as waking
+	/// the workers up costs more than ranking them.
+	/// Chosen positions do not depend on this setting.
+	extern size_t parallel_min;
+
 	/// Randomly returns a position with the highest ranking.
 	/// 
+	/// Lists of at least `parallel_min` positions are ranked on the AI
+	/// worker pool, unless it is used by a generator on another thread.
+	/// 
+	/// @param rng Random number generator.
 	/// @param list Position list.
-	/// @param rank Ranking function.
+	/// @param rank Ranking function, must not modify the map if the list may be ranked in parallel.
 	/// @param diff Difficulty.
 	/// 
 	/// @return Chosen position.
 	std::optional<sf::Vector2i> get(
+		Random::Generator& rng,
 		const Spread::List& list,
 		std::function<void(sf::Vector2i, int&)> rank,
 		float diff
@@ -54,9 +66,134 @@ namespace ai {
 	/// @param map Map reference.
 	/// @param team Controlled team.
 	/// @param diff AI difficulty.
+	/// @param troops Whether to generate troop actions.
+	/// @param budget Time budget (in seconds, unlimited if 0).
+	///   Checked before each region, purchase and entity,
+	///   once out of time, the rest is left without moves.
 	/// 
 	/// @return Move list.
-	History::UniqList generate(Map& map, Region::Team team, float diff);
+	History::UniqList generate(Map& map, Region::Team team, float diff, bool troops = true, double budget = 0);
+
+	/// Lookahead search settings.
+	struct SearchConfig {
+		double budget = 0.05;   /// Time budget per turn (in seconds).
+		int depth = 3;          /// Maximum search depth (in plies).
+		size_t table = 1 << 16; /// Transposition table entry count (power of 2).
+		size_t moves = 64;      /// Maximum amount of actions per turn.
+
+		/// Returns settings for a difficulty.
+		///
+		/// Difficulty only scales the compute budget.
+		///
+		/// @param diff AI difficulty.
+		static SearchConfig scaled(float diff);
+	};
+
+	/// Lookahead search statistics.
+	struct SearchStats {
+		size_t nodes = 0; /// Visited node count.
+		size_t hits = 0;  /// Transposition table hit count.
+		size_t moves = 0; /// Executed action count.
+		int depth = 0;    /// Deepest completed iteration.
+		double time = 0;  /// Time spent searching (in seconds).
+
+		/// Returns visited nodes per second.
+		double rate() const { return time > 0 ? nodes / time : 0.0; };
+
+		/// Adds statistics of another search.
+		void add(const SearchStats& other);
+	};
+
+	/// Lookahead search action.
+	struct SearchAction {
+		sf::Vector2i from;    /// Troop position.
+		sf::Vector2i to;      /// Target position.
+		uint8_t skill = 0xFF; /// Skill index, `0xFF` for ending the turn.
+
+		/// Checks whether the action ends the turn.
+		bool empty() const { return skill == 0xFF; };
+
+		/// Compares actions.
+		bool operator==(const SearchAction& other) const {
+			return from == other.from && to == other.to && skill == other.skill;
+		};
+	};
+
+	/// Lookahead search transposition table.
+	///
+	/// Stores searched positions by their key, one entry per slot.
+	/// A position stored into a taken slot replaces the previous one.
+	class SearchTable {
+	public:
+		/// Stored score bound type.
+		enum Bound : uint8_t {
+			Exact, /// Score is exact.
+			Lower, /// Score is a lower bound (search failed high).
+			Upper, /// Score is an upper bound (search failed low).
+		};
+
+		/// Table entry.
+		struct Entry {
+			uint64_t key = 0;    /// Position key.
+			int score = 0;       /// Position score.
+			int8_t depth = -1;   /// Searched depth.
+			Bound bound = Exact; /// Score bound type.
+			SearchAction best;   /// Best action found.
+		};
+
+	private:
+		std::vector<Entry> _entries; /// Table entries.
+
+	public:
+		/// Constructs an empty table.
+		///
+		/// @param size Entry count, rounded up to a power of 2.
+		explicit SearchTable(size_t size);
+
+		/// Returns entry count.
+		size_t size() const { return _entries.size(); };
+
+		/// Returns a stored position.
+		///
+		/// @param key Position key.
+		///
+		/// @return Entry pointer, or `nullptr` if the position is not stored.
+		const Entry* find(uint64_t key) const;
+
+		/// Returns a stored score usable without searching.
+		///
+		/// @param key Position key.
+		/// @param depth Required search depth.
+		/// @param alpha Lower score bound.
+		/// @param beta Upper score bound.
+		///
+		/// @return Stored score, if searched deep enough and its bound decides the search.
+		std::optional<int> cutoff(uint64_t key, int depth, int alpha, int beta) const;
+
+		/// Stores a searched position.
+		///
+		/// @param key Position key.
+		/// @param depth Searched depth.
+		/// @param score Position score.
+		/// @param alpha Lower score bound the position was searched with.
+		/// @param beta Upper score bound the position was searched with.
+		/// @param best Best action found.
+		void store(uint64_t key, int depth, int score, int alpha, int beta, const SearchAction& best);
+	};
+
+	/// Executes troop actions for a team using a lookahead search.
+	///
+	/// Actions are tried in place with `Move::apply()` and undone with
+	/// `Move::revert()`, alternating between the team and its enemies
+	/// in an iterative deepening alpha-beta search.
+	/// Chosen actions are executed through `Map::executeSkill()`,
+	/// so they end up in map history same as with `generate()`.
+	///
+	/// @param map Map reference.
+	/// @param team Controlled team.
+	/// @param config Search settings.
+	/// @param stats Statistics to add to (optional).
+	void search(Map& map, Region::Team team, const SearchConfig& config, SearchStats* stats = nullptr);
 
 	/// Returns a list of all map teams.
 	/// 
@@ -0,0 +1,150 @@
+#pragma once
+
+// include dependencies
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <functional>
+#include <vector>
+#include "ui/buffer.hpp"
+
+// map forward declaration
+class Map;
+
+namespace Draw {
+	/// Retained static map geometry.
+	///
+	/// Tile bases, sides and borders only change together with tiles,
+	/// so they are cached in map space for every row segment and rebuilt
+	/// only when a tile in or next to the segment changes.
+	///
+	/// Segments are a single row tall, so appending them row by row
+	/// keeps the overlap order of tiles drawn one by one.
+	/// Segments with an elevated tile are drawn live instead,
+	/// as tile elevation is animated.
+	///
+	/// Edge masks of every tile (visible borders & sides) are kept
+	/// next to the geometry and recomputed only for changed tiles
+	/// and their neighbors.
+	class MapMesh {
+	public:
+		/// Segment width in tiles.
+		static constexpr int Width = 32;
+
+		/// Cached geometry layer.
+		enum Layer {
+			Ground,  /// Tile bases & sides.
+			Borders, /// Tile borders.
+			Lod,     /// Low detail tile runs.
+			Count,   /// Layer count.
+		};
+
+		/// Edge mask bits of visible borders, one per neighbor direction.
+		static constexpr uint8_t BorderMask = 0x3F;
+		/// Edge mask bit set if tile sides can be seen.
+		static constexpr uint8_t SideMask = 0x40;
+
+		/// Tile geometry drawing function.
+		///
+		/// Called with target buffer, tile coordinates and tile draw origin.
+		using Painter = std::function<void(ui::RenderBuffer&, sf::Vector2i, sf::Vector2i)>;
+
+	private:
+		/// Cached row segment.
+		struct Segment {
+			std::vector<sf::Vertex> layers[Count];    /// Layer vertices in map space.
+			bool stale[Count] = { true, true, true }; /// Whether a layer must be rebuilt.
+		};
+
+		/// Tracked tile with animated elevation.
+		struct Lift {
+			sf::Vector2i pos; /// Tile position.
+			bool up = false;  /// Whether the tile was elevated at last update.
+		};
+
+		sf::Vector2i _size;                 /// Map size.
+		int _row = 0;                       /// Segment count in a row.
+		std::vector<Segment> _segments;     /// Row segments.
+		std::vector<Lift> _lifted;          /// Tracked elevated tiles.
+		ui::RenderBuffer _scratch;          /// Segment rebuild buffer.
+		std::vector<uint8_t> _edges;        /// Edge mask of every tile.
+		std::vector<sf::Vector2i> _changed; /// Tiles with stale edge masks around them.
+		std::vector<sf::Vector2i> _raised;  /// Elevated tiles of the current frame.
+		bool _remask = true;                /// Whether every edge mask is stale.
+
+		/// Resizes the cache with the map.
+		///
+		/// @param map Map reference.
+		void resize(const Map& map);
+
+		/// Recomputes stale edge masks.
+		///
+		/// @param map Map reference.
+		void remask(const Map& map);
+
+	public:
+		/// Drops all cached geometry.
+		void clear();
+
+		/// Marks every segment as changed.
+		void invalidate();
+
+		/// Marks every segment and edge mask as changed.
+		///
+		/// Used when tiles were modified without being touched.
+		void reset();
+
+		/// Marks segments & edge masks of a tile and its neighbors as changed.
+		///
+		/// @param pos Tile position.
+		void touch(sf::Vector2i pos);
+
+		/// Tracks a tile with animated elevation.
+		///
+		/// The tile is followed until it is lowered back,
+		/// nearby segments are rebuilt when it rises or lands.
+		///
+		/// @param pos Tile position.
+		void lift(sf::Vector2i pos);
+
+		/// Prepares segments for drawing.
+		///
+		/// Resizes the cache with the map, checks tracked tiles
+		/// and recomputes stale edge masks.
+		///
+		/// @param map Map reference.
+		void update(const Map& map);
+
+		/// Returns edge mask of a tile.
+		///
+		/// Stale masks are recomputed first.
+		///
+		/// @param map Map reference.
+		/// @param pos Tile position (must be on the map).
+		uint8_t edges(const Map& map, sf::Vector2i pos);
+
+		/// Returns a list of elevated tiles drawn on top in the current frame.
+		///
+		/// The list is kept between frames, so collecting tiles does not allocate.
+		std::vector<sf::Vector2i>& elevated();
+
+		/// Checks whether a segment has to be drawn live.
+		///
+		/// @param y Segment row.
+		/// @param seg Segment index in the row.
+		bool live(int y, int seg) const;
+
+		/// Appends segment geometry, rebuilding it if needed.
+		///
+		/// @param target Target render buffer.
+		/// @param layer Geometry layer.
+		/// @param y Segment row.
+		/// @param seg Segment index in the row.
+		/// @param offset Map space to screen offset.
+		/// @param paint Tile drawing function for rebuilds.
+		void append(
+			ui::RenderBuffer& target, Layer layer,
+			int y, int seg, sf::Vector2i offset,
+			const Painter& paint
+		);
+	};
+};
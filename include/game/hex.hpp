@@ -40,24 +40,28 @@ struct HexEnt {
 
 /// Hex tile.
 /// Contains tile status and reference to objects placed on it.
+/// Only spread marks are kept in `HexArray` planes, the remaining fields
+/// are scanned map-wide only on construction & rebuilds.
 struct Hex : HexBase, HexEnt {
 	using HexBase::Type;
 
-	float elevation  = 0;        /// Tile elevation.
-	size_t selected  = 0;        /// Selection index.
-	size_t spread[2] = { 0, 0 }; /// Spread buffer indices.
+	float elevation = 0; /// Tile elevation.
+	size_t selected = 0; /// Selection index.
 
 private:
-	Regions::Ref _region; /// Tile region reference.
+	mutable Regions::Ref _region; /// Tile region reference.
 
 public:
 	/// Adds the tile to the region.
 	///
 	/// @param ref Region reference.
-	void join(Regions::Ref ref);
+	/// @param pos Tile position.
+	void join(Regions::Ref ref, sf::Vector2i pos);
 
 	/// Removes the tile from the region.
-	void leave();
+	///
+	/// @param pos Tile position.
+	void leave(sf::Vector2i pos);
 
 	/// Returns current tile region.
 	const Regions::Ref& region() const;
@@ -1,21 +1,40 @@
 #pragma once
 
 // include dependencies
-#include "moves.hpp"
+#include "move_log.hpp"
 #include <memory>
 #include <optional>
-#include <span>
 
 /// History of reversible moves on a game map.
+///
+/// Moves are kept encoded in move logs, next to the applied state
+/// saved by every done move, so undone moves are decoded and reverted
+/// without keeping a move object per move.
 class History {
 private:
-	/// Move list.
-	std::vector<std::unique_ptr<Move>> _list;
-	/// Currently shown move.
-	size_t _cursor {};
+	/// Done moves, in order.
+	MoveLog _done;
+	/// Undone moves, last undone move at the back.
+	MoveLog _undone;
+	/// Encoded applied state of done moves.
+	std::vector<uint8_t> _state;
+	/// Applied state start of every done move.
+	std::vector<uint32_t> _starts;
+	/// Moves decoded for `last()` & `next()`.
+	mutable std::unique_ptr<Move> _shown[2];
 	/// Map reference.
 	Map* _map {};
 
+	/// Logs a done move with its applied state.
+	///
+	/// @param move Applied move.
+	void _push(const Move* move);
+
+	/// Decodes the last done move with its applied state.
+	///
+	/// @return Move ready to be reverted (`null` if invalid).
+	std::unique_ptr<Move> _top() const;
+
 public:
 	/// Constructs move history for a game map.
 	/// 
@@ -27,7 +46,8 @@ public:
 
 	/// Adds a new move queue to history.
 	/// 
-	/// Added move will be immediately applied.
+	/// Added move will be immediately applied,
+	/// then logged and destroyed.
 	/// 
 	/// @param move Allocated move object.
 	void add(Move* move);
@@ -46,25 +66,28 @@ public:
 	std::optional<sf::Vector2i> redo();
 
 	/// Reference move list type.
-	/// 
-	/// Does not own the pointed memory.
-	///
-	/// Can be instantiated from a `UniqList`.
-	using SpanList = std::span<const std::unique_ptr<Move>>;
+	using SpanList = MoveLog::SpanList;
 	/// Transfer move list type.
-	///
-	/// Owns the pointed memory.
-	/// 
-	/// Can be casted to `SpanList`.
-	using UniqList = std::vector<std::unique_ptr<Move>>;
+	using UniqList = MoveLog::UniqList;
+
+	/// Returns a log of applied moves.
+	const MoveLog& log() const;
 
-	/// Returns a list of applied moves.
-	SpanList list() const;
+	/// Takes out all applied moves.
+	///
+	/// Reverted moves are dropped and the history is cleared.
+	MoveLog release();
 	/// Returns amount of moves done & reverted. 
 	std::pair<size_t, size_t> count() const;
 
 	/// Returns last move.
+	///
+	/// The move is decoded on every call,
+	/// the previous pointer is invalidated.
 	const Move* last() const;
 	/// Returns next move.
+	///
+	/// The move is decoded on every call,
+	/// the previous pointer is invalidated.
 	const Move* next() const;
-};
\ No newline at end of file
+};
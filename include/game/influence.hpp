@@ -0,0 +1,133 @@
+#pragma once
+
+// include dependencies
+#include "array.hpp"
+
+/// Per-team influence fields of a map.
+///
+/// Every tile stores, for every team:
+/// - total offense and amount of team troops within `reach` tiles,
+/// - amount of team tiles next to it.
+///
+/// The tile itself is never counted, same as in a spread.
+/// Fields are built in a single pass, where every tile scatters
+/// its contribution onto its neighborhood, and then updated
+/// incrementally from tiles marked as changed.
+class Influence {
+public:
+	/// Troop influence radius.
+	static constexpr size_t reach = 2;
+
+	/// Influence of a single team on a tile.
+	struct Cell {
+		int power  = 0; /// Total troop offense within reach.
+		int troops = 0; /// Troop count within reach.
+		int tiles  = 0; /// Neighboring tile count.
+	};
+
+private:
+	/// Contribution of a tile.
+	struct Source {
+		Region::Team team = Region::Unclaimed; /// Tile team.
+		bool troop = false;                    /// Whether the tile has a troop.
+		int power = 0;                         /// Troop offense.
+
+		/// Compares contributions.
+		bool operator==(const Source&) const = default;
+	};
+
+	std::vector<Cell> _teams[Region::Count]; /// Field of every team.
+	std::vector<Cell> _total;                /// Field of all teams combined.
+	std::vector<Source> _sources;            /// Counted contribution of every tile.
+	std::vector<size_t> _dirty;              /// Indices of tiles changed since last update.
+	int _width = 0;                          /// Array width.
+	bool _active = false;                    /// Whether the fields are built.
+
+	/// Returns contribution of a tile.
+	///
+	/// @param hex Tile reference.
+	static Source source(const Hex& hex);
+
+	/// Adds or removes a tile contribution.
+	///
+	/// @param array Tile array.
+	/// @param pos Tile position.
+	/// @param src Tile contribution.
+	/// @param sign `1` to add, `-1` to remove.
+	void scatter(const HexArray& array, sf::Vector2i pos, const Source& src, int sign);
+
+public:
+	/// Drops the fields.
+	///
+	/// Fields are rebuilt on the next update.
+	void clear();
+
+	/// Marks a tile as changed.
+	///
+	/// Ignored until the fields are built.
+	///
+	/// @param idx Linear tile index.
+	void touch(size_t idx) {
+		if (_active) _dirty.push_back(idx);
+	};
+
+	/// Builds all fields from scratch.
+	///
+	/// @param array Tile array.
+	void build(const HexArray& array);
+
+	/// Brings the fields up to date.
+	///
+	/// Builds the fields if needed, otherwise only changed tiles are recounted.
+	/// Checked against a full rebuild when `flags::verify` is set.
+	///
+	/// @param array Tile array.
+	void update(const HexArray& array);
+
+	/// Returns influence of a team on a tile.
+	///
+	/// @param pos Tile position (must be within the map).
+	/// @param team Team index.
+	const Cell& at(sf::Vector2i pos, Region::Team team) const {
+		return _teams[team][(size_t)pos.y * _width + pos.x];
+	};
+
+	/// Returns influence of all teams on a tile.
+	///
+	/// @param pos Tile position (must be within the map).
+	const Cell& at(sf::Vector2i pos) const {
+		return _total[(size_t)pos.y * _width + pos.x];
+	};
+
+	/// Returns total offense of enemy troops in reach of a tile.
+	///
+	/// @param pos Tile position.
+	/// @param team Friendly team.
+	int threat(sf::Vector2i pos, Region::Team team) const {
+		return at(pos).power - at(pos, team).power;
+	};
+
+	/// Returns amount of enemy troops in reach of a tile.
+	///
+	/// @param pos Tile position.
+	/// @param team Friendly team.
+	int enemies(sf::Vector2i pos, Region::Team team) const {
+		return at(pos).troops - at(pos, team).troops;
+	};
+
+	/// Returns total offense of friendly troops in reach of a tile.
+	///
+	/// @param pos Tile position.
+	/// @param team Friendly team.
+	int defense(sf::Vector2i pos, Region::Team team) const {
+		return at(pos, team).power;
+	};
+
+	/// Returns amount of friendly tiles next to a tile.
+	///
+	/// @param pos Tile position.
+	/// @param team Friendly team.
+	int value(sf::Vector2i pos, Region::Team team) const {
+		return at(pos, team).tiles;
+	};
+};
@@ -3,6 +3,7 @@
 // include dependencies
 #include "game/skill.hpp"
 #include "game/map.hpp"
+#include "game/radius.hpp"
 
 /// Skill implementation helper functions.
 namespace skillf {
@@ -21,6 +22,20 @@ namespace skillf {
 	/// @param region Target region.
 	Spread::Check sameRegionHop(const Regions::Ref& region);
 
+	/// Allows spreading only to solid tiles.
+	///
+	/// Statically typed version of `solidHop`.
+	struct SolidHop {
+		bool operator()(const Spread::Tile& tile) const { return tile.hex->solid(); };
+	};
+
+	/// Allows selection only if a tile is empty.
+	///
+	/// Statically typed version of `emptyPass`.
+	struct EmptyPass {
+		bool operator()(const Spread::Tile& tile) const { return tile.hex->free(); };
+	};
+
 	/// Allows spreading only to solid tiles.
 	extern const Spread::Check solidHop;
 
@@ -43,16 +58,26 @@ namespace skillf {
 	/// @param pos Neighborhood center.
 	/// @param radius Neighborhood radius.
 	/// @param check Test function.
-	/// @param alt Whether to use alternative spread index.
+	/// @param alt Whether to use alternative spread index (only used for radii above `Radius::Max`).
 	/// 
 	/// @return Amount of tests passed.
-	size_t checkAround(
+	template <typename Check> size_t checkAround(
 		Map* map,
 		sf::Vector2i pos,
 		size_t radius,
-		Spread::Check check,
+		const Check& check,
 		bool alt
-	);
+	) {
+		size_t counter = 0;
+
+		// test every tile around
+		Radius::each(*map, pos, radius, [&](const Spread::Tile& tile) {
+			if (check(tile)) counter++;
+		}, alt);
+
+		// return test stats
+		return counter;
+	};
 
 	/// Checks if a tile is near water.
 	/// 
@@ -31,7 +31,19 @@ namespace logic {
 		size_t total = 0;
 	};
 
+	/// Counts tiles for every team by scanning the whole map.
+	///
+	/// Used to validate incremental counts.
+	///
+	/// @param map Map reference.
+	///
+	/// @return Unsorted map tile count.
+	TileCount scan(const Map* map);
+
 	/// Counts tiles for every team.
+	///
+	/// Reads incremental map counters, so the cost does not depend on map size.
+	/// Counters are checked against `scan()` when `flags::verify` is set.
 	/// 
 	/// @param map Map reference.
 	/// @param players Player list.
@@ -2,14 +2,19 @@
 
 // include dependencies
 #include <SFML/System/Vector2.hpp>
+#include <array>
 #include "ui/buffer.hpp"
 #include "dev/dev_game.hpp"
 
 #include "assets.hpp"
 #include "mathext.hpp"
+#include "random.hpp"
 #include "array.hpp"
 #include "spread.hpp"
+#include "influence.hpp"
 #include "history.hpp"
+#include "draw/map_mesh.hpp"
+#include "values/shared.hpp"
 
 #include "logic/troop_logic.hpp"
 #include "logic/build_logic.hpp"
@@ -36,6 +41,13 @@ public:
 	Map();
 
 	sf::IntRect camera; /// Map camera.
+	float zoom = 1.f;   /// Camera zoom (map units per screen pixel).
+
+	/// Camera zoom from which the map is drawn in low detail.
+	///
+	/// Low detail maps are drawn as team colored tile runs,
+	/// entities are drawn without health bars & effects.
+	float lodZoom = Values::lodZoom;
 
 	/// Clears the map.
 	void clear();
@@ -63,6 +75,21 @@ private:
 	size_t _select_idx = 0;  /// Selection index.
 	bool _selection = false; /// Whether a selection is happening.
 
+	std::vector<uint64_t> _keys; /// Zobrist key of every tile.
+	std::vector<uint8_t> _teams; /// Counted team of every tile (`Region::Count` if not solid).
+	std::vector<size_t>  _dirty; /// Indices of tiles changed since last update.
+	uint64_t          _hash = 0; /// Zobrist hash of all tiles.
+
+	std::array<size_t, Region::Count> _tiles {}; /// Solid tile count of every team.
+	size_t                           _solid = 0; /// Total solid tile count.
+
+	/// Updates hash keys & tile counts of changed tiles.
+	void update();
+
+	Influence _influence; /// Bot AI influence fields.
+
+	mutable Draw::MapMesh _mesh; /// Cached tile geometry.
+
 public:
 	/// Returns troop iterator.
 	Pool<Troop>::It troopList();
@@ -82,6 +109,10 @@ public:
 	History history;
 	/// Region manager.
 	Regions regions;
+	/// Map random number generator.
+	///
+	/// Seeded from `Messages::Init`, so every peer rolls the same numbers.
+	Random::Generator random;
 	/// Tile pulse annotation.
 	std::optional<sf::Vector2i> pulse;
 	/// Defensive building position.
@@ -99,6 +130,59 @@ public:
 	const Regions::Ref& selectedRegion() const;
 
 public:
+	/// Marks a tile as changed.
+	///
+	/// Changed tiles are rehashed and recounted on the next
+	/// `hash()` or `tiles()` call.
+	/// Entity setters mark their tiles automatically, moves
+	/// mark every tile they modify directly.
+	///
+	/// @param pos Tile position.
+	void touch(sf::Vector2i pos);
+
+	/// Marks a tile with animated elevation.
+	///
+	/// Elevated tiles are drawn outside of cached geometry,
+	/// the tile is followed until it is lowered back.
+	///
+	/// @param pos Tile position.
+	void lift(sf::Vector2i pos);
+
+	/// Returns edge mask of a tile.
+	///
+	/// Bits of `Draw::MapMesh::BorderMask` mark borders facing each
+	/// neighbor, `Draw::MapMesh::SideMask` is set if tile sides can be seen.
+	/// Masks are recomputed only around touched & lifted tiles.
+	///
+	/// @param pos Tile position (must be on the map).
+	uint8_t edges(sf::Vector2i pos) const;
+
+	/// Recomputes the map hash & tile counts from scratch.
+	///
+	/// Should be invoked after the map is constructed.
+	void rehash();
+
+	/// Returns Zobrist hash of the map state.
+	///
+	/// Covers tile types, teams, entities and region resources.
+	/// Tile & region keys are updated incrementally, so the hash can be used
+	/// to compare map states between peers or as a transposition key.
+	uint64_t hash();
+
+	/// Returns influence fields of the map.
+	///
+	/// Fields are built on first use and then updated from changed tiles.
+	const Influence& influence();
+
+	/// Returns solid tile count of a team.
+	///
+	/// Counts are updated incrementally from changed tiles.
+	///
+	/// @param team Team index.
+	size_t tiles(Region::Team team);
+	/// Returns total solid tile count.
+	size_t tiles();
+
 	/// Removes any entities from the hex.
 	///
 	/// @param hex Hex reference.
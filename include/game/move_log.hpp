@@ -0,0 +1,124 @@
+#pragma once
+
+// include dependencies
+#include "moves.hpp"
+#include "serialize/buffer.hpp"
+#include <memory>
+#include <span>
+
+/// Compact log of encoded moves.
+///
+/// Every move is stored as a fixed-size record pointing into a single
+/// payload buffer, which holds size-prefixed moves in their network encoding.
+/// A log grows by two allocations at most, instead of one per move,
+/// and is sent as-is, without encoding moves again.
+///
+/// Moves are decoded back into objects only when needed.
+/// Size prefixes let a received log be split into moves
+/// by reading move headers only.
+/// Applied state (fields prefixed with `a_`) is not stored,
+/// so moves decoded from a log must be applied before reverting
+/// (`History` stores it separately with `Serialize::encodeApplied()`).
+class MoveLog {
+public:
+	/// Reference move list type.
+	/// 
+	/// Does not own the pointed memory.
+	///
+	/// Can be instantiated from a `UniqList`.
+	using SpanList = std::span<const std::unique_ptr<Move>>;
+	/// Transfer move list type.
+	///
+	/// Owns the pointed memory.
+	/// 
+	/// Can be casted to `SpanList`.
+	using UniqList = std::vector<std::unique_ptr<Move>>;
+
+	/// Logged move record.
+	struct Record {
+		uint32_t offset;  /// Payload start in the buffer, after the size prefix.
+		uint16_t size;    /// Payload size (in bytes).
+		uint8_t tag;      /// Move type (`Serialize::MoveType`).
+		uint8_t cooldown; /// Skill cooldown.
+	};
+
+private:
+	std::vector<Record> _records; /// Move records.
+	std::vector<uint8_t> _data;   /// Encoded move payloads.
+
+public:
+	/// Clears the log.
+	void clear();
+
+	/// Adds a move to the log.
+	///
+	/// @param move Logged move.
+	void push(const Move* move);
+
+	/// Adds a move list to the log.
+	///
+	/// @param list Logged moves.
+	void push(SpanList list);
+
+	/// Copies an encoded move from another log.
+	///
+	/// @param log Source log.
+	/// @param idx Move index in the source log.
+	void push(const MoveLog& log, size_t idx);
+
+	/// Copies all encoded moves from another log.
+	///
+	/// @param log Source log.
+	void push(const MoveLog& log);
+
+	/// Drops the last move.
+	///
+	/// Does nothing if the log is empty.
+	void pop();
+
+	/// Returns logged move count.
+	size_t size() const { return _records.size(); };
+
+	/// Returns total log size (in bytes), records included.
+	size_t bytes() const;
+
+	/// Returns a move record.
+	///
+	/// @param idx Move index.
+	const Record& at(size_t idx) const { return _records[idx]; };
+
+	/// Decodes a single move.
+	///
+	/// @param idx Move index.
+	///
+	/// @return Move object (`null` if invalid).
+	std::unique_ptr<Move> decode(size_t idx) const;
+
+	/// Decodes all moves.
+	UniqList decode() const;
+
+	/// Applies all moves to a map in log order.
+	///
+	/// @param map Map reference.
+	///
+	/// @return Applied moves, to be reverted in reverse order.
+	UniqList apply(Map* map) const;
+
+	/// Writes the log.
+	///
+	/// Move count followed by encoded moves, each prefixed with its size.
+	///
+	/// @param writer Target writer.
+	void write(Serialize::ByteWriter& writer) const;
+
+	/// Reads a move list and adds it to the log.
+	///
+	/// Moves are not decoded, only their sizes and headers are checked.
+	/// Malformed move fields are reported once the move is decoded.
+	/// If any move is invalid, the log is left as it was.
+	///
+	/// @param reader Source reader.
+	///
+	/// @return Whether all move headers were valid.
+	bool read(Serialize::ByteReader& reader);
+};
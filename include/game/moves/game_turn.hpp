@@ -21,18 +21,22 @@ namespace Moves {
 
 		/// Reverts the move.
 		void onRevert(Map* map) override;
+
+		/// Returns move type.
+		Serialize::MoveType type() const override { return Serialize::M_EntityChange; };
 	};
 
 	/// Region change move.
 	///
 	/// Stores a state change for a single region.
 	struct RegionChange : Move {
+		sf::Vector2i  pos; /// Region access point.
 		RegionData  state; /// New region state (manually set).
 		RegionData a_prev; /// Previous region state.
 
 		/// Constructs a region change move.
 		/// 
-		/// @param pos Region access state.
+		/// @param pos Region access point.
 		/// @param prev Previous region state.
 		RegionChange(sf::Vector2i pos, RegionData prev);
 
@@ -41,5 +45,8 @@ namespace Moves {
 
 		/// Reverts the move.
 		void onRevert(Map* map) override;
+
+		/// Returns move type.
+		Serialize::MoveType type() const override { return Serialize::M_RegionChange; };
 	};
 };
\ No newline at end of file
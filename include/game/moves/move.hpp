@@ -8,6 +8,7 @@
 #include <variant>
 
 #include "game/logic/skill_types.hpp"
+#include "game/serialize/move_type.hpp"
 #include "game/troop.hpp"
 #include "game/build.hpp"
 #include "game/plant.hpp"
@@ -27,6 +28,9 @@ struct Move : dev::Move {
 	Skills::Type skill_type {}; /// Skill type.
 	uint8_t  skill_cooldown {}; /// Skill cooldown.
 
+	/// Destroys the move (moves are owned through base pointers).
+	virtual ~Move() = default;
+
 	/// Applies the move.
 	///
 	/// @param map Game map reference.
@@ -37,6 +41,11 @@ struct Move : dev::Move {
 	/// @param map Game map reference.
 	virtual void onRevert(Map* map) = 0;
 
+	/// Returns move type.
+	///
+	/// Used to pick the move codec when serializing.
+	virtual Serialize::MoveType type() const = 0;
+
 	/// Returns tile to select after applying the move.
 	virtual std::optional<sf::Vector2i> applyCursor();
 
@@ -72,6 +81,15 @@ namespace Moves {
 	/// @return Hex entity state.
 	EntState store_entity(const Hex* hex, sf::Vector2i pos);
 
+	/// Checks if two entity states are the same.
+	///
+	/// Compares the full entity state, including state
+	/// that is not covered by tile hash keys.
+	///
+	/// @param a First entity state.
+	/// @param b Second entity state.
+	bool same_entity(const EntState& a, const EntState& b);
+
 	/// Places an entity on a map.
 	///
 	/// @param entity Entity state.
@@ -29,6 +29,9 @@ namespace Moves {
 		/// Reverts the move.
 		void onRevert(Map* map) override;
 
+		/// Returns move type.
+		Serialize::MoveType type() const override { return Serialize::M_PlantMod; };
+
 		/// Emits move section info.
 		void emitDev(dev::Section* section, ui::Text::List& list) const override;
 	};
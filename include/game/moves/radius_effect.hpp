@@ -11,7 +11,6 @@ namespace Moves {
 		sf::Vector2i  mid; /// AoE middle.
 		size_t     radius; /// AoE radius.
 		Region::Team team; /// Effect origin team.
-		Spread     spread; /// Target list populator.
 
 		/// List of affected targets.
 		std::vector<sf::Vector2i> a_target;
@@ -30,6 +29,9 @@ namespace Moves {
 		/// Reverts the move.
 		void onRevert(Map* map) override;
 
+		/// Returns move type.
+		Serialize::MoveType type() const override { return Serialize::M_RadiusEffect; };
+
 		/// Emits move section info.
 		void emitDev(dev::Section* section, ui::Text::List& list) const override;
 	};
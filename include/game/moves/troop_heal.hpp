@@ -20,7 +20,6 @@ namespace Moves {
 		sf::Vector2i  mid; /// Heal center.
 		int          heal; /// Heal amount.
 		Region::Team team; /// Heal origin team.
-		Spread     spread; /// Heal spreader.
 
 		/// Heal target info.
 		struct Target {
@@ -47,6 +46,9 @@ namespace Moves {
 		/// Reverts the move.
 		void onRevert(Map* map) override;
 
+		/// Returns move type.
+		Serialize::MoveType type() const override { return Serialize::M_TroopHeal; };
+
 		/// Emits move section info.
 		void emitDev(dev::Section* section, ui::Text::List& list) const override;
 	};
@@ -20,6 +20,9 @@ namespace Moves {
 		/// Reverts the move.
 		void onRevert(Map* map) override;
 
+		/// Returns move type.
+		Serialize::MoveType type() const override { return Serialize::M_TroopMerge; };
+
 		/// Returns tile to select after moving.
 		std::optional<sf::Vector2i> applyCursor() override;
 
@@ -0,0 +1,106 @@
+#pragma once
+
+// include dependencies
+#include <span>
+#include "spread.hpp"
+
+/// Precomputed hex neighborhood queries.
+///
+/// Visits every tile within a distance of a tile using offset tables
+/// instead of a spread pass, so no visit marks or tile queue are used.
+/// Offsets depend on row parity, as every other row is shifted.
+///
+/// Tiles are visited ring by ring, in row order within a ring.
+/// Unlike a spread, obstacles are not taken into account.
+namespace Radius {
+	/// Largest radius covered by the offset tables.
+	static constexpr size_t Max = 8;
+
+	/// Tile offset list.
+	using Offsets = std::span<const sf::Vector2i>;
+
+	/// Returns offsets of all tiles at a distance.
+	///
+	/// @param radius Ring radius (at most `Max`).
+	/// @param row Row of the center tile.
+	///
+	/// @return Ring offsets, a single zero offset for radius 0.
+	Offsets ring(size_t radius, int row);
+
+	/// Returns offsets of all tiles within a distance.
+	///
+	/// The center tile is not included.
+	/// Offsets are ordered by distance.
+	///
+	/// @param radius Disk radius (at most `Max`).
+	/// @param row Row of the center tile.
+	Offsets disk(size_t radius, int row);
+
+	/// Visits every tile within a distance of a tile.
+	///
+	/// The center tile is not visited.
+	/// Tiles outside the array are skipped.
+	///
+	/// @param array Tile array.
+	/// @param pos Center tile position.
+	/// @param radius Visit radius.
+	/// @param call Called for each visited tile, `left` is set as it would be by a spread.
+	/// @param alt Spread index used for radii above `Max`.
+	template <typename Call> void each(const HexArray& array, sf::Vector2i pos, size_t radius, Call&& call, bool alt = Spread::Def) {
+		// fall back to a spread for large radii
+		if (radius > Max) [[unlikely]] {
+			BasicSpread spread = {
+				.effect = [&call](const Spread::Tile& tile) { call(tile); },
+				.alt = alt
+			};
+			spread.apply(array, pos, radius);
+			return;
+		};
+
+		for (size_t r = 1; r <= radius; r++) {
+			for (sf::Vector2i off : ring(r, pos.y)) {
+				sf::Vector2i now = pos + off;
+				if (Hex* hex = array.at(now))
+					call(Spread::Tile{ { hex, now }, radius - r });
+			};
+		};
+	};
+
+	/// Visits every tile within a distance of a tile, one ring at a time.
+	///
+	/// The center tile is not visited.
+	/// Tiles outside the array are skipped.
+	///
+	/// @param array Tile array.
+	/// @param pos Center tile position.
+	/// @param radius Visit radius (at most `Max`).
+	/// @param call Called with distance and tiles of each non-empty ring.
+	template <typename Call> void rings(const HexArray& array, sf::Vector2i pos, size_t radius, Call&& call) {
+		Spread::Tile tiles[Max * 6];
+		for (size_t r = 1; r <= radius && r <= Max; r++) {
+			// gather ring tiles within the array
+			size_t count = 0;
+			for (sf::Vector2i off : ring(r, pos.y)) {
+				sf::Vector2i now = pos + off;
+				if (Hex* hex = array.at(now))
+					tiles[count++] = { { hex, now }, radius - r };
+			};
+
+			// pass ring to the callback
+			if (count) call(r, std::span<const Spread::Tile>(tiles, count));
+		};
+	};
+
+	/// Applies a spread to every tile within a distance.
+	///
+	/// Same as `Spread::apply()`, but uses offset tables whenever
+	/// the spread can not be blocked: the blocking check is default,
+	/// or the radius is 1 so the blocking check acts like a non-blocking one.
+	/// Visit marks are not updated.
+	///
+	/// @param spread Applied spread.
+	/// @param array Tile array.
+	/// @param pos Spread origin.
+	/// @param radius Spread radius.
+	void apply(const Spread& spread, const HexArray& array, sf::Vector2i pos, size_t radius);
+};
@@ -83,6 +83,17 @@ struct Region : RegionData {
 	int income = 0; /// Income during next turn.
 	int tiles  = 0; /// Amount of tiles captured.
 
+	/// Membership hash, XOR of member keys of all region tiles.
+	uint64_t members = 0;
+
+	/// Region this region has been merged into.
+	///
+	/// Tiles of a merged region are not relabelled during the merge,
+	/// they follow this link instead when their region is requested.
+	/// Merged regions are dropped from the region index right away
+	/// and get released once no tile refers to them anymore.
+	RefPool<Region>::Share link;
+
 	/// Updates money based on income.
 	void tick();
 };
@@ -108,20 +119,111 @@ public:
 		sf::Vector2i  pos {}; /// Access position.
 	};
 
+	/// Region callback type.
+	using Call = std::function<void(Region& reg, sf::Vector2i pos)>;
+
 private:
+	/// Region index entry.
+	struct Entry {
+		Region::Team team = Region::Unclaimed; /// Region team.
+		sf::Vector2i pos = { -1, -1 };         /// Region access point.
+		size_t slot = ~0ull;                   /// Position in team region list, `~0` if not listed.
+		uint64_t key = 0;                      /// Hash key counted for the slot.
+	};
+
 	RefPool<Region> _pool; /// Region pool.
 
-public:
-	/// Returns a region iterator.
-	RefPool<Region>::It iter();
+	std::vector<Entry> _index;                 /// Index entry of every pool slot.
+	std::vector<size_t> _teams[Region::Count]; /// Pool slots of every team region.
+
+	std::vector<size_t> _dirty; /// Pool slots changed since last hash update.
+	uint64_t        _hash = 0;  /// Zobrist hash of all counted regions.
+
+	/// Returns hash key of a pool slot.
+	///
+	/// @param idx Pool slot index.
+	///
+	/// @return 0 if the slot is not a live region.
+	uint64_t key(size_t idx);
+
+	/// Removes a pool slot from its team region list.
+	///
+	/// @param idx Pool slot index.
+	void unlist(size_t idx);
 
+	/// Visits live regions from a team region list.
+	///
+	/// @param map Map reference.
+	/// @param team Region team.
+	/// @param call Callback function.
+	void visit(const Map* map, Region::Team team, const Call& call) const;
+
+public:
 	/// Creates a new region.
 	///
+	/// The region is added to the region index, but is not
+	/// visited until it has an access point.
+	///
 	/// @param region Initial region state.
 	/// 
 	/// @return Region shared reference.
 	Ref create(const Region& region);
 
+	/// Creates a new empty region.
+	///
+	/// @param team Region team.
+	///
+	/// @return Region shared reference.
+	Ref create(Region::Team team);
+
+	/// Sets region access point.
+	///
+	/// @param ref Region reference.
+	/// @param pos Position of any region tile.
+	void anchor(const Ref& ref, sf::Vector2i pos);
+
+	/// Marks a region as changed.
+	///
+	/// Changed regions are rehashed on the next `hash()` call.
+	/// Region index updates mark their regions automatically,
+	/// code changing region state directly must mark it.
+	///
+	/// @param ref Region reference.
+	void touch(const Ref& ref) {
+		if (ref) _dirty.push_back(ref.index());
+	};
+
+	/// Recomputes hash keys of all regions from scratch.
+	void rehash();
+
+	/// Returns Zobrist hash of all live regions.
+	///
+	/// Only changed regions are rehashed.
+	uint64_t hash();
+
+	/// Returns the region a region has been merged into.
+	///
+	/// Follows merge links and shortens the visited link chain.
+	///
+	/// @param ref Region reference.
+	///
+	/// @return Region, that has not been merged.
+	static Ref root(const Ref& ref) {
+		// find the end of link chain
+		Ref root = ref;
+		while (root->link)
+			root = root->link;
+
+		// link visited regions directly to the root
+		Ref now = ref;
+		while (now->link && now->link != root) {
+			Ref next = now->link;
+			now->link = root;
+			now = next;
+		};
+		return root;
+	};
+
 	/// Enumerates all regions in a map.
 	///
 	/// @param map Map reference.
@@ -129,9 +231,19 @@ public:
 
 	/// Executes the function for each region in a map.
 	///
+	/// Iterates the region index instead of the map.
+	/// Regions are visited in team order.
+	///
+	/// @param map Map reference.
+	/// @param call Callback function.
+	void foreach(const Map* map, const Call& call) const;
+
+	/// Executes the function for each region of a team.
+	///
 	/// @param map Map reference.
+	/// @param team Region team.
 	/// @param call Callback function.
-	static void foreach(const Map* map, std::function<void(Region& reg, sf::Vector2i pos)> call);
+	void foreach(const Map* map, Region::Team team, const Call& call) const;
 
 	/// Merges regions into a singular region.
 	///
@@ -148,12 +260,31 @@ public:
 		int origin
 	);
 
+	/// Finds parts of a region separated by a tile leaving it.
+	///
+	/// Tiles around the left tile that stay connected through its neighbors
+	/// are treated as a single part without searching the region. Otherwise,
+	/// a search is started from each part at the same time and stops as soon
+	/// as all parts but one have been fully explored, or all of them have met.
+	///
+	/// @param map Map reference.
+	/// @param pos Position of the tile that left the region.
+	/// @param prev Region the tile has left.
+	/// @param keep Set to index of the part that has not been fully explored.
+	///
+	/// @return Access points to each separated region part, or an empty list if the region stays whole.
+	std::vector<AccessPoint> separate(Map* map, sf::Vector2i pos, const Ref& prev, size_t& keep);
+
 	/// Splits a separated region into proper regions.
 	///
 	/// Regions not described by `dist` will have the remaining resources split equally. 
 	/// 
+	/// The part at `keep` index stays in the original region,
+	/// every other part is moved into a new region.
+	/// 
 	/// @param map Map reference.
 	/// @param aps Access points to all separated region parts.
 	/// @param dist Previous resource distribution.
-	void split(Map* map, const std::vector<AccessPoint>& aps, const Split& dist);
+	/// @param keep Index of the part that keeps the original region.
+	void split(Map* map, const std::vector<AccessPoint>& aps, const Split& dist, size_t keep = 0);
 };
\ No newline at end of file
@@ -0,0 +1,269 @@
+#pragma once
+
+// include dependencies
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Serialize {
+	/// Byte writer.
+	///
+	/// Multi-byte numbers are big endian and strings are prefixed
+	/// with a 32-bit length, same as in `sf::Packet`, so encoded data
+	/// stays compatible with packets and map files written before.
+	///
+	/// Writes into one of:
+	/// - nothing, only counting bytes (to find the exact encoded size first);
+	/// - caller-provided memory of a fixed size;
+	/// - a caller-owned byte vector, appended to and grown as needed,
+	///   which can be kept and reused between writes.
+	///
+	/// Writing past fixed memory sets the error state,
+	/// every later write is then ignored.
+	class ByteWriter {
+	private:
+		uint8_t* _data = nullptr;              /// Fixed target memory.
+		size_t _cap = 0;                       /// Fixed target memory size.
+		std::vector<uint8_t>* _pool = nullptr; /// Growable target storage.
+		size_t _base = 0;                      /// Write start in the storage.
+		size_t _size = 0;                      /// Written byte count.
+		bool _fail = false;                    /// Error state.
+
+		/// Reserves space for written bytes.
+		///
+		/// @param size Byte count.
+		///
+		/// @return Write address (`nullptr` when only counting or failed).
+		uint8_t* _reserve(size_t size) {
+			if (_fail) return nullptr;
+			size_t at = _size;
+
+			// grow storage
+			if (_pool) {
+				_pool->resize(_base + at + size);
+				_size += size;
+				return _pool->data() + _base + at;
+			};
+
+			// only count bytes
+			if (!_data) {
+				_size += size;
+				return nullptr;
+			};
+
+			// write into fixed memory
+			if (size > _cap - at) {
+				_fail = true;
+				return nullptr;
+			};
+			_size += size;
+			return _data + at;
+		};
+
+	public:
+		/// Constructs a writer that only counts bytes.
+		ByteWriter() = default;
+
+		/// Constructs a writer over fixed memory.
+		///
+		/// @param memory Target memory.
+		explicit ByteWriter(std::span<uint8_t> memory) : _data(memory.data()), _cap(memory.size()) {};
+
+		/// Constructs a writer appending to a byte vector.
+		///
+		/// @param pool Target storage.
+		explicit ByteWriter(std::vector<uint8_t>& pool) : _pool(&pool), _base(pool.size()) {};
+
+		/// Checks whether all writes succeeded.
+		explicit operator bool() const { return !_fail; };
+
+		/// Returns written byte count.
+		size_t size() const { return _size; };
+
+		/// Returns written bytes (`nullptr` when only counting).
+		///
+		/// Bytes written into a vector move when it grows.
+		const uint8_t* data() const {
+			if (_pool) return _pool->data() + _base;
+			return _data;
+		};
+
+		/// Returns a view of written bytes.
+		std::span<const uint8_t> bytes() const { return { data(), data() ? _size : 0 }; };
+
+		/// Reserves vector storage for upcoming writes.
+		///
+		/// @param size Expected byte count.
+		void reserve(size_t size) {
+			if (_pool) _pool->reserve(_base + _size + size);
+		};
+
+		/// Writes raw bytes.
+		///
+		/// @param data Source bytes.
+		/// @param size Byte count.
+		void write(const void* data, size_t size) {
+			uint8_t* out = _reserve(size);
+			if (out && size) std::memcpy(out, data, size);
+		};
+
+		/// Writes an integer (or a boolean as a single byte).
+		///
+		/// @tparam T Integer type.
+		///
+		/// @param value Written value.
+		template <typename T> requires std::is_integral_v<T> ByteWriter& operator<<(T value) {
+			if constexpr (std::is_same_v<T, bool>) {
+				return *this << static_cast<uint8_t>(value);
+			}
+			else {
+				if (uint8_t* out = _reserve(sizeof(T))) {
+					auto bits = static_cast<std::make_unsigned_t<T>>(value);
+					for (size_t i = sizeof(T); i-- > 0; ) {
+						out[i] = static_cast<uint8_t>(bits);
+						bits = static_cast<decltype(bits)>(bits >> 8);
+					};
+				};
+				return *this;
+			};
+		};
+
+		/// Writes a length-prefixed string.
+		///
+		/// @param text Written string.
+		ByteWriter& operator<<(std::string_view text) {
+			*this << static_cast<uint32_t>(text.size());
+			write(text.data(), text.size());
+			return *this;
+		};
+	};
+
+	/// Byte reader.
+	///
+	/// Reads data written by `ByteWriter` in place, without copying it.
+	/// The viewed memory must outlive the reader.
+	///
+	/// Reading past the end sets the error state and leaves
+	/// the target value unchanged, every later read then fails.
+	class ByteReader {
+	private:
+		const uint8_t* _data = nullptr; /// Viewed memory.
+		size_t _size = 0;               /// Viewed memory size.
+		size_t _pos = 0;                /// Read position.
+		bool _fail = false;             /// Error state.
+
+	public:
+		/// Constructs an empty reader.
+		ByteReader() = default;
+
+		/// Constructs a reader over memory.
+		///
+		/// @param data Viewed bytes.
+		explicit ByteReader(std::span<const uint8_t> data) : _data(data.data()), _size(data.size()) {};
+
+		/// Constructs a reader over memory.
+		///
+		/// @param data Viewed bytes.
+		/// @param size Byte count.
+		ByteReader(const void* data, size_t size) : _data(static_cast<const uint8_t*>(data)), _size(size) {};
+
+		/// Checks whether all reads succeeded.
+		explicit operator bool() const { return !_fail; };
+
+		/// Marks read data as malformed.
+		void fail() { _fail = true; };
+
+		/// Returns read position.
+		size_t position() const { return _pos; };
+		/// Returns viewed byte count.
+		size_t size() const { return _size; };
+		/// Returns unread byte count.
+		size_t remaining() const { return _size - _pos; };
+		/// Checks whether all bytes were read.
+		bool end() const { return _pos >= _size; };
+
+		/// Returns viewed memory.
+		const uint8_t* data() const { return _data; };
+
+		/// Skips over bytes and returns them in place.
+		///
+		/// @param size Byte count.
+		///
+		/// @return Skipped bytes (`nullptr` if there are not enough).
+		const uint8_t* take(size_t size) {
+			if (_fail || size > _size - _pos) {
+				_fail = true;
+				return nullptr;
+			};
+			const uint8_t* at = _data + _pos;
+			_pos += size;
+			return at;
+		};
+
+		/// Reads raw bytes.
+		///
+		/// @param data Target memory.
+		/// @param size Byte count.
+		///
+		/// @return Whether the bytes were read.
+		bool read(void* data, size_t size) {
+			const uint8_t* in = take(size);
+			if (!_fail && size) std::memcpy(data, in, size);
+			return !_fail;
+		};
+
+		/// Reads an integer (or a boolean from a single byte).
+		///
+		/// @tparam T Integer type.
+		///
+		/// @param value Target value.
+		template <typename T> requires std::is_integral_v<T> ByteReader& operator>>(T& value) {
+			if constexpr (std::is_same_v<T, bool>) {
+				if (const uint8_t* in = take(1))
+					value = *in != 0;
+			}
+			else if (const uint8_t* in = take(sizeof(T))) {
+				std::make_unsigned_t<T> bits = 0;
+				for (size_t i = 0; i < sizeof(T); i++)
+					bits = static_cast<decltype(bits)>(bits << 8 | in[i]);
+				value = static_cast<T>(bits);
+			};
+			return *this;
+		};
+
+		/// Reads a length-prefixed string.
+		///
+		/// @param text Target string.
+		ByteReader& operator>>(std::string& text) {
+			uint32_t size = 0;
+			*this >> size;
+			const uint8_t* in = take(size);
+			if (_fail) return *this;
+
+			if (size) text.assign(reinterpret_cast<const char*>(in), size);
+			else text.clear();
+			return *this;
+		};
+	};
+
+	/// Returns exact encoded size of data.
+	///
+	/// Runs an encoder over a counting writer, so memory
+	/// can be allocated once before encoding for real.
+	///
+	/// @tparam F Encoder type.
+	///
+	/// @param encode Encoder, called with a writer.
+	///
+	/// @return Encoded byte count.
+	template <typename F> size_t encodedSize(F&& encode) {
+		ByteWriter counter;
+		encode(counter);
+		return counter.size();
+	};
+};
@@ -11,29 +11,29 @@ namespace Serialize {
 	};
 
 	/// Serializes an entity object.
-	sf::Packet& operator<<(sf::Packet& packet, const Entity& entity);
+	ByteWriter& operator<<(ByteWriter& writer, const Entity& entity);
 	/// Deserializes an entity object.
-	sf::Packet& operator>>(sf::Packet& packet, Entity& entity);
+	ByteReader& operator>>(ByteReader& reader, Entity& entity);
 
 	/// Serializes a troop object.
-	sf::Packet& operator<<(sf::Packet& packet, const Troop& troop);
+	ByteWriter& operator<<(ByteWriter& writer, const Troop& troop);
 	/// Deserializes a troop object.
-	sf::Packet& operator>>(sf::Packet& packet, Troop& troop);
+	ByteReader& operator>>(ByteReader& reader, Troop& troop);
 
 	/// Serializes a building object.
-	sf::Packet& operator<<(sf::Packet& packet, const Build& build);
+	ByteWriter& operator<<(ByteWriter& writer, const Build& build);
 	/// Deserializes a building object.
-	sf::Packet& operator>>(sf::Packet& packet, Build& build);
+	ByteReader& operator>>(ByteReader& reader, Build& build);
 
 	/// Serializes a plant object.
-	sf::Packet& operator<<(sf::Packet& packet, const Plant& plant);
+	ByteWriter& operator<<(ByteWriter& writer, const Plant& plant);
 	/// Deserializes a plant object.
-	sf::Packet& operator>>(sf::Packet& packet, Plant& plant);
+	ByteReader& operator>>(ByteReader& reader, Plant& plant);
 
 	/// Serializes an entity state.
-	sf::Packet& operator<<(sf::Packet& packet, const Moves::EntState& entity);
+	ByteWriter& operator<<(ByteWriter& writer, const Moves::EntState& entity);
 	/// Deserializes an entity state.
-	sf::Packet& operator>>(sf::Packet& packet, Moves::EntState& entity);
+	ByteReader& operator>>(ByteReader& reader, Moves::EntState& entity);
 
 
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <SFML/Network/Packet.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <vector>
+#include "buffer.hpp"
 #include "game/moves/move.hpp" // zapewnia Moves::EntState (alias na std::variant)
 
 // forward declarations typw uywanych w przecieniach
@@ -19,93 +20,163 @@ namespace Messages { struct Player; }
 /// Serialization helper functions.
 namespace Serialize {
 	// forward declarations operatorw  musz by widoczne przed szablonem from<T>
-	sf::Packet& operator<<(sf::Packet& packet, sf::Vector2i vec);
-	sf::Packet& operator>>(sf::Packet& packet, sf::Vector2i& vec);
+	ByteWriter& operator<<(ByteWriter& writer, sf::Vector2i vec);
+	ByteReader& operator>>(ByteReader& reader, sf::Vector2i& vec);
 
-	sf::Packet& operator<<(sf::Packet& packet, const Entity& entity);
-	sf::Packet& operator>>(sf::Packet& packet, Entity& entity);
+	ByteWriter& operator<<(ByteWriter& writer, const Entity& entity);
+	ByteReader& operator>>(ByteReader& reader, Entity& entity);
 
-	sf::Packet& operator<<(sf::Packet& packet, const Troop& troop);
-	sf::Packet& operator>>(sf::Packet& packet, Troop& troop);
+	ByteWriter& operator<<(ByteWriter& writer, const Troop& troop);
+	ByteReader& operator>>(ByteReader& reader, Troop& troop);
 
-	sf::Packet& operator<<(sf::Packet& packet, const Build& build);
-	sf::Packet& operator>>(sf::Packet& packet, Build& build);
+	ByteWriter& operator<<(ByteWriter& writer, const Build& build);
+	ByteReader& operator>>(ByteReader& reader, Build& build);
 
-	sf::Packet& operator<<(sf::Packet& packet, const Plant& plant);
-	sf::Packet& operator>>(sf::Packet& packet, Plant& plant);
+	ByteWriter& operator<<(ByteWriter& writer, const Plant& plant);
+	ByteReader& operator>>(ByteReader& reader, Plant& plant);
 
-	sf::Packet& operator<<(sf::Packet& packet, const RegionRes& res);
-	sf::Packet& operator>>(sf::Packet& packet, RegionRes& res);
+	ByteWriter& operator<<(ByteWriter& writer, const RegionRes& res);
+	ByteReader& operator>>(ByteReader& reader, RegionRes& res);
 
-	sf::Packet& operator<<(sf::Packet& packet, const RegionVar& var);
-	sf::Packet& operator>>(sf::Packet& packet, RegionVar& var);
+	ByteWriter& operator<<(ByteWriter& writer, const RegionVar& var);
+	ByteReader& operator>>(ByteReader& reader, RegionVar& var);
 
-	sf::Packet& operator<<(sf::Packet& packet, const Template& temp);
-	sf::Packet& operator>>(sf::Packet& packet, Template& temp);
+	ByteWriter& operator<<(ByteWriter& writer, const Template& temp);
+	ByteReader& operator>>(ByteReader& reader, Template& temp);
 
-	sf::Packet& operator<<(sf::Packet& packet, const Messages::Player& plr);
-	sf::Packet& operator>>(sf::Packet& packet, Messages::Player& plr);
+	ByteWriter& operator<<(ByteWriter& writer, const Messages::Player& plr);
+	ByteReader& operator>>(ByteReader& reader, Messages::Player& plr);
 
-	sf::Packet& operator<<(sf::Packet& packet, const Moves::EntState& entity);
-	sf::Packet& operator>>(sf::Packet& packet, Moves::EntState& entity);
+	ByteWriter& operator<<(ByteWriter& writer, const Moves::EntState& entity);
+	ByteReader& operator>>(ByteReader& reader, Moves::EntState& entity);
 
-	/// Reads a type from the packet.
+	/// Reads a type from the reader.
 	///
 	/// @tparam T Read type.
 	///
-	/// @param packet Target packet.
+	/// @param reader Source reader.
 	///
 	/// @return Type value.
-	template <typename T> T from(sf::Packet& packet) {
+	template <typename T> T from(ByteReader& reader) {
 		T var {};
 		using Serialize::operator>>; // widoczne przecienia w Serialize
-		packet >> var;
+		reader >> var;
 		return var;
 	};
 
-	/// Writes a vector list to the packet.
+	/// Writes a vector list to the writer.
 	/// 
 	/// @tparam T Vector item type.
 	/// 
-	/// @param packet Target packet.
+	/// @param writer Target writer.
 	/// @param vec Target vector.
-	template <typename T> void encodeVec(sf::Packet& packet, const std::vector<T>& vec) {
-		packet << static_cast<int>(vec.size());
+	template <typename T> void encodeVec(ByteWriter& writer, const std::vector<T>& vec) {
+		writer << static_cast<int>(vec.size());
 		for (const T& item : vec)
-			packet << item;
+			writer << item;
 	};
 
-	/// Reads a vector list from the packet.
+	/// Reads a vector list from the reader.
+	///
+	/// Every item takes at least a byte, so longer counts
+	/// than the remaining data are rejected before allocating.
 	/// 
 	/// @tparam T Vector item type.
 	/// 
-	/// @param packet Target packet.
+	/// @param reader Source reader.
 	/// 
 	/// @return Read vector.
-	template <typename T> std::vector<T> decodeVec(sf::Packet& packet) {
-		int count = from<int>(packet);
+	template <typename T> std::vector<T> decodeVec(ByteReader& reader) {
+		int count = from<int>(reader);
+		if (count < 0 || (size_t)count > reader.remaining()) {
+			reader.fail();
+			return {};
+		};
+
 		std::vector<T> vec;
 		{
 			vec.reserve(count);
 			for (int i = 0; i < count; i++)
-				vec.push_back(from<T>(packet));
+				vec.push_back(from<T>(reader));
 		};
 		return vec;
 	};
 
-	/// Writes a 2d vector to the packet.
+	/// Writes a 2d vector to the writer.
 	/// 
-	/// @param packet Target packet.
+	/// @param writer Target writer.
 	/// @param vec Target vector.
 	/// 
-	/// @return Packet reference.
-	sf::Packet& operator<<(sf::Packet& packet, sf::Vector2i vec);
+	/// @return Writer reference.
+	ByteWriter& operator<<(ByteWriter& writer, sf::Vector2i vec);
 
-	/// Reads a 2d vector from the packet.
+	/// Reads a 2d vector from the reader.
 	/// 
-	/// @param packet Target packet.
+	/// @param reader Source reader.
 	/// @param vec Target vector.
 	/// 
-	/// @return Packet reference.
-	sf::Packet& operator>>(sf::Packet& packet, sf::Vector2i& vec);
-};
+	/// @return Reader reference.
+	ByteReader& operator>>(ByteReader& reader, sf::Vector2i& vec);
+
+	/// Writes an unsigned number as a variable-length integer.
+	///
+	/// Uses 7 bits per byte, lowest bits first,
+	/// the top bit marks that more bytes follow.
+	///
+	/// @param writer Target writer.
+	/// @param value Written number.
+	void encodeVar(ByteWriter& writer, uint64_t value);
+
+	/// Reads a variable-length unsigned integer from the reader.
+	///
+	/// @param reader Source reader.
+	///
+	/// @return Read number (0 if malformed).
+	uint64_t decodeVar(ByteReader& reader);
+
+	/// Writes a signed number as a variable-length integer.
+	///
+	/// Zigzag encoded, so small negative numbers stay short.
+	///
+	/// @param writer Target writer.
+	/// @param value Written number.
+	void encodeVarInt(ByteWriter& writer, int64_t value);
+
+	/// Reads a variable-length signed integer from the reader.
+	///
+	/// @param reader Source reader.
+	///
+	/// @return Read number.
+	int64_t decodeVarInt(ByteReader& reader);
+
+	/// Writes a map position with variable-length coordinates.
+	///
+	/// @param writer Target writer.
+	/// @param pos Written position.
+	void encodePos(ByteWriter& writer, sf::Vector2i pos);
+
+	/// Reads a map position with variable-length coordinates.
+	///
+	/// @param reader Source reader.
+	///
+	/// @return Read position.
+	sf::Vector2i decodePos(ByteReader& reader);
+
+	/// Returns a reader over unread packet contents.
+	///
+	/// Bridge for data received through SFML, the packet is not copied
+	/// and must outlive the reader. Packet read position does not move.
+	///
+	/// @param packet Source packet.
+	///
+	/// @return Packet reader.
+	ByteReader readPacket(const sf::Packet& packet);
+
+	/// Appends written bytes to a packet.
+	///
+	/// Bridge for data sent through SFML.
+	///
+	/// @param packet Target packet.
+	/// @param bytes Written bytes.
+	void writePacket(sf::Packet& packet, std::span<const uint8_t> bytes);
+};
\ No newline at end of file
@@ -2,33 +2,65 @@
 
 // include dependencies
 #include "general.hpp"
+#include "mapfile.hpp"
+#include "tileplane.hpp"
 #include "game/hex.hpp"
 #include "game/template.hpp"
 
 namespace Serialize {
 	/// Serializes a template signature.
-	void encodeSignature(sf::Packet& packet);
+	void encodeSignature(ByteWriter& writer);
 	/// Deserializes a template signature.
 	/// @return Whether a signature was recognized.
-	bool decodeSignature(sf::Packet& packet);
+	bool decodeSignature(ByteReader& reader);
 
 	/// Serializes a hex base object.
-	sf::Packet& operator<<(sf::Packet& packet, const HexBase& hex);
+	ByteWriter& operator<<(ByteWriter& writer, const HexBase& hex);
 	/// Deserializes a hex base object.
-	sf::Packet& operator>>(sf::Packet& packet, HexBase& hex);
+	ByteReader& operator>>(ByteReader& reader, HexBase& hex);
 
 	/// Serializes region resources object.
-	sf::Packet& operator<<(sf::Packet& packet, const RegionRes& res);
+	ByteWriter& operator<<(ByteWriter& writer, const RegionRes& res);
 	/// Deserializes region resources object.
-	sf::Packet& operator>>(sf::Packet& packet, RegionRes& res);
+	ByteReader& operator>>(ByteReader& reader, RegionRes& res);
 
 	/// Serializes region variable counters object.
-	sf::Packet& operator<<(sf::Packet& packet, const RegionVar& var);
+	ByteWriter& operator<<(ByteWriter& writer, const RegionVar& var);
 	/// Deserializes region variable counters object.
-	sf::Packet& operator>>(sf::Packet& packet, RegionVar& var);
+	ByteReader& operator>>(ByteReader& reader, RegionVar& var);
 
 	/// Serializes a map template object.
-	sf::Packet& operator<<(sf::Packet& packet, const Template& temp);
+	ByteWriter& operator<<(ByteWriter& writer, const Template& temp);
 	/// Deserializes a map template object.
-	sf::Packet& operator>>(sf::Packet& packet, Template& temp);
+	ByteReader& operator>>(ByteReader& reader, Template& temp);
+
+	/// Serializes a map template with a compressed tile plane.
+	///
+	/// Same as the template operator, but tiles are stored with `TilePlane`.
+	/// Used for templates sent over the network.
+	///
+	/// @param writer Target writer.
+	/// @param temp Map template.
+	void encodeTemplate(ByteWriter& writer, const Template& temp);
+	/// Deserializes a map template with a compressed tile plane.
+	///
+	/// @param reader Source reader, fails if the template is malformed.
+	///
+	/// @return Map template.
+	Template decodeTemplate(ByteReader& reader);
+
+	/// Encodes a map template into a chunked map file.
+	///
+	/// The tile plane is stored raw, so it can be read from a mapped file in place.
+	///
+	/// @param temp Map template.
+	///
+	/// @return File contents.
+	std::vector<uint8_t> encodeMapFile(const Template& temp);
+	/// Decodes a map template from a chunked map file.
+	///
+	/// @param view Map file view.
+	///
+	/// @return Map template or nothing if required chunks are missing or malformed.
+	std::optional<Template> decodeMapFile(const MapFormat::View& view);
 };
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+// include dependencies
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Chunked map file format.
+///
+/// All values are little endian.
+///
+/// Layout:
+/// - header: signature `hex!`, format version (u32), chunk count (u32);
+/// - chunks: tag (u32), payload size (u32), payload padded to 4 bytes;
+/// - footer: CRC-32 of everything before it (u32).
+///
+/// Chunk payloads are 4-byte aligned, so a mapped file can be viewed in place.
+/// Unknown chunks are skipped by readers.
+namespace MapFormat {
+	/// Current format version.
+	static constexpr uint32_t version = 2;
+
+	/// Returns a chunk tag from its 4-letter name.
+	///
+	/// @param name Chunk name.
+	constexpr uint32_t tag(const char (&name)[5]) {
+		return (uint32_t)(uint8_t)name[0]
+			| (uint32_t)(uint8_t)name[1] << 8
+			| (uint32_t)(uint8_t)name[2] << 16
+			| (uint32_t)(uint8_t)name[3] << 24;
+	};
+
+	/// Map info chunk (name & author).
+	static constexpr uint32_t Info = tag("INFO");
+	/// Tile plane chunk.
+	///
+	/// Map width and height (u32 each) followed by the tile plane
+	/// (`team << 4 | type` per tile, in `HexArray` index order):
+	/// one byte per tile in version 1, `TilePlane` encoded since version 2.
+	///
+	/// Map files are written with `TilePlane::Raw` planes, so a mapped file
+	/// is unpacked straight from the chunk. Compressed planes are accepted
+	/// too, but are decoded into a temporary plane first. Compression pays
+	/// off for templates sent over the network, not for local files.
+	static constexpr uint32_t Tiles = tag("TILE");
+	/// Entity table chunk (troops, buildings, plants).
+	static constexpr uint32_t Entities = tag("ENTS");
+	/// Region construction data chunk.
+	static constexpr uint32_t Regions = tag("REGN");
+
+	/// Reads a little endian 32-bit value.
+	///
+	/// @param data Value address.
+	inline uint32_t read32(const uint8_t* data) {
+		return (uint32_t)data[0] | (uint32_t)data[1] << 8
+			| (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24;
+	};
+
+	/// Writes a little endian 32-bit value.
+	///
+	/// @param data Value address.
+	/// @param value Written value.
+	inline void write32(uint8_t* data, uint32_t value) {
+		data[0] = (uint8_t)value;
+		data[1] = (uint8_t)(value >> 8);
+		data[2] = (uint8_t)(value >> 16);
+		data[3] = (uint8_t)(value >> 24);
+	};
+
+	/// Computes CRC-32 of a byte range.
+	///
+	/// @param data Byte range start.
+	/// @param size Byte range size.
+	/// @param crc Previous CRC value.
+	uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+
+	/// Read-only view of a map file.
+	///
+	/// Does not copy or own the viewed data.
+	class View {
+	public:
+		/// Chunk view.
+		struct Chunk {
+			uint32_t tag = 0;             /// Chunk tag.
+			const uint8_t* data = nullptr; /// Chunk payload.
+			uint32_t size = 0;            /// Payload size.
+		};
+
+	private:
+		std::vector<Chunk> _chunks; /// Chunk list.
+		uint32_t _version = 0;      /// File format version.
+
+	public:
+		/// Checks whether data starts with a chunked map file signature.
+		///
+		/// @param data File contents.
+		/// @param size File size.
+		static bool recognize(const uint8_t* data, size_t size);
+
+		/// Opens a view of map file contents.
+		///
+		/// Validates the signature, version, chunk bounds and checksum.
+		///
+		/// @param data File contents.
+		/// @param size File size.
+		///
+		/// @return Whether the file is valid.
+		bool open(const uint8_t* data, size_t size);
+
+		/// Returns file format version.
+		uint32_t version() const { return _version; };
+
+		/// Returns the first chunk with a tag.
+		///
+		/// @param tag Chunk tag.
+		///
+		/// @return Chunk view or `nullptr` if there is no such chunk.
+		const Chunk* chunk(uint32_t tag) const;
+	};
+
+	/// Map file writer.
+	class Writer {
+	private:
+		std::vector<uint8_t> _data; /// File contents.
+		uint32_t _count = 0;        /// Chunk count.
+
+	public:
+		/// Starts a new file.
+		Writer();
+
+		/// Adds a chunk.
+		///
+		/// @param tag Chunk tag.
+		/// @param data Chunk payload.
+		/// @param size Payload size.
+		void chunk(uint32_t tag, const void* data, size_t size);
+
+		/// Adds a chunk and returns its payload for writing.
+		///
+		/// @param tag Chunk tag.
+		/// @param size Payload size.
+		///
+		/// @return Payload pointer, valid until the next chunk is added.
+		uint8_t* chunk(uint32_t tag, size_t size);
+
+		/// Finishes the file.
+		///
+		/// @return File contents.
+		std::vector<uint8_t> finish();
+	};
+};
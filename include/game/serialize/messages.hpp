@@ -15,34 +15,34 @@ namespace Serialize {
 		E_Count
 	};
 
-	/// Writes player description to the packet.
+	/// Writes player description to the writer.
 	/// 
-	/// @param packet Target packet.
+	/// @param writer Target writer.
 	/// @param plr Target player description.
 	/// 
-	/// @return Packet reference.
-	sf::Packet& operator<<(sf::Packet& packet, const Messages::Player& plr);
+	/// @return Writer reference.
+	ByteWriter& operator<<(ByteWriter& writer, const Messages::Player& plr);
 
-	/// Reads player description from the packet.
+	/// Reads player description from the reader.
 	/// 
-	/// @param packet Target packet.
+	/// @param reader Source reader.
 	/// @param plr Target player description.
 	/// 
-	/// @return Packet reference.
-	sf::Packet& operator>>(sf::Packet& packet, Messages::Player& plr);
+	/// @return Reader reference.
+	ByteReader& operator>>(ByteReader& reader, Messages::Player& plr);
 
-	/// Writes an event message to the packet.
+	/// Writes an event message to the writer.
 	/// 
-	/// @param packet Target packet.
+	/// @param writer Target writer.
 	/// @param vec Target event message.
-	void encodeMessage(sf::Packet& packet, const Messages::Event& evt);
+	void encodeMessage(ByteWriter& writer, const Messages::Event& evt);
 
-	/// Reads an event message from the packet.
+	/// Reads an event message from the reader.
 	/// 
-	/// @param packet Target packet.
+	/// @param reader Source reader.
 	/// 
 	/// @return Read event message.
-	std::optional<Messages::Event> decodeMessage(sf::Packet& packet);
+	std::optional<Messages::Event> decodeMessage(ByteReader& reader);
 };
 
 namespace NetworkProtocol {
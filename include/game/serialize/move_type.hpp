@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Serialize {
+	/// Move enumeration.
+	enum MoveType {
+		// entity moves
+		M_EntityPlace,
+		M_EntityWithdraw,
+		M_EntityEffect,
+
+		// troop moves
+		M_TroopMove,
+		M_TroopMerge,
+		M_TroopAttack,
+		M_TroopHeal,
+
+		// building moves
+		M_RadiusEffect,
+
+		// plant moves
+		M_PlantCut,
+		M_PlantMod,
+
+		// state change moves
+		M_EntityChange,
+		M_RegionChange,
+		M_Count
+	};
+};
\ No newline at end of file
@@ -4,44 +4,47 @@
 #include "general.hpp"
 #include "entities.hpp"
 #include "game/moves.hpp"
+#include "move_type.hpp"
 
 namespace Serialize {
-	/// Move enumeration.
-	enum MoveType {
-		// entity moves
-		M_EntityPlace,
-		M_EntityWithdraw,
-		M_EntityEffect,
-
-		// troop moves
-		M_TroopMove,
-		M_TroopMerge,
-		M_TroopAttack,
-		M_TroopHeal,
-
-		// building moves
-		M_RadiusEffect,
-
-		// plant moves
-		M_PlantCut,
-		M_PlantMod,
-
-		// state change moves
-		M_EntityChange,
-		M_RegionChange,
-		M_Count
-	};
-
-	/// Encodes a move into a packet.
+	/// Encodes a move.
 	/// 
-	/// @param packet Target packet.
+	/// @param writer Target writer.
 	/// @param move Serialized move.
-	void encodeMove(sf::Packet& packet, const Move* move);
+	void encodeMove(ByteWriter& writer, const Move* move);
+
+	/// Decodes a move.
+	/// 
+	/// @param reader Source reader.
+	/// 
+	/// @return Deserialized move (`null` if malformed).
+	std::unique_ptr<Move> decodeMove(ByteReader& reader);
+
+	/// Reads a move header without decoding move fields.
+	///
+	/// @param reader Source reader.
+	/// @param cooldown Set to move skill cooldown.
+	///
+	/// @return Move type (`M_Count` if malformed).
+	MoveType peekMove(ByteReader& reader, uint8_t& cooldown);
+
+	/// Encodes applied state of a move.
+	///
+	/// Applied state (fields prefixed with `a_`) holds the map state
+	/// the move has replaced, so it is only valid after `apply()`.
+	/// Skill origin is included for moves without a cooldown.
+	/// 
+	/// @param writer Target writer.
+	/// @param move Applied move.
+	void encodeApplied(ByteWriter& writer, const Move* move);
 
-	/// Decodes a move from a packet.
+	/// Decodes applied state into a move.
+	///
+	/// Lets a move decoded with `decodeMove()` be reverted.
 	/// 
-	/// @param packet Target packet.
+	/// @param reader Source reader.
+	/// @param move Move of the same type as the encoded one.
 	/// 
-	/// @return Deserialized move.
-	std::unique_ptr<Move> decodeMove(sf::Packet& packet);
+	/// @return Whether the state was read successfully.
+	bool decodeApplied(ByteReader& reader, Move* move);
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+// include dependencies
+#include "buffer.hpp"
+
+/// Tile plane compression.
+///
+/// A tile plane stores one byte per tile (`team << 4 | type`) in row order.
+/// Maps are mostly long runs of the same byte (void margins, water borders,
+/// owned land), so planes are stored with whichever method is smallest:
+/// - `Raw`: plane bytes as they are;
+/// - `Runs`: run-length tokens in row order, 2 bytes each:
+///   tile byte and run length minus one (longer runs are split);
+/// - `Huffman`: run tokens compressed with a canonical Huffman code.
+///
+/// Encoded layout: method (u8), then
+/// - `Raw`: plane bytes;
+/// - `Runs`: token byte count (u32) and tokens;
+/// - `Huffman`: token byte count (u32), code lengths of all 256 symbols
+///   (4 bits each), bit stream byte count (u32) and the bit stream
+///   (most significant bit first).
+namespace TilePlane {
+	/// Plane encoding method.
+	enum Method : uint8_t {
+		Raw,     /// Plain bytes.
+		Runs,    /// Run-length tokens.
+		Huffman, /// Entropy coded run-length tokens.
+		Count,   /// Method count.
+	};
+
+	/// Longest Huffman code length.
+	///
+	/// Keeps the decoding lookup table small (`1 << MaxBits` entries).
+	static constexpr int MaxBits = 12;
+
+	/// Largest tile count a single encoded byte can expand to.
+	///
+	/// Lets readers reject plane sizes before allocating them.
+	static constexpr size_t MaxRatio = 8 * 256 / 2;
+
+	/// Encodes a tile plane with the smallest method.
+	///
+	/// @param writer Target writer.
+	/// @param plane Plane bytes.
+	///
+	/// @return Picked method.
+	Method encode(Serialize::ByteWriter& writer, std::span<const uint8_t> plane);
+
+	/// Decodes a tile plane.
+	///
+	/// @param reader Source reader.
+	/// @param plane Target plane, its size is the expected tile count.
+	///
+	/// @return Whether the plane was valid (the reader fails otherwise).
+	bool decode(Serialize::ByteReader& reader, std::span<uint8_t> plane);
+};
@@ -1,9 +1,10 @@
 #pragma once
 
 // include dependencies
+#include <atomic>
 #include <functional>
 #include <optional>
-#include <deque>
+#include <vector>
 #include "array.hpp"
 
 /// Effect spread description.
@@ -19,23 +20,26 @@ public:
 
 private:
 	/// Last spread index.
-	static size_t _last_idx[2];
-
-public:
-	/// Resets spread indices.
 	///
-	/// This should be invoked whenever the whole map is reset.
-	static void reset();
+	/// Shared by all threads and never reset, as arrays keep marks of
+	/// earlier indices and may be used from several threads in turn.
+	/// New arrays start with all tiles unmarked.
+	static std::atomic<size_t> _last_idx[2];
 
+public:
 	/// Generates a unique spread pass index.
 	/// 
 	/// Spread index is used to mark tiles as "visited".
 	/// Any tile whose spread index does not match is treated as "not visited".
 	/// 
+	/// Spreads running at the same time on other threads
+	/// must use their own array view (see `HexArray::view()`).
+	/// 
 	/// @param alt Whether to use alternative index.
+	/// @param count Amount of consecutive indices to reserve.
 	/// 
-	/// @return New unique non-zero integer.
-	static size_t index(bool alt);
+	/// @return First of the new unique non-zero integers.
+	static size_t index(bool alt, size_t count = 1);
 
 	/// Spread target information.
 	struct Tile : HexRef {
@@ -68,6 +72,19 @@ public:
 	/// Does not override the radius value.
 	static std::optional<size_t> default_radius(const Tile&);
 
+	/// Statically typed default spread check.
+	///
+	/// Passes any hex.
+	struct Any {
+		bool operator()(const Tile&) const { return true; };
+	};
+	/// Statically typed default spread effect.
+	///
+	/// Performs no action.
+	struct None {
+		void operator()(const Tile&) const {};
+	};
+
 	/// Blocking check.
 	///
 	/// If this check fails, the spread will not propagate to neighboring tiles.
@@ -110,8 +127,8 @@ public:
 
 	/// Visited tile coordinate list.
 	///
-	/// Returned by `spreadlist()`.
-	using List = std::deque<sf::Vector2i>;
+	/// Returned by `applylist()`.
+	using List = std::vector<sf::Vector2i>;
 
 	/// Applies the spread.
 	/// 
@@ -123,4 +140,285 @@ public:
 	/// 
 	/// @return List of coordinates of all visited tiles.
 	List applylist(const HexArray& array, sf::Vector2i pos, size_t radius = ~0ull) const;
-};
\ No newline at end of file
+
+	/// Applies the spread.
+	/// 
+	/// The tile located at origin does *not* get affected, but is marked as "visited".
+	/// 
+	/// Visited tiles are written into a caller-owned list.
+	/// The list is cleared first, but its capacity is kept.
+	/// 
+	/// @param array Target tile array.
+	/// @param pos Spread origin.
+	/// @param list Output coordinate list.
+	/// @param radius Maximum spread radius (infinite by default).
+	/// 
+	/// @return Spread index.
+	size_t applylist(const HexArray& array, sf::Vector2i pos, List& list, size_t radius = ~0ull) const;
+
+	/// Spread tile queue.
+	///
+	/// Ring buffer of tiles waiting to be processed.
+	/// Storage is kept between spread passes, so a spread
+	/// does not allocate once the buffer is large enough for the map.
+	class Frontier {
+	private:
+		std::vector<Tile> _buf; /// Tile storage.
+		size_t _head = 0;       /// Index of the first queued tile.
+		size_t _size = 0;       /// Amount of queued tiles.
+		size_t _mask = 0;       /// Index wrap mask.
+
+	public:
+		/// Ensures the queue can store a specific amount of tiles.
+		///
+		/// Capacity is rounded up to the next power of 2.
+		/// Queued tiles are preserved.
+		///
+		/// @param count Required tile capacity.
+		void reserve(size_t count);
+
+		/// Returns current tile capacity.
+		size_t capacity() const;
+
+		/// Checks if the queue is empty.
+		bool empty() const { return _size == 0; };
+
+		/// Drops all queued tiles.
+		void clear();
+
+		/// Queues a tile.
+		///
+		/// @param tile Spread tile.
+		void push(const Tile& tile) {
+			// grow if out of space
+			if (_size == _buf.size())
+				[[unlikely]] reserve(_size + 1);
+
+			// store tile at the end
+			_buf[(_head + _size++) & _mask] = tile;
+		};
+
+		/// Removes the first queued tile.
+		///
+		/// @return Tile information.
+		Tile pop() {
+			Tile tile = _buf[_head];
+			_head = (_head + 1) & _mask;
+			_size--;
+			return tile;
+		};
+	};
+
+	/// Spread queue lease.
+	///
+	/// Borrows a shared spread queue for the duration of a spread pass.
+	/// Shared queues are owned by the calling thread.
+	/// If the shared queue is already in use (same index spread nested
+	/// inside another one), a private queue is used instead.
+	class Lease {
+	private:
+		Frontier _local;  /// Private fallback queue.
+		Frontier* _queue; /// Leased queue.
+		bool _alt;        /// Leased queue index.
+		bool _shared;     /// Whether the shared queue was leased.
+
+	public:
+		/// Leases a spread queue.
+		///
+		/// @param alt Spread index type.
+		/// @param count Tile count of the spread array.
+		Lease(bool alt, size_t count);
+
+		/// Releases the shared queue.
+		~Lease();
+
+		/// Disabled copying.
+		Lease(const Lease&) = delete;
+		/// Disabled copying.
+		Lease& operator=(const Lease&) = delete;
+
+		/// Returns leased queue.
+		Frontier& operator*() const { return *_queue; };
+	};
+};
+
+/// Statically typed effect spread description.
+///
+/// Same as `Spread`, but predicates are stored by their own type,
+/// so they get inlined into the spread loop instead of being called
+/// through `std::function`. Should be used by hot spread passes.
+///
+/// Converts to a type-erased `Spread` when one is required.
+///
+/// @tparam Hop Blocking check type.
+/// @tparam Pass Non-blocking check type.
+/// @tparam Effect Tile effect type.
+template <typename Hop = Spread::Any, typename Pass = Spread::Any, typename Effect = Spread::None>
+struct BasicSpread {
+	/// Blocking check.
+	///
+	/// If this check fails, the spread will not propagate to neighboring tiles.
+	Hop hop {};
+	/// Non-blocking check.
+	///
+	/// This check is only used to conditionally apply the effect.
+	Pass pass {};
+	/// Tile effect function.
+	///
+	/// Gets applied to every reached hex if `pass()` check passes.
+	Effect effect {};
+	/// Whether the spread affects the origin tile.
+	bool imm = false;
+	/// Whether to use alternative spread index.
+	///
+	/// Should be used for spreaders applied inside other spreaders.
+	bool alt = Spread::Def;
+
+	/// Applies the spread.
+	/// 
+	/// The tile located at origin does *not* get affected, but is marked as "visited".
+	/// 
+	/// @param array Target tile array.
+	/// @param pos Spread origin.
+	/// @param radius Maximum spread radius (infinite by default).
+	///
+	/// @return Spread index.
+	size_t apply(const HexArray& array, sf::Vector2i pos, size_t radius = ~0ull) const {
+		return _run(array, pos, radius, [](const Spread::Tile&) {});
+	};
+
+	/// Applies the spread.
+	/// 
+	/// The tile located at origin does *not* get affected, but is marked as "visited".
+	/// 
+	/// @param array Target tile array.
+	/// @param pos Spread origin.
+	/// @param radius Maximum spread radius (infinite by default).
+	/// 
+	/// @return List of coordinates of all visited tiles.
+	Spread::List applylist(const HexArray& array, sf::Vector2i pos, size_t radius = ~0ull) const {
+		Spread::List affected;
+		applylist(array, pos, affected, radius);
+		return affected;
+	};
+
+	/// Applies the spread.
+	/// 
+	/// The tile located at origin does *not* get affected, but is marked as "visited".
+	/// 
+	/// Visited tiles are written into a caller-owned list.
+	/// The list is cleared first, but its capacity is kept.
+	/// 
+	/// @param array Target tile array.
+	/// @param pos Spread origin.
+	/// @param list Output coordinate list.
+	/// @param radius Maximum spread radius (infinite by default).
+	/// 
+	/// @return Spread index.
+	size_t applylist(const HexArray& array, sf::Vector2i pos, Spread::List& list, size_t radius = ~0ull) const {
+		list.clear();
+		return _run(array, pos, radius, [&list](const Spread::Tile& tile) {
+			list.push_back(tile.pos);
+		});
+	};
+
+	/// Converts the spread into a type-erased spread.
+	operator Spread() const {
+		return Spread {
+			.hop = hop,
+			.pass = pass,
+			.effect = effect,
+			.imm = imm,
+			.alt = alt
+		};
+	};
+
+private:
+	/// Adds neighboring tiles to spread queue.
+	///
+	/// @param queue Spread queue.
+	/// @param array Tile array.
+	/// @param marks Spread visit mark plane.
+	/// @param index Spread index.
+	/// @param tile Processed tile.
+	void _spread(Spread::Frontier& queue, const HexArray& array, size_t* marks, size_t index, const Spread::Tile& tile) const {
+		// ignore if no range left
+		if (tile.left == 0) return;
+
+		// spread to each neighbor
+		for (int i = 0; i < 6; i++) {
+			// next tile info
+			Spread::Tile next = {
+				array.atref(
+					array.neighbor(tile.pos, static_cast<HexArray::nbi_t>(i))
+				),
+				tile.left - 1
+			};
+
+			// discard if outside the map
+			if (!next.hex) continue;
+
+			// mark as visited
+			size_t& mark = marks[array.index(next.pos)];
+			if (mark != index)
+				mark = index;
+			else continue;
+
+			// queue tile if passes blocking check
+			if (hop(next))
+				queue.push(next);
+		};
+	};
+
+	/// Runs a spread pass.
+	///
+	/// @param array Target tile array.
+	/// @param pos Spread origin.
+	/// @param radius Maximum spread radius.
+	/// @param visit Called for each affected tile.
+	///
+	/// @return Spread index.
+	template <typename Visit> size_t _run(const HexArray& array, sf::Vector2i pos, size_t radius, Visit&& visit) const {
+		// get new spread index
+		size_t idx = Spread::index(alt);
+
+		// get origin tile
+		Hex* origin = array.at(pos);
+		if (!origin) return idx;
+		Spread::Tile tile = { { origin, pos }, radius };
+
+		// apply effect to origin if needed
+		size_t* marks = array.marks(alt);
+		marks[array.index(pos)] = idx;
+		if (imm && pass(tile)) {
+			effect(tile);
+			visit(tile);
+		};
+		if (!radius) return idx;
+
+		// tile queue
+		Spread::Lease lease(alt, array.count());
+		Spread::Frontier& queue = *lease;
+
+		// initial spread from origin
+		_spread(queue, array, marks, idx, tile);
+
+		// spreader loop
+		while (!queue.empty()) {
+			// pull next tile
+			Spread::Tile tile = queue.pop();
+
+			// apply effect
+			if (pass(tile)) {
+				effect(tile);
+				visit(tile);
+			};
+
+			// spread to neighboring tiles
+			_spread(queue, array, marks, idx, tile);
+		};
+
+		// return spread index
+		return idx;
+	};
+};
@@ -14,6 +14,11 @@ struct Adapter {
 	template <typename T> struct Packet {
 		T     value; /// Packed value.
 		uint32_t id; /// Player index.
+
+		/// Sender map hash after applying the packet (0 if unknown).
+		///
+		/// Only transmitted with move lists.
+		uint64_t hash = 0;
 	};
 
 	/// Optional packet type.
@@ -23,7 +28,10 @@ struct Adapter {
 	/// Sends a move list.
 	virtual void send_list(Packet<History::SpanList> list) = 0;
 	/// Sends a move list from this adapter.
-	void send_list(History::SpanList list);
+	///
+	/// @param list Move list.
+	/// @param hash Map hash after applying the list.
+	void send_list(History::SpanList list, uint64_t hash = 0);
 
 	/// Receives a move list.
 	virtual OptPacket<History::UniqList> recv_list() = 0;
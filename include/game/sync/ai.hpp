@@ -2,8 +2,17 @@
 
 // include dependencies
 #include "adapter.hpp"
+#include "game/move_log.hpp"
+#include <future>
 
 /// AI game adapter.
+///
+/// Bot turns are planned on a private copy of the map, on a separate thread,
+/// so the game keeps running while bots think. The move list is returned
+/// once planning is done, or once the time budget runs out.
+///
+/// The copy is built from the initialization message and kept up to date
+/// by applying every sent move list, so planning does not need to copy the map.
 struct BotAdapter : Adapter {
 	/// Map reference.
 	Map* map = nullptr;
@@ -11,6 +20,12 @@ struct BotAdapter : Adapter {
 	std::optional<uint32_t> next = 0;
 	/// Bot difficulty coefficient.
 	float difficulty = 1.f;
+	/// Planning time budget per turn (in seconds).
+	double budget = 0.5;
+	/// Lowest difficulty planning troop actions with a lookahead search.
+	///
+	/// Lower difficulties move troops by ranking single moves only.
+	float search = 0.75f;
 	/// Player list.
 	std::vector<Messages::Player> list;
 
@@ -29,4 +44,33 @@ struct BotAdapter : Adapter {
 	void send(Packet<Messages::Event> evt) override;
 	/// Receives an event.
 	OptPacket<Messages::Event> recv() override;
+
+private:
+	/// Planned bot turn.
+	struct Plan {
+		MoveLog moves;            /// Planned moves.
+		Random::Generator random; /// Generator state after planning.
+		uint64_t hash = 0;        /// Map hash after planning (0 if not verified).
+		uint32_t id = 0;          /// Player index.
+	};
+
+	Map _copy;                    /// Private map copy, owned by the planning thread while planning.
+	MoveLog _log;                 /// Sent move list buffer.
+	std::optional<uint32_t> _own; /// Player index of a returned plan, already applied to the copy.
+
+	/// Turn plan being computed.
+	///
+	/// Declared after the map copy, so it is waited for before the copy is destroyed.
+	std::future<Plan> _plan;
+
+	/// Copies the whole map.
+	///
+	/// Only used if the private copy has diverged from the map.
+	/// Runs on the calling thread in time linear to map size.
+	void resync();
+
+	/// Starts planning a bot turn.
+	///
+	/// @param idx Player index.
+	void plan(uint32_t idx);
 };
\ No newline at end of file
@@ -20,6 +20,12 @@ namespace Messages {
 
 		/// Player list.
 		std::vector<Player> players;
+
+		/// Map random generator seed.
+		uint64_t seed = 0;
+
+		/// Host map hash after initialization (0 if unchecked).
+		uint64_t hash = 0;
 	};
 
 	/// Game over.
@@ -52,4 +58,21 @@ namespace Messages {
 		Select,
 		Chat
 	>;
+
+	/// Seeds the host map and describes it for clients.
+	///
+	/// @param map Host map reference.
+	/// @param players Player list.
+	/// @param seed Map random generator seed.
+	///
+	/// @return Game initialization message.
+	Init init(Map* map, const std::vector<Player>& players, uint64_t seed);
+
+	/// Constructs a client map from a game initialization message.
+	///
+	/// @param map Client map reference.
+	/// @param init Game initialization message.
+	///
+	/// @return Whether the map matches the host map.
+	bool join(Map* map, const Init& init);
 };
\ No newline at end of file
@@ -4,7 +4,9 @@
 #include "networking/Net.hpp"
 #include "game/serialize/messages.hpp" 
 #include "game/serialize/moves.hpp"    
+#include "game/move_log.hpp"
 #include <queue>
+#include <algorithm>
 #include <cassert>
 
 class NetworkAdapter : public Adapter {
@@ -15,6 +17,13 @@ private:
     std::queue<Packet<Messages::Event>> _eventQueue;
     std::queue<Packet<History::UniqList>> _moveListQueue;
 
+    // Encoding buffer, reused between sends so it keeps its capacity
+    std::vector<uint8_t> _buffer;
+
+    // Move logs, reused between move lists so they keep their capacity
+    MoveLog _sendLog;
+    MoveLog _recvLog;
+
     // Protocol headers to distinguish between Events and Move Lists
     enum PacketType : uint8_t {
         Type_Event = 0,
@@ -35,36 +44,37 @@ public:
 
     // 1. Send an Event (Chat, Next Turn, Init, etc.)
     void send(Packet<Messages::Event> evt) override {
-        sf::Packet packet;
+        _buffer.clear();
+        Serialize::ByteWriter writer(_buffer);
         
         // Write Header
-        packet << (uint8_t)Type_Event;
-        packet << evt.id; // Write the Player ID who generated this event
+        writer << (uint8_t)Type_Event;
+        writer << evt.id; // Write the Player ID who generated this event
 
         // Write the actual message using YOUR serialization code
-        Serialize::encodeMessage(packet, evt.value);
+        Serialize::encodeMessage(writer, evt.value);
 
-        _net.send(packet);
+        sendBytes(writer);
     }
 
     // 2. Send a List of Moves (Unit attacks, movements, etc.)
     void send_list(Packet<History::SpanList> list) override {
-        sf::Packet packet;
+        _buffer.clear();
+        Serialize::ByteWriter writer(_buffer);
 
         // Write Header
-        packet << (uint8_t)Type_MoveList;
-        packet << list.id;
+        writer << (uint8_t)Type_MoveList;
+        writer << list.id;
 
-        // Write how many moves are in the list
-        uint32_t count = (uint32_t)list.value.size();
-        packet << count;
+        // Write sender map hash for desync checks
+        writer << list.hash;
 
-        // Write each move using existing move serializer
-        for (const auto& move : list.value) {
-            Serialize::encodeMove(packet, move.get());
-        }
+        // Write move count and encoded moves through the move log
+        _sendLog.clear();
+        _sendLog.push(list.value);
+        _sendLog.write(writer);
 
-        _net.send(packet);
+        sendBytes(writer);
     }
 
     // --- Receiving Data (Network -> Game) ---
@@ -86,42 +96,49 @@ public:
     }
 
 private:
+    // Hands encoded bytes over to SFML, the only copy on the way out
+    void sendBytes(const Serialize::ByteWriter& writer) {
+        sf::Packet packet;
+        Serialize::writePacket(packet, writer.bytes());
+        _net.send(packet);
+    }
+
     // Called when Net receives bytes
     void onPacketInternal(const std::string& sender, sf::Packet& packet) {
+        // Read packet contents in place
+        Serialize::ByteReader reader = Serialize::readPacket(packet);
         uint8_t type;
         
         // REMOVED: assert(packet.endOfPacket()); -- wrong place, packet is full here
         
-        if (!(packet >> type)) return; // Safety check
+        if (!(reader >> type)) return; // Safety check
 
         uint32_t playerId;
-        if (!(packet >> playerId)) return;
+        if (!(reader >> playerId)) return;
 
         if (type == Type_Event) {
-            auto msg = Serialize::decodeMessage(packet);
+            auto msg = Serialize::decodeMessage(reader);
             if (msg) {
                 _eventQueue.push({ std::move(*msg), playerId });
             }
         }
         else if (type == Type_MoveList) {
-            uint32_t count;
-            if (packet >> count) {
-                History::UniqList moves;
-                moves.reserve(count);
-                
-                for (uint32_t i = 0; i < count; ++i) {
-                    auto move = Serialize::decodeMove(packet);
-                    if (move) moves.push_back(std::move(move));
-                }
+            // Whole list is dropped if any move is invalid
+            uint64_t hash;
+            _recvLog.clear();
+            if ((reader >> hash) && _recvLog.read(reader)) {
+                History::UniqList moves = _recvLog.decode();
+                bool valid = std::all_of(moves.begin(), moves.end(),
+                    [](const auto& move) { return move != nullptr; });
                 
-                if (!moves.empty()) {
-                    _moveListQueue.push({ std::move(moves), playerId });
+                if (valid && !moves.empty()) {
+                    _moveListQueue.push({ std::move(moves), playerId, hash });
                 }
             }
         }
 
         // CORRECT PLACE: Check that we consumed exactly what was sent.
         // If this triggers, either the sender wrote too much or we read too little.
-        assert(packet.endOfPacket());
+        assert(reader.end());
     }
 };
\ No newline at end of file
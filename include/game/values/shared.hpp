@@ -54,4 +54,7 @@ namespace Values {
 
 	/// Keyboard pan speed multiplier.
 	extern const float panSpeed;
+
+	/// Default camera zoom from which the map is drawn in low detail.
+	extern const float lodZoom;
 };
\ No newline at end of file
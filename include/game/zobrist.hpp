@@ -0,0 +1,40 @@
+#pragma once
+
+// include dependencies
+#include "hex.hpp"
+
+/// Zobrist hashing of map state.
+///
+/// Every tile and region state maps to a pseudo-random 64-bit key.
+/// Keys are derived by mixing state values instead of being stored
+/// in random tables, so all peers get the same keys without sharing them.
+/// Map hash is a XOR of keys of all its tiles and regions.
+namespace Zobrist {
+	/// Returns a key of a tile state.
+	///
+	/// Covers tile type, team and the entity on the tile
+	/// (type, hitpoints, timers and effects). Plant roll counters
+	/// are only kept by the host and are not sent to peers,
+	/// so they are left out.
+	///
+	/// @param index Linear tile index.
+	/// @param hex Tile reference.
+	uint64_t tile(size_t index, const Hex& hex);
+
+	/// Returns a membership key of a tile.
+	///
+	/// Region membership hash is a XOR of member keys of its tiles.
+	///
+	/// @param pos Tile position.
+	uint64_t member(sf::Vector2i pos);
+
+	/// Returns a key of a region state.
+	///
+	/// Covers region team, size, resources, counters and membership hash.
+	/// Regions are identified by the tiles they contain, so the key does not
+	/// depend on region access points or pool slots, and keys of same-team
+	/// regions in the same state do not cancel out.
+	///
+	/// @param reg Region reference.
+	uint64_t region(const Region& reg);
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+// include dependencies
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/// Read-only memory mapped file.
+///
+/// File contents are mapped into memory on open
+/// and can be viewed in place without copying.
+class MappedFile {
+private:
+	const uint8_t* _data = nullptr; /// Mapped file contents.
+	size_t         _size = 0;       /// File size.
+
+#ifdef _WIN32
+	void* _file = nullptr; /// File handle.
+	void* _map  = nullptr; /// File mapping handle.
+#endif
+
+public:
+	/// Constructs an unmapped file.
+	MappedFile() = default;
+	/// Unmaps the file.
+	~MappedFile();
+
+	/// Disabled copying.
+	MappedFile(const MappedFile&) = delete;
+	/// Disabled copying.
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// Maps a file into memory.
+	///
+	/// Previously mapped file is unmapped.
+	///
+	/// @param path File path.
+	///
+	/// @return Whether the file was mapped (empty files are never mapped).
+	bool open(const std::filesystem::path& path);
+
+	/// Unmaps the file.
+	void close();
+
+	/// Returns mapped file contents.
+	const uint8_t* data() const { return _data; };
+	/// Returns mapped file size.
+	size_t size() const { return _size; };
+};
@@ -6,7 +6,75 @@
 
 /// Randomness generator namespace.
 namespace Random {
-	/// Reset generator and sets a seed.
+	/// Seedable pseudo-random number generator.
+	///
+	/// Uses xoshiro256** seeded through splitmix64.
+	/// Every generator owns its state, so separate generators
+	/// can be used from separate threads without locking.
+	class Generator {
+	private:
+		uint64_t _state[4]; /// Generator state.
+
+	public:
+		/// Constructs a generator.
+		///
+		/// @param value Seed number.
+		explicit Generator(uint64_t value = 0);
+
+		/// Resets generator and sets a seed.
+		///
+		/// Same seeds always produce same sequences.
+		///
+		/// @param value Seed number.
+		void seed(uint64_t value);
+
+		/// Returns an independent generator stream.
+		///
+		/// Streams are 2^128 numbers apart, so they never overlap
+		/// for any realistic amount of numbers generated.
+		/// Generator state is not modified.
+		///
+		/// @param index Stream index (0 returns a copy).
+		Generator stream(size_t index) const;
+
+		/// Returns a random unsigned 8-bit number.
+		uint8_t u8();
+		/// Returns a random unsigned 16-bit number.
+		uint16_t u16();
+		/// Returns a random unsigned 32-bit number.
+		uint32_t u32();
+		/// Returns a random unsigned 64-bit number.
+		uint64_t u64();
+
+		/// Fills an array with random unsigned 64-bit numbers.
+		///
+		/// Produces the same numbers as consecutive `u64()` calls.
+		///
+		/// @param data Target array.
+		/// @param count Number count.
+		void fill(uint64_t* data, size_t count);
+
+		/// Returns a random float in range `[0, 1)`.
+		float uniform();
+
+		/// Returns whether a chance succeeds.
+		///
+		/// @param value Success rate.
+		bool chance(float value);
+
+		/// Rolls a chance with pity.
+		///
+		/// @param value Base roll chance.
+		/// @param fail Fail counter.
+		/// @param max Maximum amount of fails.
+		bool pity(float value, uint8_t& fail, uint8_t max);
+
+	private:
+		/// Advances the state by 2^128 steps.
+		void _jump();
+	};
+
+	/// Reset generator of the calling thread and sets a seed.
 	///
 	/// @param value Seed number.
 	void seed(size_t value);
@@ -34,4 +102,4 @@ namespace Random {
 	/// @param fail Fail counter.
 	/// @param max Maximum amount of fails.
 	bool pity(float value, uint8_t& fail, uint8_t max);
-};
\ No newline at end of file
+};
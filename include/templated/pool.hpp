@@ -1,8 +1,9 @@
 #pragma once
 
 // include dependencies
+#include <cstddef>
+#include <utility>
 #include <vector>
-#include <set>
 
 /// Pool container object.
 ///
@@ -10,6 +11,9 @@
 /// Items can be accessed by static references.
 /// Items are stored in arbitrary order.
 /// 
+/// Deleted slots are linked into an intrusive free list,
+/// so adding and deleting items takes constant time.
+/// 
 /// @tparam T Stored item type.
 template <typename T> class Pool {
 public:
@@ -20,9 +24,21 @@ public:
 	class ConstIt; friend ConstIt;
 
 private:
-	std::vector<T>   _storage; /// Pool storage.
-	std::set<size_t> _deleted; /// Deleted pool indices.
-	bool _void = false;        /// Whether to void deletion calls.
+	/// Item storage info.
+	struct V {
+		T      item; /// Item data.
+		size_t next; /// Next free slot index, `Live` if the slot is in use.
+	};
+
+	/// Free list link of a used slot.
+	static constexpr size_t Live = ~0ull;
+	/// Free list end marker.
+	static constexpr size_t End = ~1ull;
+
+	std::vector<V> _storage; /// Pool storage.
+	size_t _free = End;      /// First free slot index.
+	size_t _count = 0;       /// Amount of items in the pool.
+	bool _void = false;      /// Whether to void deletion calls.
 
 public:
 	/// Pool item reference object.
@@ -83,9 +99,9 @@ public:
 		size_t index() const { return _idx; };
 
 		/// Returns the referenced item.
-		T& operator*() const { return _pool->_storage[_idx]; };
+		T& operator*() const { return _pool->_storage[_idx].item; };
 		/// Returns a pointer to the referenced item.
-		T* operator->() const { return &_pool->_storage[_idx]; };
+		T* operator->() const { return &_pool->_storage[_idx].item; };
 	};
 
 	/// Owning pool item reference object.
@@ -134,19 +150,22 @@ public:
 	///
 	/// @return Item reference object.
 	[[nodiscard]] Item add(T&& item) {
-		if (_deleted.empty()) {
+		_count++;
+		if (_free == End) {
 			// push item to storage end
 			size_t idx = _storage.size();
-			_storage.push_back(item);
+			_storage.push_back({ std::move(item), Live });
 			return { this, idx };
 		};
 
-		// pull a deleted index
-		size_t idx = *_deleted.begin();
-		_deleted.erase(_deleted.begin());
+		// pull a free slot
+		size_t idx = _free;
+		V& slot = _storage[idx];
+		_free = slot.next;
 
 		// overwrite the deleted space
-		_storage[idx] = item;
+		slot.item = std::move(item);
+		slot.next = Live;
 		return { this, idx };
 	};
 
@@ -172,7 +191,7 @@ public:
 	/// Returns current pool capacity.
 	size_t capacity() const { return _storage.size(); };
 	/// Returns amount of items in the pool.
-	size_t count() const { return _storage.size() - _deleted.size(); };
+	size_t count() const { return _count; };
 
 protected:
 	/// Deletes a referenced item from the pool.
@@ -181,26 +200,11 @@ protected:
 	void pop(size_t idx) {
 		// ignore if pool has been destroyed already
 		if (_void) return;
-		if (idx + 1 == _storage.size()) {
-			// delete item at storage end
-			_storage.pop_back();
-
-			// check for trailing deleted indices
-			while (!_deleted.empty()) {
-				// get farthest deleted index
-				size_t idx = *_deleted.rbegin();
-				if (idx + 1 != _storage.size())
-					[[unlikely]] break;
-
-				// delete last item in storage
-				_deleted.erase(std::next(_deleted.rbegin()).base());
-				_storage.pop_back();
-			};
-			return;
-		};
 
-		// mark index as deleted
-		_deleted.insert(idx);
+		// link the slot into free list
+		_storage[idx].next = _free;
+		_free = idx;
+		_count--;
 	};
 
 public:
@@ -210,32 +214,21 @@ public:
 
 	private:
 		/// Pool storage vector.
-		std::vector<T>* _storage;
+		std::vector<V>* _storage;
 		/// Current index.
 		size_t _idx;
-		/// Deleted index set.
-		const std::set<size_t>* _deleted;
-		/// Deleted index set iterator.
-		std::set<size_t>::const_iterator _it;
 
 		/// Hidden iterator constructor.
 		/// 
 		/// @param pool Pool reference.
-		It(Pool* pool) :
-			_storage(&pool->_storage), _idx(0),
-			_deleted(&pool->_deleted), _it(pool->_deleted.cbegin())
-		{
+		It(Pool* pool) : _storage(&pool->_storage), _idx(0) {
 			forward();
 		};
 
 		/// Increases index until an item is found.
 		void forward() {
-			while (_idx < _storage->size()) {
-				if (_it == _deleted->cend() || *_it != _idx)
-					break;
+			while (_idx < _storage->size() && (*_storage)[_idx].next != Live)
 				_idx++;
-				_it++;
-			};
 		};
 
 	public:
@@ -245,7 +238,7 @@ public:
 			if (_idx >= _storage->size()) return nullptr;
 
 			// store pointer
-			T* ptr = &_storage->at(_idx++);
+			T* ptr = &(*_storage)[_idx++].item;
 			forward();
 			return ptr;
 		};
@@ -257,32 +250,21 @@ public:
 
 	private:
 		/// Pool storage vector.
-		const std::vector<T>* _storage;
+		const std::vector<V>* _storage;
 		/// Current index.
 		size_t _idx;
-		/// Deleted index set.
-		const std::set<size_t>* _deleted;
-		/// Deleted index set iterator.
-		std::set<size_t>::const_iterator _it;
 
 		/// Hidden iterator constructor.
 		/// 
 		/// @param pool Pool reference.
-		ConstIt(const Pool* pool) :
-			_storage(&pool->_storage), _idx(0),
-			_deleted(&pool->_deleted), _it(pool->_deleted.cbegin())
-		{
+		ConstIt(const Pool* pool) : _storage(&pool->_storage), _idx(0) {
 			forward();
 		};
 
 		/// Increases index until an item is found.
 		void forward() {
-			while (_idx < _storage->size()) {
-				if (_it == _deleted->cend() || *_it != _idx)
-					break;
+			while (_idx < _storage->size() && (*_storage)[_idx].next != Live)
 				_idx++;
-				_it++;
-			};
 		};
 
 	public:
@@ -292,7 +274,7 @@ public:
 			if (_idx >= _storage->size()) return nullptr;
 
 			// store pointer
-			const T* ptr = &_storage->at(_idx++);
+			const T* ptr = &(*_storage)[_idx++].item;
 			forward();
 			return ptr;
 		};
@@ -1,14 +1,18 @@
 #pragma once
 
 // include dependencies
+#include <cstddef>
+#include <utility>
 #include <vector>
-#include <set>
 
 /// Reference pool container object.
 /// 
 /// Stores items in a continuous memory block.
 /// Items are deleted once there are no references to it.
 /// 
+/// Deleted slots are linked into an intrusive free list,
+/// so adding and deleting items takes constant time.
+/// 
 /// @tparam T Stored item type.
 template <typename T> class RefPool {
 public:
@@ -22,11 +26,18 @@ private:
 	struct V {
 		T      item; /// Item data.
 		size_t refs; /// Reference count.
+		size_t next; /// Next free slot index, `Live` if the slot is in use.
 	};
 
-	std::vector<V>   _storage; /// Pool storage.
-	std::set<size_t> _deleted; /// Deleted indices.
-	bool _void = false;        /// Whether to void deletion calls.
+	/// Free list link of a used slot.
+	static constexpr size_t Live = ~0ull;
+	/// Free list end marker.
+	static constexpr size_t End = ~1ull;
+
+	std::vector<V> _storage; /// Pool storage.
+	size_t _free = End;      /// First free slot index.
+	size_t _count = 0;       /// Amount of items in the pool.
+	bool _void = false;      /// Whether to void deletion calls.
 
 public:
 	/// Shared pool item reference.
@@ -124,19 +135,23 @@ public:
 	///
 	/// @return Item reference object.
 	[[nodiscard]] Share add(T&& item) {
-		if (_deleted.empty()) {
+		_count++;
+		if (_free == End) {
 			// push item to storage end
 			size_t idx = _storage.size();
-			_storage.push_back({ item, 1 });
+			_storage.push_back({ std::move(item), 1, Live });
 			return { this, idx };
 		};
 
-		// pull a deleted index
-		size_t idx = *_deleted.begin();
-		_deleted.erase(_deleted.begin());
+		// pull a free slot
+		size_t idx = _free;
+		V& slot = _storage[idx];
+		_free = slot.next;
 
 		// overwrite the deleted space
-		_storage[idx] = { item, 1 };
+		slot.item = std::move(item);
+		slot.refs = 1;
+		slot.next = Live;
 		return { this, idx };
 	};
 
@@ -162,7 +177,17 @@ public:
 	/// Returns current pool capacity.
 	size_t capacity() const { return _storage.size(); };
 	/// Returns amount of items in the pool.
-	size_t count() const { return _storage.size() - _deleted.size(); };
+	size_t count() const { return _count; };
+
+	/// Returns an item by its index.
+	///
+	/// @param idx Item index.
+	///
+	/// @return Item pointer, or `nullptr` if the slot is not in use.
+	T* get(size_t idx) {
+		if (idx >= _storage.size() || _storage[idx].next != Live) return nullptr;
+		return &_storage[idx].item;
+	};
 
 protected:
 	/// Increments the amount of references to an item.
@@ -184,28 +209,16 @@ protected:
 		// decrement reference count
 		// return if references left
 		if (--_storage[idx].refs > 0) return;
-		
-		// delete item
-		if (idx + 1 == _storage.size()) {
-			// delete item at storage end
-			_storage.pop_back();
-
-			// check for trailing deleted indices
-			while (!_deleted.empty()) {
-				// get farthest deleted index
-				size_t idx = *_deleted.rbegin();
-				if (idx + 1 != _storage.size())
-					[[unlikely]] break;
-
-				// delete last item in storage
-				_deleted.erase(std::next(_deleted.rbegin()).base());
-				_storage.pop_back();
-			};
-			return;
-		};
 
-		// mark index as deleted
-		_deleted.insert(idx);
+		// take item state out of the storage,
+		// so references held by the item get released
+		// only after the storage has been updated
+		T item = std::move(_storage[idx].item);
+
+		// link the slot into free list
+		_storage[idx].next = _free;
+		_free = idx;
+		_count--;
 	};
 
 public:
@@ -218,29 +231,18 @@ public:
 		std::vector<V>* _storage;
 		/// Current index.
 		size_t _idx;
-		/// Deleted index set.
-		const std::set<size_t>* _deleted;
-		/// Deleted index set iterator.
-		std::set<size_t>::const_iterator _it;
 
 		/// Hidden iterator constructor.
 		/// 
 		/// @param pool Pool reference.
-		It(RefPool* pool) :
-			_storage(&pool->_storage), _idx(0),
-			_deleted(&pool->_deleted), _it(pool->_deleted.cbegin())
-		{
+		It(RefPool* pool) : _storage(&pool->_storage), _idx(0) {
 			forward();
 		};
 
 		/// Increases index until an item is found.
 		void forward() {
-			while (_idx < _storage->size()) {
-				if (_it == _deleted->cend() || *_it != _idx)
-					break;
+			while (_idx < _storage->size() && (*_storage)[_idx].next != Live)
 				_idx++;
-				_it++;
-			};
 		};
 
 	public:
@@ -250,7 +252,7 @@ public:
 			if (_idx >= _storage->size()) return nullptr;
 
 			// store pointer
-			T* ptr = &_storage->at(_idx++).item;
+			T* ptr = &(*_storage)[_idx++].item;
 			forward();
 			return ptr;
 		};
@@ -265,29 +267,18 @@ public:
 		const std::vector<V>* _storage;
 		/// Current index.
 		size_t _idx;
-		/// Deleted index set.
-		const std::set<size_t>* _deleted;
-		/// Deleted index set iterator.
-		std::set<size_t>::const_iterator _it;
 
 		/// Hidden iterator constructor.
 		/// 
 		/// @param pool Pool reference.
-		ConstIt(const RefPool* pool) :
-			_storage(&pool->_storage), _idx(0),
-			_deleted(&pool->_deleted), _it(pool->_deleted.cbegin())
-		{
+		ConstIt(const RefPool* pool) : _storage(&pool->_storage), _idx(0) {
 			forward();
 		};
 
 		/// Increases index until an item is found.
 		void forward() {
-			while (_idx < _storage->size()) {
-				if (_it == _deleted->cend() || *_it != _idx)
-					break;
+			while (_idx < _storage->size() && (*_storage)[_idx].next != Live)
 				_idx++;
-				_it++;
-			};
 		};
 
 	public:
@@ -297,7 +288,7 @@ public:
 			if (_idx >= _storage->size()) return nullptr;
 
 			// store pointer
-			const T* ptr = &_storage->at(_idx++).item;
+			const T* ptr = &(*_storage)[_idx++].item;
 			forward();
 			return ptr;
 		};
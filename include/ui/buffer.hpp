@@ -5,16 +5,20 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/Text.hpp>
-#include <list>
+#include <span>
+#include <vector>
 
 namespace ui {
 	/// UI rendering statistics.
 	struct RenderStats {
 		size_t quads     = 0; /// Amount of quads rendered.
 		size_t triangles = 0; /// Amount of triangles rendered.
+		size_t vertices  = 0; /// Amount of vertices rendered.
 		size_t text      = 0; /// Amount of text lines rendered.
-		size_t batches   = 0; /// Amount of batches rendered.
+		size_t batches   = 0; /// Amount of draw calls (vertex batches & text lines).
 		size_t inters    = 0; /// Amount of intermediate textures rendered.
+		size_t cached    = 0; /// Amount of cached vertex chunks reused.
+		size_t rebuilt   = 0; /// Amount of cached vertex chunks rebuilt.
 
 		/// Compiles rendering stats from another structure.
 		/// @param oth Other structure.
@@ -26,6 +30,10 @@ namespace ui {
 
 	/// UI render buffer.
 	/// Allows to render a vertex buffer with a single texture.
+	///
+	/// All queues are vectors cleared between frames, so their capacity
+	/// is kept and steady frames are queued without heap allocations
+	/// (except for `sf::Text` copies queued with `text()`).
 	class RenderBuffer {
 		friend Interface;
 
@@ -41,14 +49,14 @@ namespace ui {
 			sf::FloatRect      scissor; /// Scissor rectangle.
 		};
 
-		std::vector<sf::Vertex>  _arr; /// Vertex array.
-		mutable sf::RenderStates _opt; /// Render states.
-		std::list<sf::Text>      _txt; /// Rendered text.
-		std::list<_FI>           _fis; /// Forwarding indices.
-		bool                     _ptl; /// Whether previous forward contained text.
-		RenderStats              _inf; /// Render stats.
-		std::list<sf::FloatRect> _srs; /// Scissor rectangle stack.
-		sf::IntRect              _win; /// Window size.
+		std::vector<sf::Vertex>    _arr; /// Vertex array.
+		mutable sf::RenderStates   _opt; /// Render states.
+		std::vector<sf::Text>      _txt; /// Rendered text.
+		std::vector<_FI>           _fis; /// Forwarding indices.
+		bool                       _ptl; /// Whether previous forward contained text.
+		RenderStats                _inf; /// Render stats.
+		std::vector<sf::FloatRect> _srs; /// Scissor rectangle stack.
+		sf::IntRect                _win; /// Window size.
 
 	public:
 		/// Constructs a new render buffer.
@@ -74,12 +82,36 @@ namespace ui {
 		/// @param color Rectangle tint color.
 		void quad(sf::IntRect area, sf::IntRect texture, sf::Color color = sf::Color::White);
 
+		/// Queues cached vertices for rendering.
+		///
+		/// Vertices must form quads (see `vertices()`).
+		///
+		/// @param vertices Cached vertices.
+		/// @param offset Offset added to vertex positions.
+		/// @param rebuilt Whether the cache has just been rebuilt.
+		void cached(std::span<const sf::Vertex> vertices, sf::Vector2f offset, bool rebuilt);
+		/// Returns queued vertices.
+		///
+		/// Used to capture geometry for caching.
+		std::span<const sf::Vertex> vertices() const;
+
 		/// Queues a text line for rendering.
 		/// 
 		/// Text lines are drawn after quads & triangles.
 		/// 
 		/// @param text Text object.
 		void text(const sf::Text& text);
+		/// Queues a text line as glyph quads.
+		///
+		/// Glyphs are laid out like `sf::Text` does and forwarded
+		/// with the font atlas of the character size, so consecutive labels
+		/// of the same font & size are drawn in a single batch.
+		/// Previous vertices must already be forwarded.
+		///
+		/// Underlined & struck through text falls back to `text()`.
+		///
+		/// @param text Text object.
+		void glyphs(const sf::Text& text);
 
 		/// Sets new scissor area.
 		/// 
@@ -106,6 +138,13 @@ namespace ui {
 		/// @return Render statistics.
 		RenderStats draw(sf::RenderTarget& target) const;
 
+		/// Returns statistics of queued contents.
+		///
+		/// Batches are counted the same way they are drawn
+		/// (every `sf::Text` is a separate draw call),
+		/// so buffers can be measured without a render target.
+		RenderStats stats() const;
+
 		/// @return Buffer rendering states.
 		const sf::RenderStates& states() const;
 		sf::RenderStates& states();
@@ -0,0 +1,71 @@
+#pragma once
+
+// include dependencies
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Worker thread pool.
+///
+/// Runs batches of independent tasks on persistent threads.
+/// The calling thread takes part in every batch as worker 0
+/// and returns once all tasks of the batch are done.
+class Workers {
+public:
+	/// Batch task.
+	///
+	/// @param task Task index.
+	/// @param worker Index of the worker running the task.
+	using Task = std::function<void(size_t task, size_t worker)>;
+
+private:
+	std::vector<std::thread> _threads; /// Worker threads.
+	std::mutex _mutex;                 /// Batch state lock.
+	std::condition_variable _wake;     /// Wakes workers up for a new batch.
+	std::condition_variable _done;     /// Signals batch completion.
+	const Task* _task = nullptr;       /// Current batch task.
+	size_t _count = 0;                 /// Task count of current batch.
+	std::atomic<size_t> _next = 0;     /// Next unclaimed task index.
+	size_t _busy = 0;                  /// Amount of threads still working on the batch.
+	size_t _batch = 0;                 /// Batch counter.
+	bool _stop = false;                /// Whether the threads should exit.
+
+public:
+	/// Starts worker threads.
+	///
+	/// @param count Worker count, including the calling thread (hardware thread count by default).
+	explicit Workers(size_t count = 0);
+	/// Stops worker threads.
+	~Workers();
+
+	/// Disabled copying.
+	Workers(const Workers&) = delete;
+	/// Disabled copying.
+	Workers& operator=(const Workers&) = delete;
+
+	/// Returns worker count, including the calling thread.
+	size_t count() const;
+
+	/// Runs a batch of tasks.
+	///
+	/// Tasks are claimed in index order, but may finish in any order.
+	/// A worker only ever runs on the same thread.
+	///
+	/// @param count Task count.
+	/// @param task Task function.
+	void run(size_t count, const Task& task);
+
+private:
+	/// Runs unclaimed tasks of current batch.
+	///
+	/// @param worker Worker index.
+	void _work(size_t worker);
+
+	/// Worker thread loop.
+	///
+	/// @param worker Worker index.
+	void _loop(size_t worker);
+};
@@ -6,6 +6,7 @@ namespace flags {
 	bool debug      = false;
 	bool any_region = false;
 	bool spread     = false;
+	bool verify     = false;
 
 	/// Processes a keyboard event.
 	void proc(const sf::Event::KeyPressed& evt) {
@@ -26,6 +27,10 @@ namespace flags {
 			// spread toggle
 			if (evt.code == sf::Keyboard::Key::F2 && evt.control)
 				flags::spread = !flags::spread;
+
+			// tile count verification toggle
+			if (evt.code == sf::Keyboard::Key::F3 && evt.control)
+				flags::verify = !flags::verify;
 		};
 	};
 };
\ No newline at end of file
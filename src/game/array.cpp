@@ -43,16 +43,21 @@ HexArray::~HexArray() { clear(); };
 
 /// Move constructor.
 HexArray::HexArray(HexArray&& array) noexcept
-	: _tiles(array._tiles), _size(array._size)
+	: _tiles(array._tiles), _size(array._size),
+	_marks { std::move(array._marks[0]), std::move(array._marks[1]) },
+	_view(array._view)
 {
 	array._tiles = nullptr;
 };
 /// Move assignment.
 HexArray& HexArray::operator=(HexArray&& array) noexcept {
-	this->~HexArray();
+	clear();
 	{
 		_tiles = array._tiles;
 		_size = array._size;
+		_marks[0] = std::move(array._marks[0]);
+		_marks[1] = std::move(array._marks[1]);
+		_view = array._view;
 		array._tiles = nullptr;
 	};
 	return *this;
@@ -77,9 +82,14 @@ bool HexArray::contains(sf::Vector2i pos) const {
 	);
 };
 
+/// Returns spread visit mark of a tile.
+size_t HexArray::mark(sf::Vector2i pos, bool alt) const {
+	return contains(pos) ? _marks[alt][index(pos)] : 0;
+};
+
 /// Unsafe tile look-up.
 Hex& HexArray::ats(sf::Vector2i pos) const {
-	return _tiles[pos.y * _size.x + pos.x];
+	return _tiles[index(pos)];
 };
 
 /// Returns a reference to a tile at position.
@@ -99,8 +109,11 @@ HexRef HexArray::atref(sf::Vector2i pos) const {
 
 /// Clears the array.
 void HexArray::clear() {
-	delete[] _tiles;
+	if (!_view) delete[] _tiles;
 	_tiles = nullptr;
+	_view = false;
+	_marks[0].reset();
+	_marks[1].reset();
 	_size = {};
 };
 
@@ -109,6 +122,24 @@ void HexArray::empty(sf::Vector2i size) {
 	clear();
 	_size = size;
 	_tiles = new Hex[count()];
+	_marks[0] = std::make_unique<size_t[]>(count());
+	_marks[1] = std::make_unique<size_t[]>(count());
+};
+
+/// Creates a view of the array.
+HexArray HexArray::view() const {
+	HexArray array;
+	array._tiles = _tiles;
+	array._size = _size;
+	array._view = true;
+	array._marks[0] = std::make_unique<size_t[]>(count());
+	array._marks[1] = std::make_unique<size_t[]>(count());
+	return array;
+};
+
+/// Checks if the array is a view of another array.
+bool HexArray::views(const HexArray& array) const {
+	return _view && _tiles == array._tiles && _size == array._size;
 };
 
 /// Resizes the array.
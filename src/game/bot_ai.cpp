@@ -5,9 +5,31 @@
 #include "game/values/troop_values.hpp"
 #include "game/values/build_values.hpp"
 #include "game/values/plant_values.hpp"
+#include "workers.hpp"
+#include <algorithm>
+#include <chrono>
 #include <map>
+#include <mutex>
+#include <set>
 
 namespace ai {
+	/// Minimum candidate count for parallel ranking.
+	size_t parallel_min = 512;
+
+	/// Candidates ranked by a single worker task.
+	static constexpr size_t _rank_chunk = 64;
+
+	/// Returns the AI worker pool.
+	///
+	/// Started on first use.
+	static Workers& _workers() {
+		static Workers workers;
+		return workers;
+	};
+
+	/// AI worker pool lock, held by the generator using the pool.
+	static std::mutex _workers_mutex;
+
 	/// Returns available moves for a skill.
 	Spread::List select(
 		Map& map, const Skill& skill,
@@ -17,8 +39,9 @@ namespace ai {
 		// get selection index
 		size_t idx = map.newSelectionIndex();
 		
-		// get move list
-		auto spread = skill.select(state, { hex, pos }, idx);
+		// get move list (selectors may keep a reference to the tile)
+		HexRef tile = { hex, pos };
+		auto spread = skill.select(state, tile, idx);
 		auto list = spread.applylist(map, pos, skill.radius);
 
 		// stop selection
@@ -28,6 +51,7 @@ namespace ai {
 
 	/// Randomly returns a position with the highest ranking.
 	std::optional<sf::Vector2i> get(
+		Random::Generator& rng,
 		const Spread::List& list,
 		std::function<void(sf::Vector2i, int&)> rank,
 		float diff
@@ -38,17 +62,30 @@ namespace ai {
 		if (list.empty()) return {};
 
 		// randomly ignore movement
-		if (Random::chance(ui::lerpf(0.3f, 0.04f, diff)))
+		if (rng.chance(ui::lerpf(0.3f, 0.04f, diff)))
 			return {};
 
 		// compute ranks for each position
-		std::vector<Pair> arr;
-		for (sf::Vector2i pos : list) {
-			Pair p = { pos, 0 };
-			rank(pos, p.second);
-			arr.push_back(p);
+		std::vector<Pair> arr(list.size());
+		auto score = [&](size_t first, size_t last) {
+			for (size_t i = first; i < last; i++) {
+				arr[i] = { list[i], 0 };
+				rank(list[i], arr[i].second);
+			};
 		};
 
+		// rank long lists on the worker pool, every rank is written to its
+		// own slot, so the result does not depend on the worker count
+		std::unique_lock lock(_workers_mutex, std::defer_lock);
+		if (list.size() >= parallel_min && lock.try_lock()) {
+			size_t chunks = (list.size() + _rank_chunk - 1) / _rank_chunk;
+			_workers().run(chunks, [&](size_t i, size_t) {
+				score(i * _rank_chunk, std::min((i + 1) * _rank_chunk, list.size()));
+			});
+			lock.unlock();
+		}
+		else score(0, list.size());
+
 		// sort rank list
 		std::sort(arr.begin(), arr.end(), [=](const Pair& a, const Pair& b) {
 			return a.second > b.second;
@@ -66,11 +103,11 @@ namespace ai {
 		};
 
 		// increase limit according to difficulty
-		limit = (size_t)(limit * ui::lerpf(1.0f, 1.5f, Random::uniform() * diff));
+		limit = (size_t)(limit * ui::lerpf(1.0f, 1.5f, rng.uniform() * diff));
 		limit = std::min(limit, arr.size());
 
 		// return random position
-		return arr[Random::u16() % limit].first;
+		return arr[rng.u16() % limit].first;
 	};
 
 	/// Returns a random empty spot around a tile.
@@ -87,8 +124,8 @@ namespace ai {
 		Region::Team team
 	) {
 		// get empty tiles around
-		static const Spread spread = {
-			.hop = skillf::solidHop,
+		BasicSpread spread = {
+			.hop = skillf::SolidHop(),
 			.pass = [=](const Spread::Tile& tile)
 				{ return tile.hex->team == team && !tile.hex->entity(); }
 		};
@@ -96,109 +133,184 @@ namespace ai {
 
 		// select a random one
 		if (list.empty()) return {};
-		return list[Random::u16() % list.size()];
+		return list[map.random.u16() % list.size()];
 	};
 
-	/// Generates a list of moves for a team.
-	History::UniqList generate(Map& map, Region::Team team, float diff) {
-		// generate move list for each region
-		Regions::foreach(&map, [=, &map](Region& reg, sf::Vector2i pos) {
-			// ignore if not target region
-			if (reg.team != team) return;
+	/// Region survey.
+	///
+	/// Read-only region state gathered before any move is made.
+	struct _Survey {
+		sf::Vector2i pos;  /// Region access point.
+		Spread::List list; /// Entity positions.
+		Spread::List emp;  /// Empty tile positions.
+		int power = 0;     /// Total region power.
+	};
 
-			// total region power
-			int power = 0;
+	/// Surveys a region.
+	///
+	/// Does not modify the tiles, so it can run on any thread
+	/// as long as the array has its own visit marks.
+	///
+	/// @param array Map or a map view.
+	/// @param team Region team.
+	/// @param survey Survey to fill.
+	static void _survey(const HexArray& array, Region::Team team, _Survey& survey) {
+		BasicSpread spread = {
+			// spread in the same region
+			.hop = [=](const Spread::Tile& tile)
+				{ return tile.hex->solid() && tile.hex->team == team; },
+
+			// sort tiles by entity presence
+			.effect = [&survey](const Spread::Tile& tile) {
+				if (!tile.hex->entity()) {
+					survey.emp.push_back(tile.pos);
+					return;
+				};
+				survey.list.push_back(tile.pos);
 
-			// search for entities in region
-			Spread spread = {
-				// spread in the same region
-				.hop = [=](const Spread::Tile& tile)
-					{ return tile.hex->solid() && tile.hex->team == team; },
+				// add tile power
+				if (tile.hex->troop)
+					survey.power += tile.hex->troop->type;
+			},
 
-				// pass if an entity is present
-				.pass = [=](const Spread::Tile& tile)
-					{ return tile.hex->entity(); },
+			// don't ignore point of entry
+			.imm = true
+		};
+		spread.apply(array, survey.pos);
+	};
 
-				// add tile power
-				.effect = [&power](const Spread::Tile& tile) {
-					if (tile.hex->troop)
-						power += tile.hex->troop->type;
-				},
+	/// Surveys all regions.
+	///
+	/// Regions are surveyed on the AI worker pool. If the pool is
+	/// already used by a generator on another thread (e.g. games running
+	/// in parallel), regions are surveyed on the calling thread instead.
+	///
+	/// Move selection and placement spreads stay on the calling thread,
+	/// since every region sees the moves committed by the regions before
+	/// it, and selections mark map tiles. Long candidate lists are
+	/// ranked on the pool by `get()`.
+	///
+	/// @param map Map reference.
+	/// @param team Region team.
+	/// @param surveys Region surveys.
+	static void _survey_all(Map& map, Region::Team team, std::vector<_Survey>& surveys) {
+		static std::vector<HexArray> views;
+		Workers& workers = _workers();
+
+		// survey on the calling thread if the pool is busy
+		std::unique_lock lock(_workers_mutex, std::try_to_lock);
+		if (!lock) {
+			for (_Survey& survey : surveys)
+				_survey(map, team, survey);
+			return;
+		};
+
+		// prepare a map view for every worker thread
+		views.resize(workers.count());
+		for (size_t i = 1; i < views.size(); i++) {
+			if (!views[i].views(map))
+				views[i] = map.view();
+		};
+
+		// survey regions in parallel
+		workers.run(surveys.size(), [&](size_t i, size_t worker) {
+			_survey(worker ? views[worker] : map, team, surveys[i]);
+		});
+	};
 
-				// don't ignore point of entry
-				.imm = true
+	/// Generates a list of moves for a team.
+	History::UniqList generate(Map& map, Region::Team team, float diff, bool troops, double budget) {
+		auto start = std::chrono::steady_clock::now();
+
+		// checks whether the time budget has run out
+		auto out = [=]() {
+			return budget > 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > budget;
+		};
+
+		// collect team regions
+		std::vector<_Survey> surveys;
+		map.regions.foreach(&map, team, [&surveys](Region&, sf::Vector2i pos) {
+			surveys.push_back({ .pos = pos, .list = {}, .emp = {} });
+		});
+
+		// survey regions
+		_survey_all(map, team, surveys);
+
+		// returns surveyed tiles that are still empty
+		auto vacant = [=, &map](const Spread::List& list) {
+			Spread::List emp;
+			for (sf::Vector2i pos : list) {
+				Hex* hex = map.at(pos);
+				if (hex->team == team && !hex->entity())
+					emp.push_back(pos);
 			};
-			auto list = spread.applylist(map, pos);
+			return emp;
+		};
+
+		// generate moves for each region in region order
+		std::set<size_t> visited;
+		for (const _Survey& survey : surveys) {
+			// stop once out of time, keeping moves made so far
+			if (out()) break;
+
+			// ignore if the region has been merged into a visited one,
+			// the region is accessed through its reference, as moves
+			// creating new regions may move the region pool storage
+			Regions::Ref reg = map.at(survey.pos)->region();
+			if (!reg || reg->team != team || !visited.insert(reg.index()).second)
+				continue;
+			const Spread::List& list = survey.list;
+			int power = survey.power;
 
 			// dummy skill state
-			SkillState skill_state = { .map = &map, .region = &reg };
+			SkillState skill_state = { .map = &map };
 
 			// buy a new farm
-			if (reg.money > logic::build_cost(Build::Farm, reg)) {
+			if (!out() && reg->money > logic::build_cost(Build::Farm, *reg)) {
 				// increase chance if low income
-				float bias = 4.f / reg.income;
-				if (Random::chance(bias + diff * 0.25f)) {
+				float bias = 4.f / reg->income;
+				if (map.random.chance(bias + diff * 0.25f)) {
 					// find an empty spot
-					Spread spr = {
-						.hop = [=](const Spread::Tile& tile)
-							{ return tile.hex->solid() && tile.hex->team == team; },
-						.pass = [=](const Spread::Tile& tile)
-							{ return !tile.hex->entity(); },
-						.imm = true
-					};
-					auto emp = spr.applylist(map, pos);
+					auto emp = vacant(survey.emp);
 
 					// get random position
-					auto target = get(emp, [=, &map](sf::Vector2i pos, int& rank) {
-						Hex* hex = map.at(pos);
-
+					const Influence& inf = map.influence();
+					auto target = get(map.random, emp, [=, &inf](sf::Vector2i pos, int& rank) {
 						// rank danger level
-						skillf::checkAround(&map, pos, 2, [=, &rank](const Spread::Tile& tile) {
-							if (tile.hex->team != team && tile.hex->troop)
-								rank -= tile.hex->troop->offense(Access::Query).pts;
-							return false;
-						}, Spread::Alt);
+						rank -= inf.threat(pos, team);
 					}, Spread::Def);
 					if (target) {
 						// place farm
 						Build farm;
 						farm.type = Build::Farm;
 						farm.pos = *target;
-						auto* move = new Moves::EntityPlace(farm, reg);
+						auto* move = new Moves::EntityPlace(farm, *reg);
 						map.executeSkill(move, farm.pos, &SkillList::buy_build);
 					};
 				};
 			};
 
 			// buy a new troop
-			if (!power || Random::chance(reg.income * 10.f / power * diff)) {
+			if (!out() && (!power || map.random.chance(reg->income * 10.f / power * diff))) {
 				// find an empty spot
-				Spread spr = {
-					.hop = [=](const Spread::Tile& tile)
-						{ return tile.hex->solid() && tile.hex->team == team; },
-					.pass = [=](const Spread::Tile& tile)
-						{ return !tile.hex->entity(); },
-					.imm = true
-				};
-				auto emp = spr.applylist(map, pos);
+				auto emp = vacant(survey.emp);
 				if (!emp.empty()) {
 					// pick a unit for reinforcement
 					int unit = Troop::Knight;
 					while (
-						(logic::troop_cost[unit] * 2 > reg.money
-							|| logic::troop_upkeep[unit] * 2 > reg.income)
-						&& unit >= 0
+						unit >= 0 && (logic::troop_cost[unit] * 2 > reg->money
+							|| logic::troop_upkeep[unit] * 2 > reg->income)
 						) unit--;
 
 					// place reinforcement unit
 					if (unit >= 0) {
-						sf::Vector2i pos = emp[Random::u16() % emp.size()];
+						sf::Vector2i pos = emp[map.random.u16() % emp.size()];
 
 						Troop troop;
 						troop.type = static_cast<Troop::Type>(unit);
 						troop.hp = troop.max_hp();
 						troop.pos = pos;
-						auto* move = new Moves::EntityPlace(troop, reg);
+						auto* move = new Moves::EntityPlace(troop, *reg);
 						map.executeSkill(move, troop.pos, &SkillList::buy_troop);
 					};
 				};
@@ -206,31 +318,31 @@ namespace ai {
 
 			// for each entity
 			for (sf::Vector2i pos : list) {
+				// leave remaining entities idle once out of time
+				if (out()) break;
 				Hex* hex = map.at(pos);
 				HexRef ref = { hex, pos };
 
 				// branch on entity type
-				if (hex->troop) {
+				if (hex->troop && troops) {
 					Troop& troop = *hex->troop;
 
 					// ignore troop with a chance
-					if (Random::chance(ui::lerpf(0.2f, 0.f, diff)))
+					if (map.random.chance(ui::lerpf(0.2f, 0.f, diff)))
 						continue;
 
 					// get move positions
+					skill_state.region = &*reg;
 					auto list = select(map, SkillList::move, skill_state, hex, pos);
 
 					// rank move positions
-					auto target = get(list, [=, &map](sf::Vector2i pos, int& rank) {
+					const Influence& inf = map.influence();
+					int own = troop.offense(Access::Query).pts;
+					auto target = get(map.random, list, [=, &map, &inf](sf::Vector2i pos, int& rank) {
 						Hex* now = map.at(pos);
 
 						// add danger level
-						skillf::checkAround(&map, pos, 2, [=, &rank, &troop](const Spread::Tile& tile) {
-							if (tile.hex->team != hex->team && tile.hex->troop)
-								rank += (hex->troop->offense(Access::Query).pts
-									- tile.hex->troop->offense(Access::Query).pts) * 5;
-							return false;
-						}, Spread::Def);
+						rank += (own * inf.enemies(pos, hex->team) - inf.threat(pos, hex->team)) * 5;
 						
 						// add plant bonus
 						if (now->plant) {
@@ -245,12 +357,7 @@ namespace ai {
 							rank += now->team == Region::Unclaimed ? 2 : 1;
 
 							// reward region filling
-							rank += (int)skillf::checkAround(
-								&map, pos, 1,
-								[=](const Spread::Tile& tile)
-									{ return tile.hex->team == hex->team; },
-								Spread::Def
-							) - 1;
+							rank += inf.value(pos, hex->team) - 1;
 
 							// add troop kill bonus
 							if (now->troop) rank += now->troop->type * 2;
@@ -275,10 +382,11 @@ namespace ai {
 						if (troop.type != Troop::Farmer) {
 							// get target list
 							auto skill = logic::troop_skills[troop.type].skills[1];
+							skill_state.region = &*reg;
 							auto list = select(map, *skill, skill_state, hex, pos);
 
 							// rank targets
-							auto target = get(list, [=, &map](sf::Vector2i pos, int& rank) {
+							auto target = get(map.random, list, [=, &map](sf::Vector2i pos, int& rank) {
 								Hex* hex = map.at(pos);
 								Entity* ent = hex->entity();
 
@@ -296,8 +404,8 @@ namespace ai {
 
 					// check if need reinforcements
 					int rank = 0;
-					Spread spread = {
-						.hop = skillf::solidHop,
+					BasicSpread spread = {
+						.hop = skillf::SolidHop(),
 						.pass = [=](const Spread::Tile& tile)
 							{ return (bool)tile.hex->troop; },
 						.effect = [=, &rank](const Spread::Tile& tile) {
@@ -308,30 +416,31 @@ namespace ai {
 						}
 					};
 					spread.apply(map, pos, 2);
-					if (Random::chance(rank / 12.f)) {
+					if (map.random.chance(rank / 12.f)) {
 						// choose reinforcement type
-						if ((rank < 4) ^ Random::chance(ui::lerpf(0.5f, 0.05f, diff))) {
+						if ((rank < 4) ^ map.random.chance(ui::lerpf(0.5f, 0.05f, diff))) {
 							// get random empty spot nearby
-							auto target = empty(map, pos, 1, reg.team);
+							auto target = empty(map, pos, 1, reg->team);
 							if (target) {
 								// place a tower
 								Build build;
 								build.type = Build::Tower;
 								build.hp = build.max_hp();
 								build.pos = *target;
-								auto* move = new Moves::EntityPlace(build, reg);
+								auto* move = new Moves::EntityPlace(build, *reg);
 								map.executeSkill(move, build.pos, &SkillList::buy_build);
 							};
 						}
 						else {
 							// get random empty spot nearby
-							auto target = empty(map, pos, 3, reg.team);
+							auto target = empty(map, pos, 3, reg->team);
 							if (target) {
 								// pick a unit for reinforcement
-								int unit = (int)(rank / 2.f + ui::lerpf(-0.75f, 0.75f, Random::uniform()));
+								int unit = (int)(rank / 2.f + ui::lerpf(-0.75f, 0.75f, map.random.uniform()));
+								unit = std::clamp(unit, 0, Troop::Count - 1);
 								while (
-									(logic::troop_cost[unit] * 2 > reg.money
-										|| logic::troop_upkeep[unit] * 2 > reg.income)
+									(logic::troop_cost[unit] * 2 > reg->money
+										|| logic::troop_upkeep[unit] * 2 > reg->income)
 									&& unit > 0
 									) unit--;
 
@@ -340,29 +449,30 @@ namespace ai {
 								troop.type = static_cast<Troop::Type>(unit);
 								troop.hp = troop.max_hp();
 								troop.pos = *target;
-								auto* move = new Moves::EntityPlace(troop, reg);
+								auto* move = new Moves::EntityPlace(troop, *reg);
 								map.executeSkill(move, troop.pos, &SkillList::buy_troop);
 							};
 						};
 					};
 				}
 				else if (hex->build) {
-					Build& build = *hex->build;
+					// copy, placing new buildings may move the pool storage
+					const Build build = *hex->build;
 
 					// farm logic
 					if (build.type == Build::Farm) {
-						float new_farm = reg.money / (4.f * logic::build_cost(Build::Farm, reg));
+						float new_farm = reg->money / (4.f * logic::build_cost(Build::Farm, *reg));
 
 						// new farm chance
-						if (Random::chance(new_farm * ui::lerpf(0.5f, 1.1f, diff))) {
+						if (map.random.chance(new_farm * ui::lerpf(0.5f, 1.1f, diff))) {
 							// get random empty spot around
-							auto target = empty(map, pos, Random::chance(0.15f) ? 2 : 1, reg.team);
+							auto target = empty(map, pos, map.random.chance(0.15f) ? 2 : 1, reg->team);
 							if (target) {
 								// check if hex is in region
 								Build farm;
 								farm.type = Build::Farm;
 								farm.pos = *target;
-								auto* move = new Moves::EntityPlace(farm, reg);
+								auto* move = new Moves::EntityPlace(farm, *reg);
 								map.executeSkill(move, build.pos, &SkillList::buy_build);
 							};
 						};
@@ -371,6 +481,7 @@ namespace ai {
 					// beacon logic
 					if (build.type == Build::Beacon) {
 						// get enemy troop ranking
+						skill_state.region = &*reg;
 						auto list = select(map, SkillList::stun, skill_state, hex, pos);
 						int rank = 0;
 
@@ -381,9 +492,9 @@ namespace ai {
 						};
 
 						// stun enemies if enough troops
-						if (Random::chance(rank / 15.f)) {
+						if (map.random.chance(rank / 15.f)) {
 							// fail some opportunities
-							if (!Random::chance(ui::lerpf(0.5f, 0.2f, diff))) {
+							if (!map.random.chance(ui::lerpf(0.5f, 0.2f, diff))) {
 								auto* move = SkillList::stun.action(skill_state, map, ref, ref);
 								map.executeSkill(move, build.pos, &SkillList::stun);
 							};
@@ -400,11 +511,11 @@ namespace ai {
 							{ return tile.hex->plant && tile.hex->plant->type != Plant::Grave; },
 						Spread::Def
 					);
-					if (Random::chance(count / 12.f)) {
+					if (map.random.chance(count / 12.f)) {
 						// get random free spot near
-						Spread spread = {
-							.hop = skillf::solidHop,
-							.pass = skillf::emptyPass
+						BasicSpread spread = {
+							.hop = skillf::SolidHop(),
+							.pass = skillf::EmptyPass()
 						};
 						auto list = spread.applylist(map, pos, 1);
 						if (!list.empty()) {
@@ -413,9 +524,7 @@ namespace ai {
 					};
 				};
 			};
-
-
-		});
+		};
 
 		// return empty list lol
 		return {};
@@ -424,7 +533,7 @@ namespace ai {
 	/// Returns a list of all map teams.
 	std::vector<Region::Team> teams(Map& map, Region::Team first) {
 		std::vector<Region::Team> list;
-		Regions::foreach(&map, [first, &list](Region& reg, sf::Vector2i pos) {
+		map.regions.foreach(&map, [first, &list](Region& reg, sf::Vector2i pos) {
 			// ignore unclaimed regions
 			if (reg.team == Region::Unclaimed) return;
 
@@ -0,0 +1,363 @@
+#include "game/bot_ai.hpp"
+#include "ui/units.hpp"
+
+#include "game/logic/troop_logic.hpp"
+#include "game/logic/build_logic.hpp"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+namespace ai {
+	/// Returns settings for a difficulty.
+	SearchConfig SearchConfig::scaled(float diff) {
+		SearchConfig config;
+		config.budget = ui::lerpf(0.005f, 0.2f, diff);
+		config.depth = 1 + (int)(diff * 3.f + 0.5f);
+		return config;
+	};
+
+	/// Adds statistics of another search.
+	void SearchStats::add(const SearchStats& other) {
+		nodes += other.nodes;
+		hits += other.hits;
+		moves += other.moves;
+		depth = std::max(depth, other.depth);
+		time += other.time;
+	};
+
+	/// Constructs an empty table.
+	SearchTable::SearchTable(size_t size) {
+		size_t count = 1;
+		while (count < size) count <<= 1;
+		_entries.resize(count);
+	};
+
+	/// Returns a stored position.
+	const SearchTable::Entry* SearchTable::find(uint64_t key) const {
+		const Entry& entry = _entries[key & (_entries.size() - 1)];
+		return entry.key == key && entry.depth >= 0 ? &entry : nullptr;
+	};
+
+	/// Returns a stored score usable without searching.
+	std::optional<int> SearchTable::cutoff(uint64_t key, int depth, int alpha, int beta) const {
+		const Entry* entry = find(key);
+		if (!entry || entry->depth < depth) return {};
+		if (entry->bound == Exact) return entry->score;
+		if (entry->bound == Lower && entry->score >= beta) return entry->score;
+		if (entry->bound == Upper && entry->score <= alpha) return entry->score;
+		return {};
+	};
+
+	/// Stores a searched position.
+	void SearchTable::store(uint64_t key, int depth, int score, int alpha, int beta, const SearchAction& best) {
+		Entry& entry = _entries[key & (_entries.size() - 1)];
+		entry.key = key;
+		entry.score = score;
+		entry.depth = (int8_t)depth;
+		entry.best = best;
+		entry.bound = score <= alpha ? Upper
+			: score >= beta ? Lower : Exact;
+	};
+
+	/// Single troop skill action.
+	struct _Action : SearchAction {
+		int order = 0; /// Move ordering rank.
+	};
+
+	/// Empty action, stands for ending the turn.
+	static const _Action _pass = {};
+
+	/// Score bound larger than any evaluation.
+	static constexpr int _inf = INT_MAX / 2;
+
+	/// Tile ownership weight.
+	static constexpr int _tile_value = 8;
+
+	/// Key mixed into the map hash when enemies are to move.
+	static constexpr uint64_t _side_key = 0x9E3779B97F4A7C15ULL;
+
+	/// Lookahead search state.
+	class _Search {
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		Map& _map;                    /// Searched map.
+		Region::Team _team;           /// Controlled team.
+		const SearchConfig& _config;  /// Search settings.
+		SearchStats& _stats;          /// Search statistics.
+		SearchTable _table;           /// Transposition table.
+		Clock::time_point _deadline;  /// Search deadline.
+		bool _stop = false;           /// Whether time ran out.
+		bool _timed = false;          /// Whether the deadline is checked.
+
+		/// Checks whether a team acts on a ply.
+		///
+		/// @param team Tile team.
+		/// @param own Whether the controlled team is to move.
+		bool _side(Region::Team team, bool own) const {
+			if (team == Region::Unclaimed) return false;
+			return (team == _team) == own;
+		};
+
+		/// Returns skill state for a tile.
+		///
+		/// @param hex Tile reference.
+		SkillState _state(Hex* hex) {
+			const auto& ref = hex->region();
+			return { .map = &_map, .region = ref ? &*ref : nullptr };
+		};
+
+		/// Returns move ordering rank of an action target.
+		///
+		/// Attacks on valuable entities go first, then captures of enemy tiles.
+		///
+		/// @param team Acting team.
+		/// @param pos Target position.
+		int _rank(Region::Team team, sf::Vector2i pos) {
+			Hex* hex = _map.at(pos);
+			int rank = 0;
+			if (hex->team != team) {
+				rank += hex->team == Region::Unclaimed ? 2 : 4;
+				if (hex->troop) rank += 16 + logic::troop_cost[hex->troop->type];
+				if (hex->build) rank += 16 + logic::build_cost_base[hex->build->type];
+			};
+			return rank;
+		};
+
+		/// Lists all actions of a side.
+		///
+		/// @param own Whether to list actions of the controlled team.
+		std::vector<_Action> _actions(bool own) {
+			std::vector<_Action> list;
+			auto troops = _map.troopList();
+			while (auto* troop = troops.next()) {
+				Hex* hex = _map.at(troop->pos);
+				if (!hex || !_side(hex->team, own)) continue;
+
+				// ignore troops unable to act
+				if (hex->region() && hex->region()->dead) continue;
+				if (troop->hasEffect(EffectType::Stunned)) continue;
+
+				SkillState state = _state(hex);
+				HexRef tile = { hex, troop->pos };
+				const auto& skills = logic::troop_skills[troop->type].skills;
+				for (uint8_t idx = 0; idx < 4; idx++) {
+					const Skill* skill = skills[idx];
+
+					// ignore unusable skills
+					if (!skill || skill->format == Skill::DoubleAim)
+						continue;
+					if (troop->timers[idx] || !Skills::ticked(troop->skill_at(idx), troop->effectList()))
+						continue;
+					if (!skill->condition(state, _map, tile))
+						continue;
+
+					// self skills target the troop itself
+					if (skill->format == Skill::Self) {
+						list.push_back({ { troop->pos, troop->pos, idx }, 1 });
+						continue;
+					};
+
+					// aimed skills target every selected tile
+					for (sf::Vector2i pos : select(_map, *skill, state, hex, troop->pos))
+						list.push_back({ { troop->pos, pos, idx }, _rank(hex->team, pos) });
+				};
+			};
+			return list;
+		};
+
+		/// Applies an action in place.
+		///
+		/// @param action Applied action.
+		///
+		/// @return Applied move (`null` if the skill did nothing).
+		std::unique_ptr<Move> _make(const _Action& action) {
+			HexRef prev = _map.atref(action.from);
+			HexRef next = _map.atref(action.to);
+			const Skill* skill = logic::troop_skills[prev.hex->troop->type].skills[action.skill];
+
+			// create move same as map would
+			std::unique_ptr<Move> move(skill->action(_state(prev.hex), _map, prev, next));
+			if (!move) return nullptr;
+			move->skill_pos = action.from;
+			move->skill_type = skill->type;
+			move->skill_cooldown = skill->cooldown;
+			move->apply(&_map);
+			return move;
+		};
+
+		/// Scores the map from the controlled team's point of view.
+		///
+		/// Counts owned tiles and remaining entity value,
+		/// enemy holdings are averaged over all enemy teams.
+		int _evaluate() {
+			// count enemy teams
+			int enemies = 0;
+			int foreign = 0;
+			for (int t = 1; t < Region::Count; t++) {
+				if (t == _team) continue;
+				if (size_t count = _map.tiles(static_cast<Region::Team>(t))) {
+					foreign += (int)count;
+					enemies++;
+				};
+			};
+			enemies = std::max(enemies, 1);
+
+			// score tiles
+			int own = (int)_map.tiles(_team) * _tile_value;
+			int other = foreign * _tile_value;
+
+			// adds entity value scaled by remaining health
+			auto add = [&](const Entity& ent, int cost) {
+				int value = cost * ent.hp / std::max(ent.max_hp(), 1);
+				Region::Team team = _map.at(ent.pos)->team;
+				if (team == _team) own += value;
+				else if (team != Region::Unclaimed) other += value;
+			};
+
+			// score troops & buildings
+			auto troops = _map.troopList();
+			while (auto* troop = troops.next())
+				add(*troop, logic::troop_cost[troop->type]);
+			auto builds = _map.buildList();
+			while (auto* build = builds.next())
+				add(*build, logic::build_cost_base[build->type]);
+			return own - other / enemies;
+		};
+
+		/// Searches a position with alpha-beta pruning.
+		///
+		/// Passing is always allowed, so a side can keep the current score.
+		///
+		/// @param depth Remaining depth.
+		/// @param alpha Lower score bound.
+		/// @param beta Upper score bound.
+		/// @param own Whether the controlled team is to move.
+		/// @param best Best action output (optional).
+		///
+		/// @return Position score from the moving side's point of view.
+		int _negamax(int depth, int alpha, int beta, bool own, _Action* best = nullptr) {
+			// check time every few nodes
+			_stats.nodes++;
+			if (_timed && (_stats.nodes & 0xFF) == 0 && Clock::now() > _deadline)
+				_stop = true;
+			if (_stop) return 0;
+
+			// stand pat score
+			int stand = own ? _evaluate() : -_evaluate();
+			if (depth <= 0) return stand;
+
+			// probe transposition table
+			uint64_t key = _map.hash() ^ (own ? 0 : _side_key);
+			SearchAction hint = _pass;
+			if (const auto* entry = _table.find(key)) {
+				_stats.hits++;
+				hint = entry->best;
+				if (!best)
+					if (auto score = _table.cutoff(key, depth, alpha, beta))
+						return *score;
+			};
+
+			// order actions, stored best action first
+			auto list = _actions(own);
+			for (_Action& action : list) {
+				if (action == hint) action.order = INT_MAX;
+			};
+			std::stable_sort(list.begin(), list.end(), [](const _Action& a, const _Action& b) {
+				return a.order > b.order;
+			});
+
+			// search every action
+			int origin = alpha;
+			int score = stand;
+			_Action choice = _pass;
+			alpha = std::max(alpha, stand);
+			if (alpha < beta) {
+				for (const _Action& action : list) {
+					auto move = _make(action);
+					if (!move) continue;
+					int now = -_negamax(depth - 1, -beta, -alpha, !own);
+					move->revert(&_map);
+					if (_stop) return 0;
+
+					if (now > score) {
+						score = now;
+						choice = action;
+					};
+					alpha = std::max(alpha, now);
+					if (alpha >= beta) break;
+				};
+			};
+
+			// store result
+			_table.store(key, depth, score, origin, beta, choice);
+			if (best) *best = choice;
+			return score;
+		};
+
+	public:
+		/// Constructs search state.
+		///
+		/// @param map Searched map.
+		/// @param team Controlled team.
+		/// @param config Search settings.
+		/// @param stats Search statistics.
+		_Search(Map& map, Region::Team team, const SearchConfig& config, SearchStats& stats)
+			: _map(map), _team(team), _config(config), _stats(stats), _table(config.table) {};
+
+		/// Finds the best action within a time budget.
+		///
+		/// @param budget Time budget (in seconds).
+		///
+		/// @return Best action of the deepest completed iteration.
+		_Action best(double budget) {
+			_deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+				std::chrono::duration<double>(budget));
+			_stop = false;
+
+			// deepen until out of time, first iteration always completes
+			_Action best = _pass;
+			for (int depth = 1; depth <= _config.depth; depth++) {
+				_timed = depth > 1;
+				_Action now = _pass;
+				_negamax(depth, -_inf, _inf, true, &now);
+				if (_stop) break;
+				best = now;
+				_stats.depth = std::max(_stats.depth, depth);
+			};
+			return best;
+		};
+	};
+
+	/// Executes troop actions for a team using a lookahead search.
+	void search(Map& map, Region::Team team, const SearchConfig& config, SearchStats* stats) {
+		SearchStats local;
+		SearchStats& out = stats ? *stats : local;
+		auto start = std::chrono::steady_clock::now();
+		auto spent = [&]() {
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		};
+
+		_Search search(map, team, config, out);
+		for (size_t i = 0; i < config.moves; i++) {
+			// split remaining time between upcoming actions
+			double left = config.budget - spent();
+			if (left <= 0) break;
+
+			// search must not affect randomness of the game
+			Random::Generator random = map.random;
+			_Action action = search.best(left / 4);
+			map.random = random;
+			if (action.empty()) break;
+
+			// execute chosen action
+			HexRef prev = map.atref(action.from);
+			HexRef next = map.atref(action.to);
+			const Skill* skill = logic::troop_skills[prev.hex->troop->type].skills[action.skill];
+			SkillState state = { .map = &map, .region = prev.hex->region() ? &*prev.hex->region() : nullptr };
+			map.executeSkill(skill->action(state, map, prev, next), action.from, skill);
+			out.moves++;
+		};
+		out.time += spent();
+	};
+};
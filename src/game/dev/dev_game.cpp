@@ -187,7 +187,8 @@ namespace dev {
 				.title = "dp.hex.title",
 				.kv = {
 					"dp.hex.general",
-					"dp.hex.ids"
+					"dp.hex.ids",
+					"dp.hex.influence"
 				}
 			};
 			auto* sec = panel->push([=]() {
@@ -203,13 +204,20 @@ namespace dev {
 			sec->attach([=]() {
 				if (!tile.hex) return;
 
+				// get influence on the tile
+				const Influence& inf = game->map.influence();
+				Region::Team team = tile.hex->team;
+
 				// set arguments
 				sec->args = {
 					{ "pos", ext::str_vec(tile.pos) },
 					{ "team", Values::hex_names[tile.hex->team] },
 					{ "select_id", ext::str_int(tile.hex->selected) },
-					{ "spread_0", ext::str_int(tile.hex->spread[0]) },
-					{ "spread_1", ext::str_int(tile.hex->spread[1]) },
+					{ "spread_0", ext::str_int(game->map.mark(tile.pos, Spread::Def)) },
+					{ "spread_1", ext::str_int(game->map.mark(tile.pos, Spread::Alt)) },
+					{ "threat", ext::str_int(inf.threat(tile.pos, team)) },
+					{ "defense", ext::str_int(inf.defense(tile.pos, team)) },
+					{ "value", ext::str_int(inf.value(tile.pos, team)) },
 				};
 			});
 		};
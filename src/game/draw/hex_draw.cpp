@@ -35,23 +35,7 @@ namespace Draw {
 
 		// border index
 		// each bit corresponds to a border
-		uint8_t border = 0;
-
-		// set every border if selected
-		if (hex->elevated()) {
-			border = 0x3F;
-		}
-
-		// check neighbors
-		else for (int i = 0; i < 6; i++) {
-			// fetch neighbor hex
-			sf::Vector2i pos = map->neighbor(coords, static_cast<Map::nbi_t>(i));
-			const Hex* nb = map->at(pos);
-
-			// set border if passes check
-			if (!nb || nb->type != Hex::Ground || nb->team != hex->team || nb->elevated())
-				border |= 1 << i;
-		};
+		uint8_t border = map->edges(coords) & Draw::MapMesh::BorderMask;
 
 		// ignore if no borders
 		if (!border) return;
@@ -70,9 +54,7 @@ namespace Draw {
 	/// Draws tile sides.
 	void Tile::drawSides(ui::RenderBuffer& target, sf::Color up, sf::Color low) const {
 		// check if any side can be seen
-		const Hex* n2 = map->at(map->neighbor(coords, Map::LowerRight));
-		const Hex* n3 = map->at(map->neighbor(coords, Map::LowerLeft));
-		bool visible = hex->elevated() || (!n2 || !n2->solid()) || (!n3 || !n3->solid());
+		bool visible = map->edges(coords) & Draw::MapMesh::SideMask;
 
 		// draw border if visible
 		if (visible) {
@@ -121,19 +103,17 @@ namespace Draw {
 			text.setOutlineThickness(2);
 
 			// draw index
-			target.text(text);
-			target.forward(nullptr);
+			target.glyphs(text);
 		};
 		// spread index text
 		if (flags::spread) {
-			std::string label = std::format("{}/{}", hex->spread[0], hex->spread[1]);
+			std::string label = std::format("{}/{}", map->mark(coords, Spread::Def), map->mark(coords, Spread::Alt));
 			sf::Text text(assets::font, label, 20);
 			text.setPosition((sf::Vector2f)origin + sf::Vector2f(size.x * 3.f / 4, size.y / 2.f + 22));
 			text.setOutlineThickness(2);
 
 			// draw index
-			target.text(text);
-			target.forward(nullptr);
+			target.glyphs(text);
 		};
 	};
 
@@ -0,0 +1,210 @@
+#include "game/draw/map_mesh.hpp"
+#include "game/map.hpp"
+#include "game/values/hex_values.hpp"
+#include <algorithm>
+
+namespace Draw {
+	/// Computes edge mask of a tile.
+	///
+	/// @param map Map reference.
+	/// @param pos Tile position.
+	/// @param hex Tile reference.
+	static uint8_t edgeMask(const Map& map, sf::Vector2i pos, const Hex& hex) {
+		// elevated tiles show every edge
+		if (hex.elevated())
+			return MapMesh::BorderMask | MapMesh::SideMask;
+
+		// borders towards other teams & non-ground or elevated tiles
+		uint8_t mask = 0;
+		if (hex.type == Hex::Ground) {
+			for (int i = 0; i < 6; i++) {
+				const Hex* nb = map.at(map.neighbor(pos, static_cast<Map::nbi_t>(i)));
+				if (!nb || nb->type != Hex::Ground || nb->team != hex.team || nb->elevated())
+					mask |= 1 << i;
+			};
+		};
+
+		// sides are seen if any lower neighbor is not solid
+		const Hex* n2 = map.at(map.neighbor(pos, Map::LowerRight));
+		const Hex* n3 = map.at(map.neighbor(pos, Map::LowerLeft));
+		if (!n2 || !n2->solid() || !n3 || !n3->solid())
+			mask |= MapMesh::SideMask;
+		return mask;
+	};
+
+	/// Drops all cached geometry.
+	void MapMesh::clear() {
+		_size = {};
+		_row = 0;
+		_segments.clear();
+		_lifted.clear();
+		_edges.clear();
+		_changed.clear();
+		_remask = true;
+	};
+
+	/// Marks every segment as changed.
+	void MapMesh::invalidate() {
+		for (auto& seg : _segments) {
+			for (bool& stale : seg.stale)
+				stale = true;
+		};
+	};
+
+	/// Marks every segment and edge mask as changed.
+	void MapMesh::reset() {
+		invalidate();
+		_changed.clear();
+		_remask = true;
+	};
+
+	/// Marks segments & edge masks of a tile and its neighbors as changed.
+	void MapMesh::touch(sf::Vector2i pos) {
+		if (_segments.empty()) return;
+
+		// remask everything once most tiles are stale
+		if (!_remask) {
+			_changed.push_back(pos);
+			if (_changed.size() > _edges.size() / 8) {
+				_changed.clear();
+				_remask = true;
+			};
+		};
+
+		// neighbors are within a row and a column around
+		int x0 = std::max(pos.x - 1, 0) / Width;
+		int x1 = std::min(pos.x + 1, _size.x - 1) / Width;
+		for (int y = std::max(pos.y - 1, 0); y <= std::min(pos.y + 1, _size.y - 1); y++) {
+			for (int seg = x0; seg <= x1; seg++) {
+				for (bool& stale : _segments[y * _row + seg].stale)
+					stale = true;
+			};
+		};
+	};
+
+	/// Tracks a tile with animated elevation.
+	void MapMesh::lift(sf::Vector2i pos) {
+		for (const auto& lift : _lifted) {
+			if (lift.pos == pos) return;
+		};
+		_lifted.push_back({ pos });
+	};
+
+	/// Resizes the cache with the map.
+	void MapMesh::resize(const Map& map) {
+		if (map.size() == _size) return;
+		_size = map.size();
+		_row = (_size.x + Width - 1) / Width;
+		_segments.clear();
+		_segments.resize((size_t)_row * _size.y);
+		_edges.assign(map.count(), 0);
+		_changed.clear();
+		_remask = true;
+	};
+
+	/// Recomputes stale edge masks.
+	void MapMesh::remask(const Map& map) {
+		resize(map);
+
+		// recompute every mask
+		if (_remask) {
+			for (int y = 0; y < _size.y; y++) {
+				for (int x = 0; x < _size.x; x++) {
+					if (const Hex* hex = map.at({ x, y }))
+						_edges[map.index({ x, y })] = edgeMask(map, { x, y }, *hex);
+				};
+			};
+			_remask = false;
+			return;
+		};
+
+		// recompute changed tiles & their neighbors
+		for (sf::Vector2i pos : _changed) {
+			if (const Hex* hex = map.at(pos))
+				_edges[map.index(pos)] = edgeMask(map, pos, *hex);
+			for (int i = 0; i < 6; i++) {
+				sf::Vector2i nb = map.neighbor(pos, static_cast<Map::nbi_t>(i));
+				if (const Hex* hex = map.at(nb))
+					_edges[map.index(nb)] = edgeMask(map, nb, *hex);
+			};
+		};
+		_changed.clear();
+	};
+
+	/// Prepares segments for drawing.
+	void MapMesh::update(const Map& map) {
+		// resize with the map
+		resize(map);
+
+		// check tracked tiles
+		for (size_t i = 0; i < _lifted.size(); ) {
+			Lift& lift = _lifted[i];
+			const Hex* hex = map.at(lift.pos);
+			bool up = hex && hex->elevated();
+			bool landed = lift.up && !up;
+
+			// rebuild around the tile when it rises or lands
+			if (up != lift.up) {
+				touch(lift.pos);
+				lift.up = up;
+			};
+
+			// stop tracking landed tiles
+			if (!hex || landed) {
+				_lifted[i] = _lifted.back();
+				_lifted.pop_back();
+			}
+			else i++;
+		};
+
+		// refresh edge masks before painting
+		remask(map);
+	};
+
+	/// Returns edge mask of a tile.
+	uint8_t MapMesh::edges(const Map& map, sf::Vector2i pos) {
+		if (_remask || !_changed.empty() || map.size() != _size)
+			remask(map);
+		return _edges[map.index(pos)];
+	};
+
+	/// Returns a list of elevated tiles drawn on top in the current frame.
+	std::vector<sf::Vector2i>& MapMesh::elevated() {
+		return _raised;
+	};
+
+	/// Checks whether a segment has to be drawn live.
+	bool MapMesh::live(int y, int seg) const {
+		for (const auto& lift : _lifted) {
+			if (lift.up && lift.pos.y == y && lift.pos.x / Width == seg)
+				return true;
+		};
+		return false;
+	};
+
+	/// Appends segment geometry, rebuilding it if needed.
+	void MapMesh::append(
+		ui::RenderBuffer& target, Layer layer,
+		int y, int seg, sf::Vector2i offset,
+		const Painter& paint
+	) {
+		Segment& now = _segments[(size_t)y * _row + seg];
+		bool rebuild = now.stale[layer];
+
+		// redraw segment tiles in map space
+		if (rebuild) {
+			_scratch.clear();
+			int x1 = std::min((seg + 1) * Width, _size.x);
+			for (int x = seg * Width; x < x1; x++) {
+				sf::Vector2i coords = { x, y };
+				paint(_scratch, coords, Values::rowOffset(y) + coords.componentWiseMul(Values::tileOff));
+			};
+
+			auto vertices = _scratch.vertices();
+			now.layers[layer].assign(vertices.begin(), vertices.end());
+			now.stale[layer] = false;
+		};
+
+		target.cached(now.layers[layer], sf::Vector2f(offset), rebuild);
+	};
+};
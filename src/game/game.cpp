@@ -239,6 +239,7 @@ Game::Game(ui::Layer* game_layer, ui::Layer* ui_layer, ui::Layer* chat_layer, Ga
 
 		// set map camera position
 		map.camera = (sf::IntRect)_camera.view(ui::window.size());
+		map.zoom = _camera.zoom();
 	});
 
 	// deselect when clicking on the panel
@@ -308,6 +309,7 @@ void Game::selectTile(sf::Vector2i pos) {
 			ui::Anim* anim = ui::AnimFloat::to(&hex->elevation, 1.f, sf::seconds(0.15f));
 			anim->ease = ui::Easings::sineIn;
 			push(anim);
+			map.lift(pos);
 		};
 	};
 
@@ -1,4 +1,5 @@
 #include "game/hex.hpp"
+#include "game/zobrist.hpp"
 
 /// Returns hex base.
 HexBase HexBase::base() const {
@@ -6,9 +7,9 @@ HexBase HexBase::base() const {
 };
 
 /// Adds the tile to the region.
-void Hex::join(Regions::Ref ref) {
+void Hex::join(Regions::Ref ref, sf::Vector2i pos) {
 	// leave previous region
-	leave();
+	leave(pos);
 
 	// join new region
 	_region = ref;
@@ -16,6 +17,7 @@ void Hex::join(Regions::Ref ref) {
 		// update tile count
 		_region->tiles++;
 		_region->income++;
+		_region->members ^= Zobrist::member(pos);
 
 		// update farm count
 		if (build && build->type == Build::Farm)
@@ -28,11 +30,12 @@ void Hex::join(Regions::Ref ref) {
 };
 
 /// Removes the tile from the region.
-void Hex::leave() {
-	if (_region) {
+void Hex::leave(sf::Vector2i pos) {
+	if (region()) {
 		// update tile count
 		_region->tiles--;
 		_region->income--;
+		_region->members ^= Zobrist::member(pos);
 
 		// update farm count
 		if (build && build->type == Build::Farm)
@@ -49,6 +52,9 @@ void Hex::leave() {
 
 /// Returns current tile region.
 const Regions::Ref& Hex::region() const {
+	// follow merge links
+	if (_region && _region->link)
+		[[unlikely]] _region = Regions::root(_region);
 	return _region;
 };
 
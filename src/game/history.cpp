@@ -1,71 +1,122 @@
 #include "game/history.hpp"
+#include "game/serialize/moves.hpp"
+#include <iostream>
 
 /// Constructs move history for a game map.
 History::History(Map* map) : _map(map) {};
 
+/// Logs a done move with its applied state.
+void History::_push(const Move* move) {
+	_done.push(move);
+	_starts.push_back((uint32_t)_state.size());
+	Serialize::ByteWriter writer(_state);
+	Serialize::encodeApplied(writer, move);
+};
+
+/// Decodes the last done move with its applied state.
+std::unique_ptr<Move> History::_top() const {
+	size_t idx = _done.size() - 1;
+	auto move = _done.decode(idx);
+	if (!move) return {};
+
+	// restore state saved when the move was applied
+	Serialize::ByteReader reader(_state.data() + _starts[idx], _state.size() - _starts[idx]);
+	if (!Serialize::decodeApplied(reader, move.get())) return {};
+	return move;
+};
+
 /// Clears the history.
 void History::clear() {
-	_list.clear();
-	_cursor = {};
+	_done.clear();
+	_undone.clear();
+	_state.clear();
+	_starts.clear();
 };
 
 /// Adds a new move to history.
 void History::add(Move* move) {
 	// erase reverted moves
-	if (_cursor < _list.size())
-		_list.erase(_list.begin() + _cursor, _list.end());
+	_undone.clear();
 
-	// store and apply new move
-	_list.push_back(std::unique_ptr<Move>(move));
-	redo();
+	// apply and store new move
+	std::unique_ptr<Move> owned(move);
+	owned->apply(_map);
+	_push(owned.get());
 };
 
 /// Undoes the last move.
 std::optional<sf::Vector2i> History::undo() {
 	// ignore if first move
-	if (_cursor == 0) return {};
+	if (_done.size() == 0) return {};
+
+	// decode current move
+	auto move = _top();
+	if (!move) {
+		std::cerr << "[ERROR] Failed to decode a move from history." << std::endl;
+		return {};
+	};
 
 	// undo current move
-	Move* move = _list[--_cursor].get();
 	move->revert(_map);
+	_undone.push(_done, _done.size() - 1);
+	_done.pop();
+	_state.resize(_starts.back());
+	_starts.pop_back();
 	return move->revertCursor();
 };
 
 /// Redoes the last move.
 std::optional<sf::Vector2i> History::redo() {
 	// ignore if last move
-	if (_cursor >= _list.size()) return {};
+	if (_undone.size() == 0) return {};
+
+	// decode current move
+	auto move = _undone.decode(_undone.size() - 1);
+	if (!move) {
+		std::cerr << "[ERROR] Failed to decode a move from history." << std::endl;
+		return {};
+	};
 
 	// redo current move
-	Move* move = _list[_cursor++].get();
 	move->apply(_map);
+	_undone.pop();
+	_push(move.get());
 	return move->applyCursor();
 };
 
-/// Returns a list of applied moves.
-History::SpanList History::list() const {
-	return SpanList(_list.begin(), _list.begin() + _cursor);
+/// Returns a log of applied moves.
+const MoveLog& History::log() const {
+	return _done;
+};
+
+/// Takes out all applied moves.
+MoveLog History::release() {
+	MoveLog log = std::move(_done);
+	clear();
+	return log;
 };
 
 /// Returns amount of moves done & reverted. 
 std::pair<size_t, size_t> History::count() const {
-	return std::make_pair(_cursor, _list.size() - _cursor);
+	return std::make_pair(_done.size(), _undone.size());
 };
 
 /// Returns last move.
 const Move* History::last() const {
 	// ignore if no moves
-	if (_list.empty() || _cursor == 0) return nullptr;
+	if (_done.size() == 0) return nullptr;
 
-	// return last move
-	return _list[_cursor - 1].get();
+	// decode last move
+	_shown[0] = _top();
+	return _shown[0].get();
 };
 
 /// Returns next move.
 const Move* History::next() const {
 	// ignore if no moves
-	if (_cursor >= _list.size()) return nullptr;
+	if (_undone.size() == 0) return nullptr;
 
-	// return next move
-	return _list[_cursor].get();
-};
\ No newline at end of file
+	// decode next move
+	_shown[1] = _undone.decode(_undone.size() - 1);
+	return _shown[1].get();
+};
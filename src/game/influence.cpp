@@ -0,0 +1,116 @@
+#include "game/influence.hpp"
+#include "game/radius.hpp"
+#include "flags.hpp"
+#include <iostream>
+
+/// Returns contribution of a tile.
+Influence::Source Influence::source(const Hex& hex) {
+	Source src = { .team = hex.team };
+	if (hex.troop) {
+		src.troop = true;
+		src.power = hex.troop->offense(Access::Query).pts;
+	};
+	return src;
+};
+
+/// Adds or removes a tile contribution.
+void Influence::scatter(const HexArray& array, sf::Vector2i pos, const Source& src, int sign) {
+	// tile ownership reaches direct neighbors
+	auto& team = _teams[src.team];
+	Radius::each(array, pos, 1, [&](const Spread::Tile& tile) {
+		team[array.index(tile.pos)].tiles += sign;
+	});
+
+	// troops reach further
+	if (!src.troop) return;
+	Radius::each(array, pos, reach, [&](const Spread::Tile& tile) {
+		size_t idx = array.index(tile.pos);
+		team[idx].power += sign * src.power;
+		team[idx].troops += sign;
+		_total[idx].power += sign * src.power;
+		_total[idx].troops += sign;
+	});
+};
+
+/// Drops the fields.
+void Influence::clear() {
+	for (auto& field : _teams)
+		field.clear();
+	_total.clear();
+	_sources.clear();
+	_dirty.clear();
+	_width = 0;
+	_active = false;
+};
+
+/// Builds all fields from scratch.
+void Influence::build(const HexArray& array) {
+	// reset fields
+	for (auto& field : _teams)
+		field.assign(array.count(), {});
+	_total.assign(array.count(), {});
+	_sources.assign(array.count(), {});
+	_dirty.clear();
+	_width = array.size().x;
+	_active = true;
+
+	// scatter every tile
+	for (int y = 0; y < array.size().y; y++) {
+		for (int x = 0; x < array.size().x; x++) {
+			Hex* hex = array.at({ x, y });
+			if (!hex) continue;
+
+			size_t idx = array.index({ x, y });
+			_sources[idx] = source(*hex);
+			scatter(array, { x, y }, _sources[idx], 1);
+		};
+	};
+};
+
+/// Brings the fields up to date.
+void Influence::update(const HexArray& array) {
+	// rebuild if not built or the array has been resized
+	if (!_active || _sources.size() != array.count() || _width != array.size().x) {
+		build(array);
+		return;
+	};
+
+	// ignore if nothing changed
+	if (_dirty.empty()) return;
+
+	// recount changed tiles
+	for (size_t idx : _dirty) {
+		sf::Vector2i pos = { (int)(idx % _width), (int)(idx / _width) };
+		Hex* hex = array.at(pos);
+		if (!hex) continue;
+
+		Source src = source(*hex);
+		if (src == _sources[idx]) continue;
+
+		// move tile contribution
+		scatter(array, pos, _sources[idx], -1);
+		scatter(array, pos, src, 1);
+		_sources[idx] = src;
+	};
+	_dirty.clear();
+
+	// cross-validate against a full rebuild
+	if (flags::verify) {
+		Influence full;
+		full.build(array);
+		bool valid = true;
+		for (size_t i = 0; i < _total.size() && valid; i++) {
+			valid &= _total[i].power == full._total[i].power
+				&& _total[i].troops == full._total[i].troops;
+			for (int t = 0; t < Region::Count; t++) {
+				valid &= _teams[t][i].power == full._teams[t][i].power
+					&& _teams[t][i].troops == full._teams[t][i].troops
+					&& _teams[t][i].tiles == full._teams[t][i].tiles;
+			};
+		};
+		if (!valid) {
+			std::cerr << "[ERROR] Influence field mismatch" << std::endl;
+			*this = std::move(full);
+		};
+	};
+};
@@ -1,5 +1,6 @@
 #include "game/loader.hpp"
 #include "game/serialize/map.hpp"
+#include "mapped.hpp"
 #include <fstream>
 #include <format>
 
@@ -21,30 +22,43 @@ std::optional<Loader::File> Loader::load(fs::path path) {
 			name = name.substr(0, last);
 	};
 
-	// open file
-	std::ifstream str(path, std::ios::binary);
-	if (!str) {
+	// map file into memory
+	MappedFile file;
+	if (!file.open(path)) {
 		fprintf(stderr, "[Loader] failed to open map file <%s>\n", name.c_str());
 		return {};
 	};
 
-	// read file contents
-	std::vector<char> buffer = std::vector<char>(
-		std::istreambuf_iterator<char>(str),
-		std::istreambuf_iterator<char>()
-	);
-	str.close();
+	// decode chunked map file in place
+	if (MapFormat::View::recognize(file.data(), file.size())) {
+		MapFormat::View view;
+		if (!view.open(file.data(), file.size())) {
+			fprintf(stderr, "[Loader] corrupted or unsupported map file <%s>\n", name.c_str());
+			return {};
+		};
+
+		auto temp = Serialize::decodeMapFile(view);
+		if (!temp) {
+			fprintf(stderr, "[Loader] malformed map data in <%s>\n", name.c_str());
+			return {};
+		};
+		return File{ name, std::move(*temp) };
+	};
 
-	// deserialize file data
-	sf::Packet packet;
-	packet.append(buffer.data(), buffer.size());
-	if (!Serialize::decodeSignature(packet)) {
+	// deserialize legacy file data in place
+	Serialize::ByteReader reader(file.data(), file.size());
+	if (!Serialize::decodeSignature(reader)) {
 		fprintf(stderr, "[Loader] signature check failed for <%s>\n", name.c_str());
 		return {};
 	};
 
 	// return map data
-	return File{ name, Serialize::from<Template>(packet) };
+	auto temp = Serialize::from<Template>(reader);
+	if (!reader) {
+		fprintf(stderr, "[Loader] malformed map data in <%s>\n", name.c_str());
+		return {};
+	};
+	return File{ name, std::move(temp) };
 };
 
 /// Saves a map to a file.
@@ -61,13 +75,10 @@ bool Loader::save(const File& file) {
 	if (str.fail()) return false;
 
 	// serialize template
-	using namespace Serialize;
-	sf::Packet packet;
-	encodeSignature(packet);
-	packet << file.temp;
+	auto data = Serialize::encodeMapFile(file.temp);
 
 	// write to the file
-	str.write((const char*)packet.getData(), packet.getDataSize());
+	str.write((const char*)data.data(), data.size());
 	str.close();
 	return true;
 };
@@ -13,7 +13,7 @@ namespace SkillList {
 				.effect = [&found](const Spread::Tile& tile)
 					{ found = true; }
 			};
-			spread.apply(map, tile.pos, logic::harvest_range);
+			Radius::apply(spread, map, tile.pos, logic::harvest_range);
 			return found;
 		},
 		.select = [](const SkillState&, const HexRef& tile, size_t idx) {
@@ -101,7 +101,7 @@ namespace SkillList {
 			// get heal cost
 			int cost = 0;
 			auto spread = Moves::troopHealCost(logic::heal_amount[0], tile.hex->team, &cost);
-			spread.apply(map, tile.pos, logic::heal_range);
+			Radius::apply(spread, map, tile.pos, logic::heal_range);
 
 			// store new heal cost
 			heal1.cost = [=](const SkillState&) { return cost; };
@@ -132,7 +132,7 @@ namespace SkillList {
 			// get heal cost
 			int cost = 0;
 			auto spread = Moves::troopHealCost(logic::heal_amount[1], tile.hex->team, &cost);
-			spread.apply(map, tile.pos, logic::heal_range);
+			Radius::apply(spread, map, tile.pos, logic::heal_range);
 
 			// store new heal cost
 			heal2.cost = [=](const SkillState&) { return cost; };
@@ -23,19 +23,15 @@ namespace skillf {
 	};
 
 	/// Allows spreading only to solid tiles.
-	const Spread::Check solidHop = [](const Spread::Tile& tile) {
-		return tile.hex->solid();
-	};
+	const Spread::Check solidHop = SolidHop();
 
 	/// Allows selection only if a tile is empty.
-	const Spread::Check emptyPass = [](const Spread::Tile& tile) {
-		return tile.hex->free();
-	};
+	const Spread::Check emptyPass = EmptyPass();
 
 	/// Generates region audit spreader effect function.
 	Spread::Effect regionJoin(const Regions::Ref& ref) {
 		return [&ref](const Spread::Tile& tile) {
-			tile.hex->join(ref);
+			tile.hex->join(ref, tile.pos);
 		};
 	};
 
@@ -46,22 +42,6 @@ namespace skillf {
 		};
 	};
 
-	/// Checks for a test success in a neighborhood.
-	size_t checkAround(Map* map, sf::Vector2i pos, size_t radius, Spread::Check check, bool alt) {
-		size_t counter = 0;
-
-		// create & apply spread
-		Spread spread = {
-			.pass = check,
-			.effect = [&](const Spread::Tile&) { counter++; },
-			.alt = alt
-		};
-		spread.apply(*map, pos, radius);
-
-		// return test stats
-		return counter;
-	};
-
 	/// Checks if a tile is near water.
 	bool nearWater(Map* map, sf::Vector2i pos) {
 		return checkAround(map, pos, 1, [=](const Spread::Tile& nb) {
@@ -1,6 +1,8 @@
 #include "game/logic/turn_logic.hpp"
 #include "game/logic/skill_helper.hpp"
+#include "flags.hpp"
 #include <algorithm>
+#include <iostream>
 
 namespace logic {
 	/// Executes global turn transition logic.
@@ -20,7 +22,7 @@ namespace logic {
 			HexRef tile = map->atref(plant->pos);
 
 			// store initial state
-			auto* move = new Moves::EntityChange(*plant);
+			Plant prev = *plant;
 
 			// spread the plant
 			if (plant->spread_roll(map)) {
@@ -35,7 +37,7 @@ namespace logic {
 				auto tlist = spread.applylist(*map, plant->pos, 1);
 				if (!tlist.empty()) {
 					// select random tile from list
-					sf::Vector2i pos = tlist[rand() % tlist.size()];
+					sf::Vector2i pos = tlist[map->random.u32() % tlist.size()];
 
 					// store new plant info
 					Plant nplant;
@@ -47,9 +49,15 @@ namespace logic {
 
 			// tick plant state
 			plant->tickState(map);
+			map->touch(plant->pos);
 
-			// store new state
+			// ignore unchanged plants
+			if (Moves::same_entity(prev, *plant)) continue;
+
+			// store state change
+			auto* move = new Moves::EntityChange(prev);
 			move->state = *plant;
+			list.push_back(std::unique_ptr<Move>(move));
 		};
 
 		// construct new plants
@@ -72,12 +80,11 @@ namespace logic {
 		History::UniqList list;
 
 		// update all regions
-		Regions::foreach(map, [&, team](Region& reg, sf::Vector2i pos) {
-			if (reg.team != team) return;
-
+		map->regions.foreach(map, team, [&](Region& reg, sf::Vector2i pos) {
 			// record region state change
 			auto* move = new Moves::RegionChange(pos, reg.data());
 			reg.tick();
+			map->regions.touch(map->at(pos)->region());
 			move->state = reg.data();
 
 			// register region change move
@@ -91,10 +98,11 @@ namespace logic {
 			if (tile.hex->team != team) return;
 
 			// store initial state
-			auto* move = new Moves::EntityChange(Moves::store_entity(tile.hex, tile.pos));
+			Moves::EntState prev = Moves::store_entity(tile.hex, tile.pos);
 
 			// tick entity
 			entity->tickState(map);
+			map->touch(entity->pos);
 
 			// check if entity is dead
 			if (entity->dead() || (
@@ -113,14 +121,14 @@ namespace logic {
 			// update plants
 			if (auto* plant = dynamic_cast<Plant*>(entity)) {
 				// grow plants
-				if (rand() % 5 == 0) switch (plant->type) {
+				if (map->random.u32() % 5 == 0) switch (plant->type) {
 					case Plant::Sapling: plant->type = Plant::Tree; break;
 					case Plant::Tree: plant->type = Plant::Peach; break;
 					case Plant::Bush: plant->type = Plant::Berry; break;
 				};
 
 				// spread plants
-				if ((plant->type == Plant::Bush || plant->type == Plant::Berry) && (rand() % 5 == 0)) {
+				if ((plant->type == Plant::Bush || plant->type == Plant::Berry) && (map->random.u32() % 5 == 0)) {
 					// select solid tiles without any entities
 					Spread spread = {
 						.hop = skillf::solidHop,
@@ -132,7 +140,7 @@ namespace logic {
 					auto tlist = spread.applylist(*map, plant->pos, 1);
 					if (!tlist.empty()) {
 						// select random tile from list
-						sf::Vector2i pos = tlist[rand() % tlist.size()];
+						sf::Vector2i pos = tlist[map->random.u32() % tlist.size()];
 
 						// bush creation move
 						auto* move = new Moves::EntityChange(Moves::Empty { .pos = pos });
@@ -149,10 +157,13 @@ namespace logic {
 				};
 			};
 
-			// store new state
-			move->state = Moves::store_entity(tile.hex, tile.pos);
+			// ignore unchanged entities
+			Moves::EntState next = Moves::store_entity(tile.hex, tile.pos);
+			if (Moves::same_entity(prev, next)) return;
 
-			// store move
+			// store state change
+			auto* move = new Moves::EntityChange(std::move(prev));
+			move->state = std::move(next);
 			list.push_back(std::unique_ptr<Move>(move));
 		};
 
@@ -170,9 +181,8 @@ namespace logic {
 		return list;
 	};
 
-	/// Counts tiles for every team.
-	TileCount count(Map* map, const std::vector<Messages::Player>& players) {
-		// create counter list
+	/// Counts tiles for every team by scanning the whole map.
+	TileCount scan(const Map* map) {
 		TileCount count;
 		for (int i = 0; i < Region::Count; i++)
 			count.teams.push_back({ .team = static_cast<Region::Team>(i) });
@@ -180,7 +190,7 @@ namespace logic {
 		// count all solid tiles
 		for (int y = 0; y < map->size().y; y++) {
 			for (int x = 0; x < map->size().x; x++) {
-				Hex* hex = map->at({ x, y });
+				const Hex* hex = map->at({ x, y });
 				if (hex && hex->solid()) {
 					// count total tiles
 					count.total++;
@@ -190,6 +200,33 @@ namespace logic {
 				};
 			};
 		};
+		return count;
+	};
+
+	/// Counts tiles for every team.
+	TileCount count(Map* map, const std::vector<Messages::Player>& players) {
+		// create counter list
+		TileCount count;
+		for (int i = 0; i < Region::Count; i++)
+			count.teams.push_back({ .team = static_cast<Region::Team>(i) });
+
+		// read incremental tile counts
+		count.total = map->tiles();
+		for (auto& info : count.teams)
+			info.tiles = map->tiles(info.team);
+
+		// cross-validate against a full scan
+		if (flags::verify) {
+			TileCount scan = logic::scan(map);
+			bool valid = scan.total == count.total;
+			for (int i = 0; i < Region::Count; i++)
+				valid &= scan.teams[i].tiles == count.teams[i].tiles;
+			if (!valid) {
+				std::cerr << "[ERROR] Tile count mismatch (counted " << count.total
+					<< " tiles, scanned " << scan.total << ")" << std::endl;
+				count = scan;
+			};
+		};
 
 		// find team in player list
 		auto find = [&](Region::Team team) {
@@ -1,5 +1,6 @@
 #include "game/map.hpp"
 #include "game/draw.hpp"
+#include "game/zobrist.hpp"
 #include "flags.hpp"
 
 /// Constructs an empty game map.
@@ -25,7 +26,6 @@ void Map::clear() {
 	HexArray::clear();
 
 	// reset indices
-	Spread::reset();
 	_select_idx = 0;
 
 	// reset other stuff
@@ -33,10 +33,23 @@ void Map::clear() {
 	_selection = false;
 	_region = {};
 	pulse = {};
+
+	// reset hash & tile counts
+	_keys.clear();
+	_teams.clear();
+	_dirty.clear();
+	_hash = 0;
+	_tiles = {};
+	_solid = 0;
+
+	// drop influence fields & cached geometry
+	_influence.clear();
+	_mesh.clear();
 };
 
 /// Generates a new selection index.
 size_t Map::newSelectionIndex() {
+	_mesh.invalidate();
 	_selection = true;
 	return ++_select_idx;
 };
@@ -47,6 +60,7 @@ size_t Map::getSelectionIndex() const {
 
 /// Stops map selection.
 void Map::stopSelection() {
+	if (_selection) _mesh.invalidate();
 	_selection = false;
 };
 /// Checks if a selection is happening.
@@ -56,10 +70,13 @@ bool Map::isSelection() const {
 
 /// Selects a region.
 void Map::selectRegion(const Regions::Ref& region) {
-	if (region) _region = region;
+	if (!region || region == _region) return;
+	_region = region;
+	_mesh.invalidate();
 };
 /// Deselects a region.
 void Map::deselectRegion() {
+	if (_region) _mesh.invalidate();
 	_region = {};
 };
 /// Returns currently selected region.
@@ -73,6 +90,12 @@ Regions::Split Map::updateRegions(
 	const Regions::Ref& prev,
 	const Regions::Split& split
 ) {
+	// selected region highlight follows region links
+	if (_region) _mesh.invalidate();
+
+	// previous region loses the tile
+	regions.touch(prev);
+
 	/// ==== merge ==== ///
 
 	// merged regions list
@@ -118,53 +141,157 @@ Regions::Split Map::updateRegions(
 
 	/// ==== split ==== ///
 
-	// split regions list
-	std::vector<Regions::AccessPoint> splits;
-	std::vector<size_t> indices; // spread indices for each AP
+	// find all separated region parts
+	size_t keep;
+	auto splits = regions.separate(this, tile.pos, prev, keep);
 
-	// find all separated regions
-	for (int i = 0; i < 6; i++) {
-		// get neighbor tile
-		sf::Vector2i pos = neighbor(tile.pos, static_cast<nbi_t>(i));
-		Hex* hex = at(pos);
-		if (!hex) continue;
+	// split regions if needed
+	regions.split(this, splits, split, keep);
 
-		// ignore if not overwritten region
-		if (hex->region() != prev) continue;
+	/// ==== index ==== ///
 
-		// ignore if region has been reached
-		bool found = false;
-		for (size_t idx : indices) {
-			if (hex->spread[Spread::Def] == idx) {
-				found = true;
+	// anchor tile region at the tile
+	regions.anchor(tile.hex->region(), tile.pos);
+
+	// move previous region access point off the tile
+	if (prev && prev != tile.hex->region()) {
+		for (int i = 0; i < 6; i++) {
+			sf::Vector2i pos = neighbor(tile.pos, static_cast<nbi_t>(i));
+			Hex* hex = at(pos);
+			if (hex && hex->region() == prev) {
+				regions.anchor(prev, pos);
 				break;
 			};
 		};
-		if (found) continue;
-
-		// mark all tiles in region
-		Spread spread = {
-			.hop = [&](const Spread::Tile& tile) {
-				return tile.hex->region() == prev;
-			},
-			.imm = true
+	};
+
+	// return merge distribution
+	return dist;
+};
+
+/// Marks a tile as changed.
+void Map::touch(sf::Vector2i pos) {
+	if (!at(pos)) return;
+	_dirty.push_back(index(pos));
+	_influence.touch(index(pos));
+	_mesh.touch(pos);
+};
+
+/// Marks a tile with animated elevation.
+void Map::lift(sf::Vector2i pos) {
+	if (at(pos)) _mesh.lift(pos);
+};
+
+/// Returns edge mask of a tile.
+uint8_t Map::edges(sf::Vector2i pos) const {
+	return _mesh.edges(*this, pos);
+};
+
+/// Returns counted team of a hex.
+///
+/// @param hex Hex reference.
+///
+/// @return `Region::Count` if the hex is not solid.
+static uint8_t counted(const Hex& hex) {
+	return hex.solid() ? (uint8_t)hex.team : (uint8_t)Region::Count;
+};
+
+/// Recomputes the map hash & tile counts from scratch.
+void Map::rehash() {
+	_keys.assign(count(), 0);
+	_teams.assign(count(), Region::Count);
+	_dirty.clear();
+	_mesh.reset();
+	_hash = 0;
+	_tiles = {};
+	_solid = 0;
+
+	// hash & count every tile
+	for (int y = 0; y < size().y; y++) {
+		for (int x = 0; x < size().x; x++) {
+			size_t idx = index({ x, y });
+			const Hex& hex = ats({ x, y });
+			_keys[idx] = Zobrist::tile(idx, hex);
+			_hash ^= _keys[idx];
+
+			_teams[idx] = counted(hex);
+			if (_teams[idx] != Region::Count) {
+				_tiles[_teams[idx]]++;
+				_solid++;
+			};
 		};
-		size_t idx = spread.apply(*this, pos);
+	};
 
-		// store region access point
-		splits.push_back({ &hex->region(), pos});
-		indices.push_back(idx);
+	// hash every region
+	regions.rehash();
+};
+
+/// Updates hash keys & tile counts of changed tiles.
+void Map::update() {
+	// recompute everything if the map has been resized
+	if (_keys.size() != count()) {
+		rehash();
+		return;
 	};
 
-	// split regions if needed
-	regions.split(this, splits, split);
+	for (size_t idx : _dirty) {
+		sf::Vector2i pos = { (int)(idx % size().x), (int)(idx / size().x) };
+		const Hex& hex = ats(pos);
 
-	// return merge distribution
-	return dist;
+		// update tile key
+		_hash ^= _keys[idx];
+		_keys[idx] = Zobrist::tile(idx, hex);
+		_hash ^= _keys[idx];
+
+		// tile changes may change its region
+		regions.touch(hex.region());
+
+		// move tile between team counters
+		uint8_t team = counted(hex);
+		if (team == _teams[idx]) continue;
+		if (_teams[idx] != Region::Count) {
+			_tiles[_teams[idx]]--;
+			_solid--;
+		};
+		if (team != Region::Count) {
+			_tiles[team]++;
+			_solid++;
+		};
+		_teams[idx] = team;
+	};
+	_dirty.clear();
+};
+
+/// Returns Zobrist hash of the map state.
+uint64_t Map::hash() {
+	update();
+	return _hash ^ regions.hash();
+};
+
+/// Returns influence fields of the map.
+const Influence& Map::influence() {
+	_influence.update(*this);
+	return _influence;
+};
+
+/// Returns solid tile count of a team.
+size_t Map::tiles(Region::Team team) {
+	update();
+	return _tiles[team];
+};
+
+/// Returns total solid tile count.
+size_t Map::tiles() {
+	update();
+	return _solid;
 };
 
 /// Removes any entities from the hex.
 void Map::removeEntity(Hex* hex) {
+	// mark entity tile as changed
+	if (Entity* entity = hex->entity())
+		touch(entity->pos);
+
 	// remove troop
 	if (hex->troop) {
 		// update region income
@@ -207,6 +334,7 @@ void Map::setTroop(const Troop& troop) {
 	auto hex = at(troop.pos);
 	if (hex) {
 		removeEntity(hex);
+		touch(troop.pos);
 
 		// add troop
 		hex->troop = _troops.add(troop);
@@ -221,6 +349,7 @@ void Map::setBuild(const Build& build) {
 	auto hex = at(build.pos);
 	if (hex) {
 		removeEntity(hex);
+		touch(build.pos);
 
 		// add building
 		hex->build = _builds.add(build);
@@ -241,6 +370,7 @@ void Map::setPlant(const Plant& plant) {
 	auto hex = at(plant.pos);
 	if (hex) {
 		removeEntity(hex);
+		touch(plant.pos);
 
 		// add plant
 		hex->plant = _plants.add(plant);
@@ -279,6 +409,19 @@ sf::IntRect Map::backplane() const {
 	};
 };
 
+/// Draws a low detail tile run.
+///
+/// Runs cover the tile row band, so rows of runs fill the map without gaps.
+///
+/// @param target Render buffer.
+/// @param origin First tile draw origin.
+/// @param length Run length in tiles.
+/// @param color Run color.
+static void drawRun(ui::RenderBuffer& target, sf::Vector2i origin, int length, sf::Color color) {
+	sf::Vector2i band = { 0, (Values::tileSize.y - Values::tileOff.y) / 2 };
+	target.quad({ origin + band, { length * Values::tileOff.x, Values::tileOff.y } }, {}, color);
+};
+
 /// Draws the map.
 void Map::draw(ui::RenderBuffer& target, float t) const {
 	// draw backplane
@@ -302,37 +445,120 @@ void Map::draw(ui::RenderBuffer& target, float t) const {
 
 	// setup tile drawer
 	TileDrawer drawer(this, area, origin, Values::tileSize);
-	std::deque<Draw::Tile> elevated;
+	auto& elevated = _mesh.elevated();
+	elevated.clear();
+	bool lod = zoom >= lodZoom;
+
+	// low detail run key of a tile (-1 if not drawn)
+	auto runKey = [this](sf::Vector2i coords) {
+		const Hex* hex = at(coords);
+		if (!hex || hex->type == Hex::Void) return -1;
+		if (hex->type != Hex::Ground) return (int)Region::Count;
+		return (int)hex->team + (_region && hex->region() == _region ? (int)Region::Count + 1 : 0);
+	};
 
-	// draw tile geometry
-	while (auto tile = drawer.next()) {
-		if (tile->hex->elevated() && tile->hex->type != Hex::Water) {
-			if (tile->hex->type == Hex::Void)
-				tile->drawVoidSides(target);
-			else
-				tile->drawSides(target, sf::Color::White, sf::Color::Black);
-			elevated.push_back(*tile);
-		}
-		else {
-			tile->drawBase(target);
-			tile->drawSides(target, Draw::white(tile->hex->region() == _region), sf::Color::Black);
-			if (_selection && tile->hex->selected != _select_idx)
-				tile->drawSides(target, Values::dimTint, Values::dimTint);
-		};
+	// tile geometry painters
+	Draw::MapMesh::Painter paint[Draw::MapMesh::Count] = {
+		// tile base & sides
+		[this](ui::RenderBuffer& buffer, sf::Vector2i coords, sf::Vector2i pos) {
+			Draw::Tile tile(this, coords, pos, Values::tileSize);
+			if (!tile.hex) return;
+
+			if (tile.hex->elevated() && tile.hex->type != Hex::Water) {
+				if (tile.hex->type == Hex::Void)
+					tile.drawVoidSides(buffer);
+				else
+					tile.drawSides(buffer, sf::Color::White, sf::Color::Black);
+			}
+			else {
+				tile.drawBase(buffer);
+				tile.drawSides(buffer, Draw::white(tile.hex->region() == _region), sf::Color::Black);
+				if (_selection && tile.hex->selected != _select_idx)
+					tile.drawSides(buffer, Values::dimTint, Values::dimTint);
+			};
+		},
+		// tile borders
+		[this](ui::RenderBuffer& buffer, sf::Vector2i coords, sf::Vector2i pos) {
+			Draw::Tile tile(this, coords, pos, Values::tileSize);
+			if (!tile.hex || tile.hex->elevated()) return;
+			tile.drawBorders(buffer, Draw::white(tile.hex->region() == _region));
+		},
+		// low detail runs, painted from their first tile in the segment
+		[this, &runKey](ui::RenderBuffer& buffer, sf::Vector2i coords, sf::Vector2i pos) {
+			int key = runKey(coords);
+			if (key < 0) return;
+			if (coords.x % Draw::MapMesh::Width && runKey(coords - sf::Vector2i(1, 0)) == key) return;
+
+			// find run end within the segment
+			int end = std::min((coords.x / Draw::MapMesh::Width + 1) * Draw::MapMesh::Width, size().x);
+			int length = 1;
+			while (coords.x + length < end && runKey({ coords.x + length, coords.y }) == key)
+				length++;
+
+			// get run color, selected region is lightened
+			sf::Color color = Values::waterSide;
+			if (key < Region::Count) color = Values::hex_colors[key];
+			if (key > Region::Count) {
+				color = Values::hex_colors[key - Region::Count - 1];
+				color.r += (255 - color.r) / 2;
+				color.g += (255 - color.g) / 2;
+				color.b += (255 - color.b) / 2;
+			};
+			drawRun(buffer, pos, length, color);
+		},
 	};
+	const sf::Texture* textures[Draw::MapMesh::Count] = { &assets::tilemap, &assets::borders, nullptr };
+
+	// get visible segments
+	int x0 = std::max(area.position.x, 0);
+	int x1 = std::min(area.position.x + area.size.x, size().x);
+	int y0 = std::max(area.position.y, 0);
+	int y1 = x0 < x1 ? std::min(area.position.y + area.size.y, size().y) : y0;
+	int s0 = x0 / Draw::MapMesh::Width;
+	int s1 = (x1 - 1) / Draw::MapMesh::Width;
+
+	// draw cached tile geometry, segments with elevated tiles are drawn live
+	_mesh.update(*this);
+	for (int layer = lod ? Draw::MapMesh::Lod : 0; layer < (lod ? Draw::MapMesh::Count : Draw::MapMesh::Lod); layer++) {
+		for (int y = y0; y < y1; y++) {
+			for (int seg = s0; seg <= s1; seg++) {
+				if (lod || !_mesh.live(y, seg)) {
+					_mesh.append(target, (Draw::MapMesh::Layer)layer, y, seg, -camera.position, paint[layer]);
+					target.forward(textures[layer]);
+					continue;
+				};
 
-	// draw borders
-	drawer.reset();
-	while (auto tile = drawer.next()) {
-		if (tile->hex->elevated()) continue;
-		tile->drawBorders(target, Draw::white(tile->hex->region() == _region));
+				int end = std::min((seg + 1) * Draw::MapMesh::Width, size().x);
+				for (int x = seg * Draw::MapMesh::Width; x < end; x++) {
+					auto tile = drawer.at({ x, y }, 1.f);
+					if (!tile.hex) continue;
+					paint[layer](target, tile.coords, tile.origin);
+
+					// remember elevated tiles
+					if (layer == Draw::MapMesh::Ground && tile.hex->elevated() && tile.hex->type != Hex::Water)
+						elevated.push_back(tile.coords);
+				};
+			};
+		};
 	};
 
 	// draw tile contents
 	drawer.reset();
 	while (auto tile = drawer.next()) {
-		if (tile->hex->elevated()) continue;
-		tile->drawContents(target);
+		if (tile->hex->elevated()) {
+			// low detail elevated tiles are picked up here
+			if (lod && tile->hex->type != Hex::Water)
+				elevated.push_back(tile->coords);
+			continue;
+		};
+
+		// low detail tiles only show entity sprites
+		if (lod) {
+			Draw::troopEntity(*tile, target);
+			Draw::buildEntity(*tile, target);
+			Draw::plantEntity(*tile, target);
+		}
+		else tile->drawContents(target);
 		
 		// draw shield if close enough
 		if (shield && distance(*shield, tile->coords) <= logic::defense_range)
@@ -340,7 +566,24 @@ void Map::draw(ui::RenderBuffer& target, float t) const {
 	};
 
 	// draw tile shading
-	if (_selection) {
+	if (_selection && lod) {
+		// shade runs of unselected ground tiles
+		for (int y = y0; y < y1; y++) {
+			int start = -1;
+			for (int x = x0; x <= x1; x++) {
+				const Hex* hex = x < x1 ? at({ x, y }) : nullptr;
+				bool shaded = hex && hex->type == Hex::Ground && !hex->elevated() && hex->selected != _select_idx;
+				if (shaded && start < 0) start = x;
+				if (!shaded && start >= 0) {
+					sf::Vector2i pos = Values::rowOffset(y) + sf::Vector2i(start, y).componentWiseMul(Values::tileOff);
+					drawRun(target, pos - camera.position, x - start, Values::dimTint);
+					start = -1;
+				};
+			};
+		};
+		target.forward(nullptr);
+	}
+	else if (_selection) {
 		drawer.reset();
 		while (auto tile = drawer.next()) {
 			if (tile->hex->elevated()) continue;
@@ -356,7 +599,8 @@ void Map::draw(ui::RenderBuffer& target, float t) const {
 	};
 
 	// draw elevated tile top & contents
-	for (auto& tile : elevated) {
+	for (sf::Vector2i pos : elevated) {
+		auto tile = drawer.at(pos, 1.f);
 		if (tile.hex->type == Hex::Void)
 			tile.drawVoidBase(target);
 		else
@@ -365,7 +609,8 @@ void Map::draw(ui::RenderBuffer& target, float t) const {
 		tile.drawContents(target);
 	};
 
-	// draw entity status
+	// draw entity status, omitted in low detail
+	if (lod) return;
 	drawer.reset();
 	while (auto tile = drawer.next()) {
 		Draw::entityBar(*tile, target);
@@ -0,0 +1,151 @@
+#include "game/move_log.hpp"
+#include "game/serialize/moves.hpp"
+#include <algorithm>
+
+/// Clears the log.
+void MoveLog::clear() {
+	_records.clear();
+	_data.clear();
+};
+
+/// Adds a move to the log.
+void MoveLog::push(const Move* move) {
+	// reserve a single byte size prefix, enough for most moves
+	size_t start = _data.size();
+	_data.push_back(0);
+
+	// encode the move straight into the payload buffer
+	Serialize::ByteWriter writer(_data);
+	Serialize::encodeMove(writer, move);
+	size_t size = writer.size();
+
+	// write size prefix, widened for long moves
+	uint8_t prefix[4];
+	Serialize::ByteWriter head(prefix);
+	Serialize::encodeVar(head, size);
+	if (head.size() > 1)
+		_data.insert(_data.begin() + start + 1, head.size() - 1, 0);
+	std::copy(prefix, prefix + head.size(), _data.begin() + start);
+
+	// store record
+	_records.push_back({
+		.offset = (uint32_t)(start + head.size()),
+		.size = (uint16_t)size,
+		.tag = (uint8_t)move->type(),
+		.cooldown = move->skill_cooldown
+	});
+};
+
+/// Adds a move list to the log.
+void MoveLog::push(SpanList list) {
+	for (const auto& move : list)
+		push(move.get());
+};
+
+/// Copies an encoded move from another log.
+void MoveLog::push(const MoveLog& log, size_t idx) {
+	// copy size prefix & payload as they are
+	const Record& rec = log._records[idx];
+	size_t start = idx ? log._records[idx - 1].offset + log._records[idx - 1].size : 0;
+	size_t prefix = rec.offset - start;
+	_records.push_back(rec);
+	_records.back().offset = (uint32_t)(_data.size() + prefix);
+	_data.insert(_data.end(), log._data.begin() + start, log._data.begin() + rec.offset + rec.size);
+};
+
+/// Copies all encoded moves from another log.
+void MoveLog::push(const MoveLog& log) {
+	size_t base = _data.size();
+	for (Record rec : log._records) {
+		rec.offset += (uint32_t)base;
+		_records.push_back(rec);
+	};
+	_data.insert(_data.end(), log._data.begin(), log._data.end());
+};
+
+/// Drops the last move.
+void MoveLog::pop() {
+	if (_records.empty()) return;
+	_records.pop_back();
+	_data.resize(_records.empty() ? 0 : _records.back().offset + _records.back().size);
+};
+
+/// Returns total log size (in bytes), records included.
+size_t MoveLog::bytes() const {
+	return _records.size() * sizeof(Record) + _data.size();
+};
+
+/// Decodes a single move.
+std::unique_ptr<Move> MoveLog::decode(size_t idx) const {
+	const Record& rec = _records[idx];
+	Serialize::ByteReader reader(_data.data() + rec.offset, rec.size);
+	auto move = Serialize::decodeMove(reader);
+
+	// move fields must fill the whole payload
+	if (!reader.end()) return {};
+	return move;
+};
+
+/// Decodes all moves.
+MoveLog::UniqList MoveLog::decode() const {
+	UniqList list;
+	list.reserve(_records.size());
+	for (size_t i = 0; i < _records.size(); i++)
+		list.push_back(decode(i));
+	return list;
+};
+
+/// Applies all moves to a map in log order.
+MoveLog::UniqList MoveLog::apply(Map* map) const {
+	UniqList list = decode();
+	for (const auto& move : list) {
+		if (move) move->apply(map);
+	};
+	return list;
+};
+
+/// Writes the log.
+void MoveLog::write(Serialize::ByteWriter& writer) const {
+	writer << (uint32_t)_records.size();
+	writer.write(_data.data(), _data.size());
+};
+
+/// Reads a move list and adds it to the log.
+bool MoveLog::read(Serialize::ByteReader& reader) {
+	// log size to roll back to
+	size_t records = _records.size();
+	size_t data = _data.size();
+	auto fail = [&]() {
+		_records.resize(records);
+		_data.resize(data);
+		return false;
+	};
+
+	uint32_t count = 0;
+	if (!(reader >> count)) return false;
+
+	for (uint32_t i = 0; i < count; i++) {
+		// find move boundaries from the size prefix
+		size_t start = reader.position();
+		size_t size = (size_t)Serialize::decodeVar(reader);
+		size_t offset = reader.position() - start;
+		const uint8_t* bytes = size <= UINT16_MAX ? reader.take(size) : nullptr;
+		if (!bytes || !reader) return fail();
+
+		// check move header only
+		uint8_t cooldown = 0;
+		Serialize::ByteReader head(bytes, size);
+		auto tag = Serialize::peekMove(head, cooldown);
+		if (tag == Serialize::M_Count) return fail();
+
+		// copy encoded bytes as they are
+		_records.push_back({
+			.offset = (uint32_t)(_data.size() + offset),
+			.size = (uint16_t)size,
+			.tag = (uint8_t)tag,
+			.cooldown = cooldown
+		});
+		_data.insert(_data.end(), reader.data() + start, bytes + size);
+	};
+	return true;
+};
\ No newline at end of file
@@ -20,6 +20,7 @@ namespace Moves {
 
 		// apply effect to entity
 		e->addEffect(effect);
+		map->touch(pos);
 
 		// subtract effect cost
 		if (hex->region())
@@ -39,6 +40,7 @@ namespace Moves {
 
 		// remove effect from entity
 		e->removeEffect(effect);
+		map->touch(pos);
 
 		// add effect cost
 		if (hex->region())
@@ -32,12 +32,12 @@ namespace Moves {
 
 	/// Constructs a region change move.
 	RegionChange::RegionChange(sf::Vector2i pos, RegionData prev) :
-		state{}, a_prev(prev) { skill_pos = pos; };
+		pos(pos), state{}, a_prev(prev) {};
 
 	/// Applies the move.
 	void RegionChange::onApply(Map* map) {
 		// get tile
-		Hex* hex = map->at(skill_pos);
+		Hex* hex = map->at(pos);
 		if (!hex || !hex->region()) return;
 
 		// store previous region state
@@ -45,15 +45,17 @@ namespace Moves {
 
 		// override region state
 		hex->region()->setData(state);
+		map->regions.touch(hex->region());
 	};
 
 	/// Reverts the move.
 	void RegionChange::onRevert(Map* map) {
 		// get tile
-		Hex* hex = map->at(skill_pos);
-		if (!hex) return;
+		Hex* hex = map->at(pos);
+		if (!hex || !hex->region()) return;
 
 		// override region state
 		hex->region()->setData(a_prev);
+		map->regions.touch(hex->region());
 	};
 };
\ No newline at end of file
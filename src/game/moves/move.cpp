@@ -7,6 +7,7 @@
 #include "game/values/plant_values.hpp"
 
 #include "assets.hpp"
+#include <algorithm>
 
 /// Returns tile to select after applying the move.
 std::optional<sf::Vector2i> Move::applyCursor() {
@@ -20,6 +21,9 @@ std::optional<sf::Vector2i> Move::revertCursor() {
 
 /// Applies the move.
 void Move::apply(Map* map) {
+	// mark skill origin as changed
+	map->touch(skill_pos);
+
 	// add cooldown
 	if (skill_cooldown)
 		if (Hex* hex = map->at(skill_pos))
@@ -32,6 +36,9 @@ void Move::apply(Map* map) {
 
 /// Reverts the move.
 void Move::revert(Map* map) {
+	// mark skill origin as changed
+	map->touch(skill_pos);
+
 	// apply the move
 	onRevert(map);
 
@@ -53,6 +60,37 @@ namespace Moves {
 		return Empty{ .pos = pos };
 	};
 
+	/// Checks if two entities share common entity state.
+	///
+	/// @param a First entity.
+	/// @param b Second entity.
+	static bool _same_base(const Entity& a, const Entity& b) {
+		return a.pos == b.pos && a.hp == b.hp
+			&& std::equal(std::begin(a.timers), std::end(a.timers), std::begin(b.timers))
+			&& a.effectList() == b.effectList();
+	};
+
+	/// Checks if two entity states are the same.
+	bool same_entity(const EntState& a, const EntState& b) {
+		if (a.index() != b.index()) return false;
+		if (auto* x = std::get_if<Empty>(&a))
+			return x->pos == std::get<Empty>(b).pos;
+		if (auto* x = std::get_if<Troop>(&a)) {
+			const Troop& y = std::get<Troop>(b);
+			return _same_base(*x, y) && x->type == y.type;
+		};
+		if (auto* x = std::get_if<Build>(&a)) {
+			const Build& y = std::get<Build>(b);
+			return _same_base(*x, y) && x->type == y.type;
+		};
+		if (auto* x = std::get_if<Plant>(&a)) {
+			const Plant& y = std::get<Plant>(b);
+			return _same_base(*x, y) && x->type == y.type
+				&& x->stage == y.stage && x->spread == y.spread && x->fresh == y.fresh;
+		};
+		return true;
+	};
+
 	/// Places an entity on a map.
 	void place_entity(const EntState* entity, Map* map) {
 		// place empty space
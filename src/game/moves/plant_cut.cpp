@@ -22,8 +22,10 @@ namespace Moves {
 		map->removeEntity(hex);
 
 		// grant plant cut bonus
-		if (from->region())
+		if (from->region()) {
 			from->region()->money += logic::plant_bonus[a_state.type];
+			map->regions.touch(from->region());
+		};
 	};
 
 	/// Reverts the move.
@@ -38,8 +40,10 @@ namespace Moves {
 		map->setPlant(a_state);
 
 		// remove plant cut bonus
-		if (from->region())
+		if (from->region()) {
 			from->region()->money -= logic::plant_bonus[a_state.type];
+			map->regions.touch(from->region());
+		};
 	};
 
 	/// Emits move section info.
@@ -1,5 +1,6 @@
 #include "game/moves/plant_modify.hpp"
 #include "game/map.hpp"
+#include "game/radius.hpp"
 
 namespace Moves {
 	/// Checks if a tile contains a harvestable plant.
@@ -30,13 +31,16 @@ namespace Moves {
 
 				// harvest resources from the plant
 				a_res.add(plant.harvest());
+				map->touch(tile.pos);
 			}
 		};
-		spread.apply(*map, mid, radius);
+		Radius::apply(spread, *map, mid, radius);
 
 		// store harvested resources
-		if (hex->region())
+		if (hex->region()) {
 			hex->region()->add(a_res);
+			map->regions.touch(hex->region());
+		};
 	};
 
 	/// Reverts the move.
@@ -50,8 +54,10 @@ namespace Moves {
 			map->setPlant(plant);
 
 		// subtract harvested resources
-		if (hex->region())
+		if (hex->region()) {
 			hex->region()->sub(a_res);
+			map->regions.touch(hex->region());
+		};
 	};
 
 	/// Emits move section info.
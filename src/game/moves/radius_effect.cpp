@@ -1,5 +1,6 @@
 #include "game/moves/radius_effect.hpp"
 #include "game/map.hpp"
+#include "game/radius.hpp"
 
 #include "game/values/entity_values.hpp"
 #include "game/values/hex_values.hpp"
@@ -7,9 +8,13 @@
 namespace Moves {
 	/// Constructs an AoE effect move.
 	RadiusEffect::RadiusEffect(sf::Vector2i mid, size_t radius, EffectType effect, Region::Team team)
-		: effect(effect), mid(mid), radius(radius), team(team)
-	{
-		spread = {
+		: effect(effect), mid(mid), radius(radius), team(team) {};
+
+	/// Applies the move.
+	void RadiusEffect::onApply(Map* map) {
+		// fetch target list
+		a_target.clear();
+		Spread spread = {
 			// unaffected troops of enemy teams
 			.pass = [=](const Spread::Tile& tile) {
 				return tile.hex->troop
@@ -21,13 +26,7 @@ namespace Moves {
 				a_target.push_back(tile.pos);
 			}
 		};
-	};
-
-	/// Applies the move.
-	void RadiusEffect::onApply(Map* map) {
-		// fetch target list
-		a_target.clear();
-		spread.apply(*map, mid, radius);
+		Radius::apply(spread, *map, mid, radius);
 
 		// apply effects to all target troops
 		for (sf::Vector2i target : a_target) {
@@ -37,6 +36,7 @@ namespace Moves {
 
 			// apply effect
 			if (hex->troop) hex->troop->addEffect(effect);
+			map->touch(target);
 		};
 	};
 
@@ -50,6 +50,7 @@ namespace Moves {
 
 			// revert effect
 			if (hex->troop) hex->troop->removeEffect(effect);
+			map->touch(target);
 		};
 	};
 
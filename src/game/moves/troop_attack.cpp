@@ -31,6 +31,7 @@ namespace Moves {
 
 		// deal damage to entity
 		a_dmg = dst->damage(src->offense(Access::Use));
+		map->touch(dest);
 
 		// clean up a dead entity
 		if (dst->dead()) {
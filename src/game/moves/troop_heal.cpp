@@ -29,26 +29,26 @@ namespace Moves {
 
 	/// Constructs a troop heal move.
 	TroopHeal::TroopHeal(sf::Vector2i mid, size_t radius, int heal, Region::Team team)
-		: radius(radius), mid(mid), heal(heal), team(team), a_cost{}
-	{
-		spread = troopHealCost(heal, team, &a_cost);
-		spread.effect = [=](const Spread::Tile& tile) {
-			// add heal targets to list
-			a_target.push_back({ tile.pos, tile.hex->troop->hp });
-		};
-	};
+		: radius(radius), mid(mid), heal(heal), team(team), a_cost{} {};
 
 	/// Applies the move.
 	void TroopHeal::onApply(Map* map) {
 		// fetch target list
 		a_cost = 0;
 		a_target.clear();
-		spread.apply(*map, mid, radius);
+		Spread spread = troopHealCost(heal, team, &a_cost);
+		spread.effect = [=](const Spread::Tile& tile) {
+			// add heal targets to list
+			a_target.push_back({ tile.pos, tile.hex->troop->hp });
+		};
+		Radius::apply(spread, *map, mid, radius);
 
 		// subtract healing cost
 		Hex* hex = map->at(mid);
-		if (hex && hex->region())
+		if (hex && hex->region()) {
 			hex->region()->berry -= a_cost;
+			map->regions.touch(hex->region());
+		};
 
 		// heal all targets
 		for (const auto& target : a_target) {
@@ -61,6 +61,7 @@ namespace Moves {
 				hex->troop->hp + heal,
 				hex->troop->max_hp()
 			);
+			map->touch(target.pos);
 		};
 	};
 
@@ -74,12 +75,15 @@ namespace Moves {
 
 			// revert hp
 			if (hex->troop) hex->troop->hp = target.hp_before;
+			map->touch(target.pos);
 		};
 
 		// recompensate healing cost
 		Hex* hex = map->at(mid);
-		if (hex && hex->region())
+		if (hex && hex->region()) {
 			hex->region()->berry += a_cost;
+			map->regions.touch(hex->region());
+		};
 	};
 
 	/// Emits move section info.
@@ -33,7 +33,7 @@ namespace Moves {
 		Regions::Ref prev = to.hex->region();
 		if (prev != from.hex->region()) {
 			to.hex->team = from.hex->team;
-			to.hex->join(from.hex->region());
+			to.hex->join(from.hex->region(), to.pos);
 
 			// update regions
 			a_state.split = map->updateRegions(to, prev, {});
@@ -42,6 +42,7 @@ namespace Moves {
 		// move troop
 		to.hex->troop = std::move(from.hex->troop);
 		to.hex->troop->pos = to.pos;
+		map->touch(to.pos);
 	};
 
 	/// Reverts the move.
@@ -54,6 +55,7 @@ namespace Moves {
 		// move troop
 		to.hex->troop = std::move(from.hex->troop);
 		to.hex->troop->pos = to.pos;
+		map->touch(from.pos);
 
 		// restore previous region
 		Regions::Ref prev = from.hex->region();
@@ -74,13 +76,13 @@ namespace Moves {
 
 			// reconstruct previous region
 			if (!reg) {
-				reg = map->regions.create({ .team = a_state.team });
+				reg = map->regions.create(a_state.team);
 				reg->add(a_state.resources);
 			};
 
 			// repaint tile region back
 			from.hex->team = a_state.team;
-			from.hex->join(reg);
+			from.hex->join(reg, from.pos);
 
 			// update regions
 			map->updateRegions(from, prev, a_state.split);
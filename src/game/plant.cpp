@@ -36,9 +36,9 @@ bool Plant::stage_roll(Map* map) {
 
 	// roll chances for different types
 	switch (type) {
-		case Bush   : return Random::pity(0.33f * boost, stage, 3);
-		case Sapling: return Random::pity(0.20f * boost, stage, 5);
-		case Tree   : return Random::pity(0.25f * boost, stage, 4);
+		case Bush   : return map->random.pity(0.33f * boost, stage, 3);
+		case Sapling: return map->random.pity(0.20f * boost, stage, 5);
+		case Tree   : return map->random.pity(0.25f * boost, stage, 4);
 	};
 	return false;
 };
@@ -53,11 +53,11 @@ bool Plant::spread_roll(Map* map) {
 
 	// roll chances for different types
 	switch (type) {
-		case Bush : return Random::pity(0.25f * boost, spread, 4);
-		case Berry: return Random::pity(0.33f * boost, spread, 3);
-		case Tree : return Random::pity(0.20f * boost, spread, 5);
-		case Peach: return Random::pity(0.25f * boost, spread, 4);
-		case Pine : return Random::chance(0.95f * boost);
+		case Bush : return map->random.pity(0.25f * boost, spread, 4);
+		case Berry: return map->random.pity(0.33f * boost, spread, 3);
+		case Tree : return map->random.pity(0.20f * boost, spread, 5);
+		case Peach: return map->random.pity(0.25f * boost, spread, 4);
+		case Pine : return map->random.chance(0.95f * boost);
 	};
 	return false;
 };
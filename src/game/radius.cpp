@@ -0,0 +1,83 @@
+#include "game/radius.hpp"
+
+namespace Radius {
+	/// Ring offset tables.
+	///
+	/// Rings of both row parities are stored one after another
+	/// in order of distance, so every disk is a prefix of a table.
+	struct Tables {
+		std::vector<sf::Vector2i> offsets[2]; /// Offsets of every row parity.
+		size_t start[Max + 2] = {};           /// Ring start indices (same for both parities).
+
+		/// Generates the tables.
+		Tables() {
+			for (int parity = 0; parity < 2; parity++) {
+				sf::Vector2i mid = { 0, parity };
+				auto& list = offsets[parity];
+
+				// bucket offsets by distance, in row order
+				for (size_t r = 0; r <= Max; r++) {
+					start[r] = list.size();
+					for (int dy = -(int)Max; dy <= (int)Max; dy++) {
+						for (int dx = -(int)Max - 1; dx <= (int)Max + 1; dx++) {
+							sf::Vector2i off = { dx, dy };
+							if ((size_t)HexArray::distance(mid, mid + off) == r)
+								list.push_back(off);
+						};
+					};
+				};
+				start[Max + 1] = list.size();
+			};
+		};
+	};
+
+	/// Returns offset tables.
+	static const Tables& _tables() {
+		static const Tables tables;
+		return tables;
+	};
+
+	/// Returns offsets of all tiles at a distance.
+	Offsets ring(size_t radius, int row) {
+		const Tables& t = _tables();
+		const auto& list = t.offsets[row & 1];
+		return Offsets(list.data() + t.start[radius], t.start[radius + 1] - t.start[radius]);
+	};
+
+	/// Returns offsets of all tiles within a distance.
+	Offsets disk(size_t radius, int row) {
+		const Tables& t = _tables();
+		const auto& list = t.offsets[row & 1];
+		return Offsets(list.data() + t.start[1], t.start[radius + 1] - t.start[1]);
+	};
+
+	/// Applies a spread to every tile within a distance.
+	void apply(const Spread& spread, const HexArray& array, sf::Vector2i pos, size_t radius) {
+		// check whether the spread can be blocked
+		auto* hop = spread.hop.target<bool(*)(const Spread::Tile&)>();
+		auto* rad = spread.radius.target<std::optional<size_t>(*)(const Spread::Tile&)>();
+		bool open = hop && *hop == &Spread::default_check;
+		bool fixed = rad && *rad == &Spread::default_radius;
+
+		// fall back to a spread pass
+		if (!fixed || radius > Max || (!open && radius > 1)) {
+			spread.apply(array, pos, radius);
+			return;
+		};
+
+		// ignore if no origin tile
+		Hex* origin = array.at(pos);
+		if (!origin) return;
+
+		// apply effect to origin if needed
+		Spread::Tile mid = { { origin, pos }, radius };
+		if (spread.imm && spread.pass(mid))
+			spread.effect(mid);
+
+		// apply effect to every tile around
+		each(array, pos, radius, [&](const Spread::Tile& tile) {
+			if ((open || spread.hop(tile)) && spread.pass(tile))
+				spread.effect(tile);
+		});
+	};
+};
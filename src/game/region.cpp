@@ -1,7 +1,10 @@
 #include "game/region.hpp"
 #include "game/map.hpp"
 #include "game/logic/skill_helper.hpp"
-#include <set>
+#include "game/zobrist.hpp"
+#include "flags.hpp"
+#include <algorithm>
+#include <iostream>
 
 /// Adds another region resources.
 void RegionRes::add(const RegionRes& oth) {
@@ -71,14 +74,92 @@ void Region::tick() {
 	};
 };
 
-/// Returns a region iterator.
-RefPool<Region>::It Regions::iter() {
-	return _pool.iter();
-};
-
 /// Creates a new region.
 Regions::Ref Regions::create(const Region& region) {
-	return _pool.add(region);
+	Ref ref = _pool.add(region);
+
+	// drop index entry of the previous slot owner
+	size_t idx = ref.index();
+	if (idx >= _index.size())
+		_index.resize(idx + 1);
+	unlist(idx);
+
+	// list the region under its team
+	Entry& entry = _index[idx];
+	entry.team = region.team;
+	entry.pos = { -1, -1 };
+	entry.slot = _teams[region.team].size();
+	_teams[region.team].push_back(idx);
+	touch(ref);
+	return ref;
+};
+
+/// Creates a new empty region.
+Regions::Ref Regions::create(Region::Team team) {
+	Region region = {};
+	region.team = team;
+	region.link = {};
+	return create(region);
+};
+
+/// Removes a pool slot from its team region list.
+void Regions::unlist(size_t idx) {
+	Entry& entry = _index[idx];
+	if (entry.slot == ~0ull) return;
+
+	// move last listed slot into the freed position
+	auto& list = _teams[entry.team];
+	list[entry.slot] = list.back();
+	_index[list.back()].slot = entry.slot;
+	list.pop_back();
+	entry.slot = ~0ull;
+};
+
+/// Sets region access point.
+void Regions::anchor(const Ref& ref, sf::Vector2i pos) {
+	if (!ref) return;
+	_index[ref.index()].pos = pos;
+	touch(ref);
+};
+
+/// Returns hash key of a pool slot.
+uint64_t Regions::key(size_t idx) {
+	// ignore deleted, merged & empty regions
+	const Region* reg = _pool.get(idx);
+	if (!reg || reg->link || reg->tiles <= 0) return 0;
+	return Zobrist::region(*reg);
+};
+
+/// Recomputes hash keys of all regions from scratch.
+void Regions::rehash() {
+	_dirty.clear();
+	_hash = 0;
+	for (size_t idx = 0; idx < _index.size(); idx++) {
+		_index[idx].key = key(idx);
+		_hash ^= _index[idx].key;
+	};
+};
+
+/// Returns Zobrist hash of all live regions.
+uint64_t Regions::hash() {
+	// rehash changed regions
+	for (size_t idx : _dirty) {
+		Entry& entry = _index[idx];
+		_hash ^= entry.key;
+		entry.key = key(idx);
+		_hash ^= entry.key;
+	};
+	_dirty.clear();
+
+	// check against a full recount
+	if (flags::verify) {
+		uint64_t full = 0;
+		for (size_t idx = 0; idx < _index.size(); idx++)
+			full ^= key(idx);
+		if (full != _hash)
+			std::cerr << "[ERROR] Region hash mismatch" << std::endl;
+	};
+	return _hash;
 };
 
 /// Enumerates all regions in a map.
@@ -86,7 +167,7 @@ void Regions::enumerate(Map* map) {
 	// clear region pointers
 	for (int y = 0; y < map->size().y; y++)
 		for (int x = 0; x < map->size().x; x++)
-			map->ats({ x, y }).leave();
+			map->ats({ x, y }).leave({ x, y });
 
 	// enumerate region pointers
 	for (int y = 0; y < map->size().y; y++) {
@@ -98,14 +179,18 @@ void Regions::enumerate(Map* map) {
 			if (hex.region() || !hex.solid()) continue;
 
 			// create and spread new region
-			auto region = create({ .team = hex.team });
-			Spread spread = {
-				.hop = [=, team = hex.team](const Spread::Tile& tile) {
+			auto region = create(hex.team);
+			anchor(region, { x, y });
+			BasicSpread spread = {
+				.hop = [team = hex.team](const Spread::Tile& tile) {
 					// hop if same team and a ground tile
 					return tile.hex->team == team
 						&& tile.hex->solid();
 				},
-				.effect = skillf::regionJoin(region),
+				.effect = [&region](const Spread::Tile& tile) {
+					// join created region
+					tile.hex->join(region, tile.pos);
+				},
 				.imm = true
 			};
 			spread.apply(*map, { x, y });
@@ -113,55 +198,129 @@ void Regions::enumerate(Map* map) {
 	};
 };
 
-/// Executes the function for each region in a map.
-void Regions::foreach(const Map* map, std::function<void(Region&, sf::Vector2i)> call) {
-	// visited regions indices
-	std::set<size_t> visited;
+/// Visits live regions from a team region list.
+void Regions::visit(const Map* map, Region::Team team, const Call& call) const {
+	for (size_t idx : _teams[team]) {
+		// a region is live if its access point resolves back to it,
+		// merged, emptied or deleted regions are skipped
+		sf::Vector2i pos = _index[idx].pos;
+		Hex* hex = map->at(pos);
+		if (!hex || !hex->region() || hex->region().index() != idx)
+			continue;
+
+		// execute callback for the region
+		call(*hex->region(), pos);
+	};
+};
 
-	// for all regions
+/// Checks the region index against a full map scan.
+///
+/// Only used when `flags::verify` is set.
+///
+/// @param map Map reference.
+/// @param team Checked team, `Region::Count` for all teams.
+/// @param visited Indices of regions visited through the index.
+static void _region_verify(const Map* map, Region::Team team, std::vector<size_t> visited) {
+	// collect regions of all tiles
+	std::vector<size_t> scanned;
 	for (int y = 0; y < map->size().y; y++) {
 		for (int x = 0; x < map->size().x; x++) {
-			// get tile
-			Hex& hex = map->ats({ x, y });
+			Hex* hex = map->at({ x, y });
+			if (!hex || !hex->solid() || !hex->region()) continue;
+			if (team == Region::Count || hex->region()->team == team)
+				scanned.push_back(hex->region().index());
+		};
+	};
 
-			// ignore if empty or not solid
-			// or no attached region
-			if (!hex.solid() || !hex.region()) continue;
-			Region& reg = *hex.region();
+	// compare region sets
+	std::sort(scanned.begin(), scanned.end());
+	scanned.erase(std::unique(scanned.begin(), scanned.end()), scanned.end());
+	std::sort(visited.begin(), visited.end());
+	if (scanned != visited) {
+		std::cerr << "[ERROR] Region index mismatch (indexed " << visited.size()
+			<< " regions, scanned " << scanned.size() << ")" << std::endl;
+	};
+};
 
-			// ignore tile if already got visited
-			// or tile does not have a region attached
-			size_t idx = hex.region().index();
-			if (visited.find(idx) != visited.cend())
-				continue;
+/// Executes the function for each region in a map.
+void Regions::foreach(const Map* map, const Call& call) const {
+	if (!flags::verify) {
+		for (int i = 0; i < Region::Count; i++)
+			visit(map, static_cast<Region::Team>(i), call);
+		return;
+	};
 
-			// execute callback for the region
-			call(reg, { x, y });
+	// record visited regions for verification
+	std::vector<size_t> visited;
+	for (int i = 0; i < Region::Count; i++) {
+		visit(map, static_cast<Region::Team>(i), [&](Region& reg, sf::Vector2i pos) {
+			visited.push_back(map->ats(pos).region().index());
+			call(reg, pos);
+		});
+	};
+	_region_verify(map, Region::Count, std::move(visited));
+};
 
-			// mark region as visited
-			visited.insert(idx);
-		};
+/// Executes the function for each region of a team.
+void Regions::foreach(const Map* map, Region::Team team, const Call& call) const {
+	if (!flags::verify) {
+		visit(map, team, call);
+		return;
 	};
+
+	// record visited regions for verification
+	std::vector<size_t> visited;
+	visit(map, team, [&](Region& reg, sf::Vector2i pos) {
+		visited.push_back(map->ats(pos).region().index());
+		call(reg, pos);
+	});
+	_region_verify(map, team, std::move(visited));
 };
 
 /// Creates a region overwrite spreader object.
 ///
 /// @param prev Previous region to overwrite.
 /// @param next New region to overwrite with.
-static Spread _region_overwrite(const Regions::Ref& prev, const Regions::Ref& next) {
-	return Spread {
+static auto _region_overwrite(const Regions::Ref& prev, const Regions::Ref& next) {
+	return BasicSpread {
 		.hop = [&](const Spread::Tile& tile) {
 			// hop if same region
 			return tile.hex->region() == prev;
 		},
 		.effect = [&](const Spread::Tile& tile) {
 			// overwrite tile region
-			tile.hex->join(next);
+			tile.hex->join(next, tile.pos);
 		},
 		.imm = true
 	};
 };
 
+/// Links a merged region into another region.
+///
+/// Tile counters are moved to the new region,
+/// tiles themselves are resolved lazily by `Hex::region()`.
+///
+/// @param prev Merged region.
+/// @param next Region to merge into.
+static void _region_link(const Regions::Ref& prev, const Regions::Ref& next) {
+	// move tile counters
+	next->tiles  += prev->tiles;
+	next->income += prev->tiles;
+	next->farms  += prev->farms;
+	next->tents  += prev->tents;
+	next->members ^= prev->members;
+
+	// clear merged region counters
+	prev->income -= prev->tiles;
+	prev->tiles = 0;
+	prev->farms = 0;
+	prev->tents = 0;
+	prev->members = 0;
+
+	// link the regions
+	prev->link = next;
+};
+
 /// Merges regions into a singular region.
 Regions::Split Regions::merge(
 	Map* map,
@@ -178,67 +337,243 @@ Regions::Split Regions::merge(
 	// overwrite merged regions
 	int idx = 0;
 	for (const auto& ap : aps) {
-		const Ref& apr = *ap.region;
-		if (!apr) continue;
-
 		// ignore if origin
 		if (idx++ == origin) {
 			dist.push_back(res);
 			continue;
 		};
 
+		// ignore tiles without a region
+		const Ref& apr = *ap.region;
+		if (!apr) continue;
+
 		// store & merge resources
 		dist.push_back(*apr);
 		if (target) target->add(*apr);
+		touch(apr);
+		touch(target);
 
-		// overwrite region for all hexes
+		// drop merged region from the index
 		Ref copy = apr;
-		_region_overwrite(copy, target).apply(*map, ap.pos);
+		unlist(copy.index());
+
+		// link merged region into target
+		if (target)
+			_region_link(copy, target);
+
+		// or clear region for all hexes
+		else _region_overwrite(copy, target).apply(*map, ap.pos);
 	};
 	return dist;
 };
 
+/// Region part search state.
+struct _Part {
+	Spread::Frontier queue; /// Search queue.
+	size_t group = 0;       /// Index of the part this part has met.
+	size_t tiles = 0;       /// Amount of explored tiles.
+};
+
+/// Region part search states of a thread.
+///
+/// A tile has at most 3 separate neighbor groups.
+static thread_local _Part _parts[3];
+
+/// Returns index of the part group.
+///
+/// @param idx Part index.
+static size_t _part_group(size_t idx) {
+	while (_parts[idx].group != idx)
+		idx = _parts[idx].group;
+	return idx;
+};
+
+/// Finds parts of a region separated by a tile leaving it.
+std::vector<Regions::AccessPoint> Regions::separate(Map* map, sf::Vector2i pos, const Ref& prev, size_t& keep) {
+	keep = 0;
+
+	// ignore if no region was left
+	if (!prev) return {};
+
+	// find neighbors still in the region
+	sf::Vector2i around[6];
+	Hex* hexes[6];
+	int start = -1;
+	for (int i = 0; i < 6; i++) {
+		around[i] = map->neighbor(pos, static_cast<Map::nbi_t>(i));
+		hexes[i] = map->at(around[i]);
+		if (hexes[i] && hexes[i]->region() != prev) hexes[i] = nullptr;
+		if (!hexes[i] && start < 0) start = i;
+	};
+
+	// ignore if surrounded by the region
+	if (start < 0) return {};
+
+	// group consecutive neighbors into connected arcs
+	size_t arc[6] = {};
+	size_t arcs = 0;
+	for (int k = 1; k <= 6; k++) {
+		int i = (start + k) % 6;
+		if (!hexes[i]) continue;
+
+		// continue previous arc or start a new one
+		int p = (i + 5) % 6;
+		arc[i] = hexes[p] ? arc[p] : arcs++;
+	};
+
+	// ignore if all neighbors are connected around the tile
+	if (arcs < 2) return {};
+
+	// reserve one spread index per part
+	size_t base = Spread::index(Spread::Def, arcs);
+
+	// reset search states
+	for (size_t j = 0; j < arcs; j++) {
+		_parts[j].queue.clear();
+		_parts[j].group = j;
+		_parts[j].tiles = 0;
+	};
+
+	// queue all neighbors
+	size_t* marks = map->marks(Spread::Def);
+	for (int i = 0; i < 6; i++) {
+		if (!hexes[i]) continue;
+		marks[map->index(around[i])] = base + arc[i];
+		_parts[arc[i]].queue.push({ { hexes[i], around[i] }, ~0ull });
+	};
+
+	// explore all parts at the same time
+	size_t open = arcs;
+	while (open > 1) {
+		for (size_t j = 0; j < arcs; j++) {
+			_Part& part = _parts[j];
+			if (part.queue.empty()) continue;
+
+			// pull next tile
+			Spread::Tile tile = part.queue.pop();
+			part.tiles++;
+
+			// visit neighboring tiles
+			for (int i = 0; i < 6; i++) {
+				sf::Vector2i next = map->neighbor(tile.pos, static_cast<Map::nbi_t>(i));
+				Hex* hex = map->at(next);
+				if (!hex || hex->region() != prev) continue;
+
+				// join parts if the tile has been explored by another part
+				size_t& mark = marks[map->index(next)];
+				if (mark >= base && mark < base + arcs) {
+					size_t a = _part_group(j);
+					size_t b = _part_group(mark - base);
+					if (a != b) _parts[std::max(a, b)].group = std::min(a, b);
+					continue;
+				};
+
+				// queue unexplored tile
+				mark = base + j;
+				part.queue.push({ { hex, next }, ~0ull });
+			};
+		};
+
+		// count part groups still being explored
+		bool active[3] = {};
+		open = 0;
+		for (size_t j = 0; j < arcs; j++) {
+			if (_parts[j].queue.empty()) continue;
+			size_t g = _part_group(j);
+			if (!active[g]) {
+				active[g] = true;
+				open++;
+			};
+		};
+	};
+
+	// find group to keep the region
+	size_t tiles[3] = {};
+	size_t kept = arcs;
+	for (size_t j = 0; j < arcs; j++) {
+		size_t g = _part_group(j);
+		tiles[g] += _parts[j].tiles;
+		if (!_parts[j].queue.empty()) kept = g;
+	};
+	if (kept == arcs) {
+		// all parts have been explored, keep the largest one
+		kept = 0;
+		for (size_t g = 1; g < arcs; g++)
+			if (tiles[g] > tiles[kept]) kept = g;
+	};
+
+	// store an access point for each group
+	std::vector<AccessPoint> aps;
+	bool stored[3] = {};
+	for (int i = 0; i < 6; i++) {
+		if (!hexes[i]) continue;
+
+		// ignore if group has been stored already
+		size_t g = _part_group(arc[i]);
+		if (stored[g]) continue;
+		stored[g] = true;
+
+		// store group access point
+		if (g == kept) keep = aps.size();
+		aps.push_back({ &hexes[i]->region(), around[i] });
+	};
+
+	// ignore if all parts have met
+	if (aps.size() < 2) return {};
+	return aps;
+};
+
 /// Splits a separated region into proper regions.
-void Regions::split(Map* map, const std::vector<AccessPoint>& aps, const Split& dist) {
+void Regions::split(Map* map, const std::vector<AccessPoint>& aps, const Split& dist, size_t keep) {
 	// ignore if no regions to split
 	if (aps.size() < 2) return;
 
-	// resource split per region
+	// ignore if splitting unassigned region
+	Ref main = *aps[0].region;
+	if (!main) return;
+
+	// resource split per region part
+	std::vector<RegionRes> res(aps.size());
+	RegionRes left = main->res();
 	RegionRes split;
 
 	// generate split amount for empty distribution
-	if (dist.empty()) {
-		// ignore if splitting unassigned region
-		if (!*aps[0].region) return;
-		split = (*aps[0].region)->div((int)aps.size());
-	};
+	if (dist.empty())
+		split = main->div((int)aps.size());
 
-	// overwrite region parts
+	// distribute resources between region parts
 	for (size_t i = 1; i < aps.size(); i++) {
-		const auto& ap = aps[i];
-		const auto& main = *aps[0].region;
-
-		// generate new region
-		Ref apr = *ap.region;
-		Ref region = create({ .team = apr->team });
-
-		// transfer resource split
 		if (i < dist.size()) {
 			// follow previous distribution
-			region->add(dist[i]);
-			main->sub(dist[i]);
+			res[i] = dist[i];
 		}
 		else {
 			// generate split amount
 			if (i == dist.size())
-				split = main->div((int)(aps.size() - i));
+				split = left.div((int)(aps.size() - i));
 
 			// split an equal amount from main region
-			region->add(split);
-			main->sub(split);
+			res[i] = split;
+		};
+		left.sub(res[i]);
+	};
+	res[0] = left;
+
+	// overwrite region parts
+	for (size_t i = 0; i < aps.size(); i++) {
+		// keep original region
+		if (i == keep) {
+			main->setRes(res[i]);
+			anchor(main, aps[i].pos);
+			continue;
 		};
 
+		// generate new region
+		Ref region = create(main->team);
+		region->add(res[i]);
+		anchor(region, aps[i].pos);
+
 		// overwrite region for all hexes
-		_region_overwrite(apr, region).apply(*map, ap.pos);
+		_region_overwrite(main, region).apply(*map, aps[i].pos);
 	};
-};
\ No newline at end of file
+};
@@ -2,128 +2,129 @@
 
 namespace Serialize {
 	/// Serializes an entity object.
-	sf::Packet& operator<<(sf::Packet& packet, const Entity& entity) {
+	ByteWriter& operator<<(ByteWriter& writer, const Entity& entity) {
 		// entity position
-		packet << entity.pos;
+		writer << entity.pos;
 
 		// entity health
-		packet << (int16_t)entity.hp;
+		writer << (int16_t)entity.hp;
 
 		// entity timers
 		for (int i = 0; i < 4; i++)
-			packet << entity.timers[i];
+			writer << entity.timers[i];
 
 		// entity effects
-		packet << (uint8_t)entity.effectList().size();
+		writer << (uint8_t)entity.effectList().size();
 		for (EffectType eff : entity.effectList())
-			packet << static_cast<uint8_t>(eff);
-		return packet;
+			writer << static_cast<uint8_t>(eff);
+		return writer;
 	};
 	/// Deserializes an entity object.
-	sf::Packet& operator>>(sf::Packet& packet, Entity& entity) {
+	ByteReader& operator>>(ByteReader& reader, Entity& entity) {
 		// entity position
-		packet >> entity.pos;
+		reader >> entity.pos;
 
 		// entity health
-		packet >> (int16_t&)entity.hp;
+		if (int16_t hp = 0; reader >> hp)
+			entity.hp = hp;
 
 		// entity timers
 		for (int i = 0; i < 4; i++)
-			packet >> entity.timers[i];
+			reader >> entity.timers[i];
 
 		// entity effects
-		int count = from<uint8_t>(packet);
+		int count = from<uint8_t>(reader);
 		while (count-- > 0) {
-			auto byte = from<uint8_t>(packet);
+			auto byte = from<uint8_t>(reader);
 			if (byte >= static_cast<int>(EffectType::Count))
 				byte = 0;
 			entity.addEffect(static_cast<EffectType>(byte));
 		};
-		return packet;
+		return reader;
 	};
 
 	/// Serializes a troop object.
-	sf::Packet& operator<<(sf::Packet& packet, const Troop& troop) {
-		packet << (const Entity&)troop;
-		packet << (uint8_t)troop.type;
-		return packet;
+	ByteWriter& operator<<(ByteWriter& writer, const Troop& troop) {
+		writer << (const Entity&)troop;
+		writer << (uint8_t)troop.type;
+		return writer;
 	};
 	/// Deserializes a troop object.
-	sf::Packet& operator>>(sf::Packet& packet, Troop& troop) {
-		packet >> (Entity&)troop;
-		auto byte = from<uint8_t>(packet);
+	ByteReader& operator>>(ByteReader& reader, Troop& troop) {
+		reader >> (Entity&)troop;
+		auto byte = from<uint8_t>(reader);
 		if (byte >= Troop::Count) byte = 0;
 		troop.type = static_cast<Troop::Type>(byte);
-		return packet;
+		return reader;
 	};
 
 	/// Serializes a building object.
-	sf::Packet& operator<<(sf::Packet& packet, const Build& build) {
-		packet << (const Entity&)build;
-		packet << (uint8_t)build.type;
-		return packet;
+	ByteWriter& operator<<(ByteWriter& writer, const Build& build) {
+		writer << (const Entity&)build;
+		writer << (uint8_t)build.type;
+		return writer;
 	};
 	/// Deserializes a building object.
-	sf::Packet& operator>>(sf::Packet& packet, Build& build) {
-		packet >> (Entity&)build;
-		auto byte = from<uint8_t>(packet);
+	ByteReader& operator>>(ByteReader& reader, Build& build) {
+		reader >> (Entity&)build;
+		auto byte = from<uint8_t>(reader);
 		if (byte >= Build::Count) byte = 0;
 		build.type = static_cast<Build::Type>(byte);
-		return packet;
+		return reader;
 	};
 
 	/// Serializes a plant object.
-	sf::Packet& operator<<(sf::Packet& packet, const Plant& plant) {
-		packet << (const Entity&)plant;
-		packet << (uint8_t)plant.type;
-		return packet;
+	ByteWriter& operator<<(ByteWriter& writer, const Plant& plant) {
+		writer << (const Entity&)plant;
+		writer << (uint8_t)plant.type;
+		return writer;
 	};
 	/// Deserializes a plant object.
-	sf::Packet& operator>>(sf::Packet& packet, Plant& plant) {
-		packet >> (Entity&)plant;
-		auto byte = from<uint8_t>(packet);
+	ByteReader& operator>>(ByteReader& reader, Plant& plant) {
+		reader >> (Entity&)plant;
+		auto byte = from<uint8_t>(reader);
 		if (byte >= Plant::Count) byte = 0;
 		plant.type = static_cast<Plant::Type>(byte);
-		return packet;
+		return reader;
 	};
 
 	/// Serializes an entity state.
-	sf::Packet& operator<<(sf::Packet& packet, const Moves::EntState& entity) {
+	ByteWriter& operator<<(ByteWriter& writer, const Moves::EntState& entity) {
 		if (auto* data = std::get_if<Moves::Empty>(&entity)) {
-			packet << (uint8_t)S_Empty;
-			packet << data->pos;
+			writer << (uint8_t)S_Empty;
+			writer << data->pos;
 		}
 		else if (auto* data = std::get_if<Troop>(&entity)) {
-			packet << (uint8_t)S_Troop;
-			packet << *data;
+			writer << (uint8_t)S_Troop;
+			writer << *data;
 		}
 		else if (auto* data = std::get_if<Build>(&entity)) {
-			packet << (uint8_t)S_Build;
-			packet << *data;
+			writer << (uint8_t)S_Build;
+			writer << *data;
 		}
 		else if (auto* data = std::get_if<Plant>(&entity)) {
-				packet << (uint8_t)S_Plant;
-				packet << *data;
+				writer << (uint8_t)S_Plant;
+				writer << *data;
 			};
-		return packet;
+		return writer;
 	};
 	/// Deserializes an entity state.
-	sf::Packet& operator>>(sf::Packet& packet, Moves::EntState& entity) {
+	ByteReader& operator>>(ByteReader& reader, Moves::EntState& entity) {
 		// get type
-		auto type = from<uint8_t>(packet);
+		auto type = from<uint8_t>(reader);
 
 		// get state data
 		if (type == S_Troop)
-			entity = from<Troop>(packet);
+			entity = from<Troop>(reader);
 		else if (type == S_Build)
-			entity = from<Build>(packet);
+			entity = from<Build>(reader);
 		else if (type == S_Plant)
-			entity = from<Plant>(packet);
+			entity = from<Plant>(reader);
 		else {
 			Moves::Empty value;
-			packet >> value.pos;
+			reader >> value.pos;
 			entity = value;
 		};
-		return packet;
+		return reader;
 	};
 };
\ No newline at end of file
@@ -1,17 +1,82 @@
 #include "game/serialize/general.hpp"
 
 namespace Serialize {
-	/// Writes a vector to the packet.
-	sf::Packet& operator<<(sf::Packet& packet, sf::Vector2i vec) {
-		packet << (int16_t)vec.x;
-		packet << (int16_t)vec.y;
-		return packet;
-	};
-
-	/// Reads a vector from the packet.
-	sf::Packet& operator>>(sf::Packet& packet, sf::Vector2i& vec) {
-		packet >> (int16_t&)vec.x;
-		packet >> (int16_t&)vec.y;
-		return packet;
+	/// Writes a vector to the writer.
+	ByteWriter& operator<<(ByteWriter& writer, sf::Vector2i vec) {
+		writer << (int16_t)vec.x;
+		writer << (int16_t)vec.y;
+		return writer;
+	};
+
+	/// Reads a vector from the reader.
+	ByteReader& operator>>(ByteReader& reader, sf::Vector2i& vec) {
+		int16_t x = 0, y = 0;
+		if (reader >> x >> y) {
+			vec.x = x;
+			vec.y = y;
+		};
+		return reader;
+	};
+
+	/// Writes an unsigned number as a variable-length integer.
+	void encodeVar(ByteWriter& writer, uint64_t value) {
+		while (value >= 0x80) {
+			writer << (uint8_t)(value | 0x80);
+			value >>= 7;
+		};
+		writer << (uint8_t)value;
+	};
+
+	/// Reads a variable-length unsigned integer from the reader.
+	uint64_t decodeVar(ByteReader& reader) {
+		uint64_t value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			uint8_t byte = 0;
+			if (!(reader >> byte)) return 0;
+			value |= (uint64_t)(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) return value;
+		};
+
+		// too many bytes
+		reader.fail();
+		return 0;
+	};
+
+	/// Writes a signed number as a variable-length integer.
+	void encodeVarInt(ByteWriter& writer, int64_t value) {
+		encodeVar(writer, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+	};
+
+	/// Reads a variable-length signed integer from the reader.
+	int64_t decodeVarInt(ByteReader& reader) {
+		uint64_t value = decodeVar(reader);
+		return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	};
+
+	/// Writes a map position with variable-length coordinates.
+	void encodePos(ByteWriter& writer, sf::Vector2i pos) {
+		encodeVarInt(writer, pos.x);
+		encodeVarInt(writer, pos.y);
+	};
+
+	/// Reads a map position with variable-length coordinates.
+	sf::Vector2i decodePos(ByteReader& reader) {
+		sf::Vector2i pos;
+		pos.x = (int)decodeVarInt(reader);
+		pos.y = (int)decodeVarInt(reader);
+		return pos;
+	};
+
+	/// Returns a reader over unread packet contents.
+	ByteReader readPacket(const sf::Packet& packet) {
+		size_t pos = packet.getReadPosition();
+		const auto* data = static_cast<const uint8_t*>(packet.getData());
+		if (!data || pos >= packet.getDataSize()) return {};
+		return ByteReader(data + pos, packet.getDataSize() - pos);
+	};
+
+	/// Appends written bytes to a packet.
+	void writePacket(sf::Packet& packet, std::span<const uint8_t> bytes) {
+		if (!bytes.empty()) packet.append(bytes.data(), bytes.size());
 	};
 };
\ No newline at end of file
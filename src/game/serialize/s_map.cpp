@@ -6,28 +6,28 @@ namespace Serialize {
 	static const uint8_t SIGN[4] = { 'h', 'e', 'x', '?' };
 
 	/// Serializes a template signature.
-	void encodeSignature(sf::Packet& packet) {
+	void encodeSignature(ByteWriter& writer) {
 		for (int i = 0; i < 4; i++)
-			packet << SIGN[i];
+			writer << SIGN[i];
 	};
 	/// Deserializes a template signature.
-	bool decodeSignature(sf::Packet& packet) {
+	bool decodeSignature(ByteReader& reader) {
 		for (int i = 0; i < 4; i++) {
-			if (from<uint8_t>(packet) != SIGN[i])
+			if (from<uint8_t>(reader) != SIGN[i])
 				return false;
 		};
 		return true;
 	};
 
 	/// Serializes a hex base object.
-	sf::Packet& operator<<(sf::Packet& packet, const HexBase& hex) {
+	ByteWriter& operator<<(ByteWriter& writer, const HexBase& hex) {
 		uint8_t byte = hex.team << 4 | hex.type;
-		packet << byte;
-		return packet;
+		writer << byte;
+		return writer;
 	};
 	/// Deserializes a hex base object.
-	sf::Packet& operator>>(sf::Packet& packet, HexBase& hex) {
-		auto byte = from<uint8_t>(packet);
+	ByteReader& operator>>(ByteReader& reader, HexBase& hex) {
+		auto byte = from<uint8_t>(reader);
 
 		// read data
 		hex.type = static_cast<Hex::Type>(byte & 0x3);
@@ -36,91 +36,314 @@ namespace Serialize {
 		// validate data
 		if (hex.team >= Region::Count)
 			hex.team = Region::Unclaimed;
-		return packet;
+		return reader;
 	};
 
 	/// Serializes region resources object.
-	sf::Packet& operator<<(sf::Packet& packet, const RegionRes& res) {
-		packet << res.money;
-		packet << res.berry;
-		packet << res.peach;
-		return packet;
+	ByteWriter& operator<<(ByteWriter& writer, const RegionRes& res) {
+		writer << res.money;
+		writer << res.berry;
+		writer << res.peach;
+		return writer;
 	};
 	/// Deserializes region resources object.
-	sf::Packet& operator>>(sf::Packet& packet, RegionRes& res) {
-		packet >> res.money;
-		packet >> res.berry;
-		packet >> res.peach;
-		return packet;
+	ByteReader& operator>>(ByteReader& reader, RegionRes& res) {
+		reader >> res.money;
+		reader >> res.berry;
+		reader >> res.peach;
+		return reader;
 	};
 
 	/// Serializes region variable counters object.
-	sf::Packet& operator<<(sf::Packet& packet, const RegionVar& var) {
-		packet << var.farms;
-		packet << var.tents;
-		return packet;
+	ByteWriter& operator<<(ByteWriter& writer, const RegionVar& var) {
+		writer << var.farms;
+		writer << var.tents;
+		return writer;
 	};
 	/// Deserializes region variable counters object.
-	sf::Packet& operator>>(sf::Packet& packet, RegionVar& var) {
-		packet >> var.farms;
-		packet >> var.tents;
-		return packet;
+	ByteReader& operator>>(ByteReader& reader, RegionVar& var) {
+		reader >> var.farms;
+		reader >> var.tents;
+		return reader;
+	};
+
+	/// Serializes template entity lists.
+	static void encodeEntities(ByteWriter& writer, const Template& temp) {
+		encodeVec(writer, temp.troops);
+		encodeVec(writer, temp.builds);
+		encodeVec(writer, temp.plants);
+	};
+	/// Deserializes template entity lists.
+	static void decodeEntities(ByteReader& reader, Template& temp) {
+		temp.troops = decodeVec<Troop>(reader);
+		temp.builds = decodeVec<Build>(reader);
+		temp.plants = decodeVec<Plant>(reader);
+	};
+
+	/// Serializes template region construction data.
+	static void encodeRegions(ByteWriter& writer, const Template& temp) {
+		writer << (int)temp.regions.size();
+		for (const auto& rcd : temp.regions) {
+			writer << rcd.res;
+			writer << rcd.pos;
+		};
+	};
+	/// Deserializes template region construction data.
+	static void decodeRegions(ByteReader& reader, Template& temp) {
+		int count = from<int>(reader);
+		if (count < 0 || (size_t)count > reader.remaining()) {
+			reader.fail();
+			return;
+		};
+		temp.regions.reserve(count);
+		for (int i = 0; i < count; i++) {
+			temp.regions.push_back({
+				from<RegionRes>(reader),
+				from<sf::Vector2i>(reader)
+			});
+		};
+	};
+
+	/// Serializes template entity lists and region construction data.
+	static void encodeContents(ByteWriter& writer, const Template& temp) {
+		encodeEntities(writer, temp);
+		encodeRegions(writer, temp);
+	};
+	/// Deserializes template entity lists and region construction data.
+	static void decodeContents(ByteReader& reader, Template& temp) {
+		decodeEntities(reader, temp);
+		decodeRegions(reader, temp);
+	};
+
+	/// Packs template tiles into a tile plane.
+	///
+	/// @param temp Map template.
+	/// @param plane Target plane, one byte per tile (`team << 4 | type`).
+	static void packTiles(const Template& temp, uint8_t* plane) {
+		for (const HexBase& hex : temp.tiles())
+			*plane++ = (uint8_t)(hex.team << 4 | hex.type);
+	};
+	/// Packs template tiles into a tile plane.
+	///
+	/// @param temp Map template.
+	///
+	/// @return One byte per tile (`team << 4 | type`).
+	static std::vector<uint8_t> packTiles(const Template& temp) {
+		std::vector<uint8_t> plane(temp.tiles().size());
+		packTiles(temp, plane.data());
+		return plane;
+	};
+	/// Unpacks a tile plane into template tiles.
+	///
+	/// @param temp Map template, already sized.
+	/// @param plane One byte per tile.
+	static void unpackTiles(Template& temp, const uint8_t* plane) {
+		sf::Vector2i size = temp.size();
+		for (int y = 0; y < size.y; y++) {
+			for (int x = 0; x < size.x; x++) {
+				uint8_t byte = *plane++;
+				HexBase& hex = temp.at(x, y);
+				hex.type = static_cast<Hex::Type>(byte & 0x3);
+				hex.team = static_cast<Region::Team>(byte >> 4);
+
+				// validate data
+				if (hex.team >= Region::Count)
+					hex.team = Region::Unclaimed;
+			};
+		};
 	};
 
 	/// Serializes a map template object.
-	sf::Packet& operator<<(sf::Packet& packet, const Template& temp) {
+	ByteWriter& operator<<(ByteWriter& writer, const Template& temp) {
 		// map header
-		packet << temp.header.name;
-		packet << temp.header.auth;
+		writer << temp.header.name;
+		writer << temp.header.auth;
 
 		// tile data
-		packet << temp.size();
+		writer << temp.size();
 		for (int y = 0; y < temp.size().y; y++)
 			for (int x = 0; x < temp.size().x; x++)
-				packet << temp.at(x, y);
+				writer << temp.at(x, y);
 
-		// entity lists
-		encodeVec(packet, temp.troops);
-		encodeVec(packet, temp.builds);
-		encodeVec(packet, temp.plants);
-
-		// region construction data
-		packet << (int)temp.regions.size();
-		for (const auto& rcd : temp.regions) {
-			packet << rcd.res;
-			packet << rcd.pos;
-		};
-		return packet;
+		encodeContents(writer, temp);
+		return writer;
 	};
 	/// Deserializes a map template object.
-	sf::Packet& operator>>(sf::Packet& packet, Template& temp) {
+	ByteReader& operator>>(ByteReader& reader, Template& temp) {
 		// map header
-		packet >> temp.header.name;
-		packet >> temp.header.auth;
+		reader >> temp.header.name;
+		reader >> temp.header.auth;
 
 		// tile data
-		sf::Vector2i size = from<sf::Vector2i>(packet);
+		sf::Vector2i size = from<sf::Vector2i>(reader);
+		if (size.x < 0 || size.y < 0 || (size_t)size.x * size.y > reader.remaining()) {
+			reader.fail();
+			return reader;
+		};
 		temp.clear(size);
 		for (int y = 0; y < size.y; y++)
 			for (int x = 0; x < size.x; x++)
-				packet >> temp.at(x, y);
-		
-		// entity lists
-		temp.troops = decodeVec<Troop>(packet);
-		temp.builds = decodeVec<Build>(packet);
-		temp.plants = decodeVec<Plant>(packet);
+				reader >> temp.at(x, y);
+
+		decodeContents(reader, temp);
+		return reader;
+	};
+
+	/// Serializes a map template with a compressed tile plane.
+	void encodeTemplate(ByteWriter& writer, const Template& temp) {
+		// map header
+		writer << temp.header.name;
+		writer << temp.header.auth;
+
+		// tile data
+		writer << temp.size();
+		TilePlane::encode(writer, packTiles(temp));
+
+		encodeContents(writer, temp);
+	};
+	/// Deserializes a map template with a compressed tile plane.
+	Template decodeTemplate(ByteReader& reader) {
+		Template temp;
+
+		// map header
+		reader >> temp.header.name;
+		reader >> temp.header.auth;
+
+		// tile data
+		sf::Vector2i size = from<sf::Vector2i>(reader);
+		if (size.x < 0 || size.y < 0 || (size_t)size.x * size.y > reader.remaining() * TilePlane::MaxRatio) {
+			reader.fail();
+			return temp;
+		};
+		std::vector<uint8_t> plane((size_t)size.x * size.y);
+		if (!TilePlane::decode(reader, plane)) return temp;
+		temp.clear(size);
+		unpackTiles(temp, plane.data());
+
+		decodeContents(reader, temp);
+		return temp;
+	};
+
+	/// Adds a chunk encoded in place.
+	///
+	/// Chunk size is found with a counting pass first,
+	/// then the encoder writes straight into the file contents.
+	///
+	/// @tparam F Chunk encoder type.
+	///
+	/// @param file Map file writer.
+	/// @param tag Chunk tag.
+	/// @param encode Chunk encoder, called with a byte writer.
+	template <typename F> static void writeChunk(MapFormat::Writer& file, uint32_t tag, F&& encode) {
+		size_t size = encodedSize(encode);
+		ByteWriter writer(std::span<uint8_t>(file.chunk(tag, size), size));
+		encode(writer);
+	};
+
+	/// Returns a reader over chunk contents.
+	///
+	/// @param view Map file view.
+	/// @param tag Chunk tag.
+	///
+	/// @return Chunk reader or nothing if there is no such chunk.
+	static std::optional<ByteReader> readChunk(const MapFormat::View& view, uint32_t tag) {
+		auto* chunk = view.chunk(tag);
+		if (!chunk) return {};
+		return ByteReader(chunk->data, chunk->size);
+	};
+
+	/// Encodes a map template into a chunked map file.
+	std::vector<uint8_t> encodeMapFile(const Template& temp) {
+		MapFormat::Writer file;
+
+		// map header
+		writeChunk(file, MapFormat::Info, [&](ByteWriter& writer) {
+			writer << temp.header.name;
+			writer << temp.header.auth;
+		});
+
+		// tile plane (stored raw, so loading can unpack it in place)
+		{
+			size_t count = temp.tiles().size();
+			uint8_t* data = file.chunk(MapFormat::Tiles, 9 + count);
+			MapFormat::write32(data, temp.size().x);
+			MapFormat::write32(data + 4, temp.size().y);
+			data[8] = TilePlane::Raw;
+			packTiles(temp, data + 9);
+		};
+
+		// entity tables
+		writeChunk(file, MapFormat::Entities, [&](ByteWriter& writer) {
+			encodeEntities(writer, temp);
+		});
 
 		// region construction data
-		int count = from<int>(packet);
+		writeChunk(file, MapFormat::Regions, [&](ByteWriter& writer) {
+			encodeRegions(writer, temp);
+		});
+		return file.finish();
+	};
+
+	/// Decodes a map template from a chunked map file.
+	std::optional<Template> decodeMapFile(const MapFormat::View& view) {
+		Template temp;
+
+		// map header
+		if (auto reader = readChunk(view, MapFormat::Info)) {
+			*reader >> temp.header.name;
+			*reader >> temp.header.auth;
+			if (!*reader) return {};
+		};
+
+		// tile plane
 		{
-			temp.regions.reserve(count);
-			for (int i = 0; i < count; i++) {
-				temp.regions.push_back({
-					from<RegionRes>(packet),
-					from<sf::Vector2i>(packet)
-				});
+			auto* chunk = view.chunk(MapFormat::Tiles);
+			if (!chunk || chunk->size < 8) return {};
+
+			// check plane size
+			uint32_t w = MapFormat::read32(chunk->data);
+			uint32_t h = MapFormat::read32(chunk->data + 4);
+			uint64_t count = (uint64_t)w * h;
+			uint64_t limit = chunk->size - 8;
+			if (view.version() >= 2) limit *= TilePlane::MaxRatio;
+			if (w > INT32_MAX || h > INT32_MAX || count > limit)
+				return {};
+
+			// raw plane in version 1 files
+			if (view.version() < 2) {
+				if (count != chunk->size - 8) return {};
+				temp.clear({ (int)w, (int)h });
+				unpackTiles(temp, chunk->data + 8);
+			}
+
+			// raw plane, unpacked in place
+			else if (chunk->size > 8 && chunk->data[8] == TilePlane::Raw) {
+				if (count != chunk->size - 9) return {};
+				temp.clear({ (int)w, (int)h });
+				unpackTiles(temp, chunk->data + 9);
+			}
+
+			// compressed plane
+			else {
+				std::vector<uint8_t> plane(count);
+				ByteReader reader(chunk->data + 8, chunk->size - 8);
+				if (!TilePlane::decode(reader, plane)) return {};
+				temp.clear({ (int)w, (int)h });
+				unpackTiles(temp, plane.data());
 			};
 		};
-		return packet;
+
+		// entity tables
+		if (auto reader = readChunk(view, MapFormat::Entities)) {
+			decodeEntities(*reader, temp);
+			if (!*reader) return {};
+		};
+
+		// region construction data
+		if (auto reader = readChunk(view, MapFormat::Regions)) {
+			decodeRegions(*reader, temp);
+			if (!*reader) return {};
+		};
+		return temp;
 	};
-};
+};
\ No newline at end of file
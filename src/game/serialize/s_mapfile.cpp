@@ -0,0 +1,156 @@
+#include "game/serialize/mapfile.hpp"
+#include <cstring>
+
+namespace MapFormat {
+	/// File signature.
+	static const uint8_t SIGN[4] = { 'h', 'e', 'x', '!' };
+
+	/// Header size.
+	static constexpr size_t HEADER = 12;
+	/// Chunk header size.
+	static constexpr size_t CHUNK = 8;
+	/// Footer size.
+	static constexpr size_t FOOTER = 4;
+
+	/// Returns size padded to 4 bytes.
+	///
+	/// @param size Unpadded size.
+	static size_t pad(size_t size) {
+		return (size + 3) & ~(size_t)3;
+	};
+
+	/// CRC-32 lookup tables.
+	///
+	/// Table `k` advances the CRC by `k` extra zero bytes,
+	/// so 4 bytes can be processed per step.
+	struct CrcTable {
+		uint32_t table[4][256];
+
+		/// Generates the tables.
+		CrcTable() {
+			for (uint32_t i = 0; i < 256; i++) {
+				uint32_t c = i;
+				for (int k = 0; k < 8; k++)
+					c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+				table[0][i] = c;
+			};
+			for (uint32_t i = 0; i < 256; i++) {
+				for (int k = 1; k < 4; k++)
+					table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xff];
+			};
+		};
+	};
+
+	/// Computes CRC-32 of a byte range.
+	uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc) {
+		static const CrcTable crc_table;
+		const auto& t = crc_table.table;
+
+		crc = ~crc;
+
+		// process 4 bytes at a time
+		while (size >= 4) {
+			crc ^= read32(data);
+			crc = t[3][crc & 0xff] ^ t[2][(crc >> 8) & 0xff]
+				^ t[1][(crc >> 16) & 0xff] ^ t[0][crc >> 24];
+			data += 4;
+			size -= 4;
+		};
+
+		// process remaining bytes
+		while (size--)
+			crc = t[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+		return ~crc;
+	};
+
+	/// Checks whether data starts with a chunked map file signature.
+	bool View::recognize(const uint8_t* data, size_t size) {
+		return size >= HEADER && memcmp(data, SIGN, 4) == 0;
+	};
+
+	/// Opens a view of map file contents.
+	bool View::open(const uint8_t* data, size_t size) {
+		_chunks.clear();
+		_version = 0;
+
+		// check signature & size
+		if (!recognize(data, size) || size < HEADER + FOOTER)
+			return false;
+
+		// check version
+		uint32_t version = read32(data + 4);
+		if (version == 0 || version > MapFormat::version)
+			return false;
+
+		// check checksum
+		size_t body = size - FOOTER;
+		if (crc32(data, body) != read32(data + body))
+			return false;
+
+		// read chunk table
+		uint32_t count = read32(data + 8);
+		size_t off = HEADER;
+		_chunks.reserve(count);
+		for (uint32_t i = 0; i < count; i++) {
+			// check chunk header bounds
+			if (body - off < CHUNK) return false;
+			Chunk chunk = {
+				.tag = read32(data + off),
+				.data = data + off + CHUNK,
+				.size = read32(data + off + 4)
+			};
+			off += CHUNK;
+
+			// check chunk payload bounds
+			if (body - off < pad(chunk.size)) return false;
+			off += pad(chunk.size);
+			_chunks.push_back(chunk);
+		};
+
+		_version = version;
+		return true;
+	};
+
+	/// Returns the first chunk with a tag.
+	const View::Chunk* View::chunk(uint32_t tag) const {
+		for (const Chunk& chunk : _chunks)
+			if (chunk.tag == tag)
+				return &chunk;
+		return nullptr;
+	};
+
+	/// Starts a new file.
+	Writer::Writer() : _data(HEADER) {
+		memcpy(_data.data(), SIGN, 4);
+		write32(_data.data() + 4, MapFormat::version);
+	};
+
+	/// Adds a chunk.
+	void Writer::chunk(uint32_t tag, const void* data, size_t size) {
+		uint8_t* payload = chunk(tag, size);
+		if (size) memcpy(payload, data, size);
+	};
+
+	/// Adds a chunk and returns its payload for writing.
+	uint8_t* Writer::chunk(uint32_t tag, size_t size) {
+		// write chunk header
+		size_t off = _data.size();
+		_data.resize(off + CHUNK + pad(size));
+		write32(_data.data() + off, tag);
+		write32(_data.data() + off + 4, (uint32_t)size);
+		_count++;
+		return _data.data() + off + CHUNK;
+	};
+
+	/// Finishes the file.
+	std::vector<uint8_t> Writer::finish() {
+		// write chunk count
+		write32(_data.data() + 8, _count);
+
+		// append checksum
+		uint32_t crc = crc32(_data.data(), _data.size());
+		_data.resize(_data.size() + FOOTER);
+		write32(_data.data() + _data.size() - FOOTER, crc);
+		return std::move(_data);
+	};
+};
@@ -2,55 +2,56 @@
 #include "game/serialize/map.hpp"
 
 namespace Serialize {
-	/// Writes player description to the packet.
-	sf::Packet& operator<<(sf::Packet& packet, const Messages::Player& plr) {
-		packet << plr.name;
-		packet << (uint8_t)plr.team;
-		return packet;
+	/// Writes player description to the writer.
+	ByteWriter& operator<<(ByteWriter& writer, const Messages::Player& plr) {
+		writer << plr.name;
+		writer << (uint8_t)plr.team;
+		return writer;
 	};
 
-	/// Reads player description from the packet.
-	sf::Packet& operator>>(sf::Packet& packet, Messages::Player& plr) {
-		packet >> plr.name;
-		plr.team = static_cast<Region::Team>(from<uint8_t>(packet));
-		return packet;
+	/// Reads player description from the reader.
+	ByteReader& operator>>(ByteReader& reader, Messages::Player& plr) {
+		reader >> plr.name;
+		plr.team = static_cast<Region::Team>(from<uint8_t>(reader));
+		return reader;
 	};
 
-	/// Writes an event message to the packet.
-	void encodeMessage(sf::Packet& packet, const Messages::Event& evt) {
+	/// Writes an event message to the writer.
+	void encodeMessage(ByteWriter& writer, const Messages::Event& evt) {
 		// game initialization
 		if (auto* data = std::get_if<Messages::Init>(&evt)) {
-			packet << (uint8_t)E_Init;
-			packet << data->temp;
-			encodeVec<Messages::Player>(packet, data->players);
+			writer << (uint8_t)E_Init;
+			encodeTemplate(writer, data->temp);
+			encodeVec<Messages::Player>(writer, data->players);
+			writer << data->seed << data->hash;
 		};
 		// game over
 		if (auto* data = std::get_if<Messages::End>(&evt)) {
-			packet << (uint8_t)E_End;
-			packet << data->id;
+			writer << (uint8_t)E_End;
+			writer << data->id;
 		};
 		// player select
 		if (auto* data = std::get_if<Messages::Select>(&evt)) {
-			packet << (uint8_t)E_Select;
-			packet << data->id;
-			packet << data->turn;
+			writer << (uint8_t)E_Select;
+			writer << data->id;
+			writer << data->turn;
 		};
 		// player ignore
 		if (auto* data = std::get_if<Messages::Ignore>(&evt)) {
-			packet << (uint8_t)E_Ignore;
-			packet << data->id;
+			writer << (uint8_t)E_Ignore;
+			writer << data->id;
 		};
 		// chat message
 		if (auto* data = std::get_if<Messages::Chat>(&evt)) {
-			packet << (uint8_t)E_Chat;
-			packet << data->text;
+			writer << (uint8_t)E_Chat;
+			writer << data->text;
 		};
 	};
 
-	/// Reads an event message from the packet.
-	std::optional<Messages::Event> decodeMessage(sf::Packet& packet) {
+	/// Reads an event message from the reader.
+	std::optional<Messages::Event> decodeMessage(ByteReader& reader) {
 		// get message type
-		auto type = from<uint8_t>(packet);
+		auto type = from<uint8_t>(reader);
 		if (type >= E_Count) return std::nullopt;
 
 		// read message data
@@ -58,29 +59,31 @@ namespace Serialize {
 			// game initialization
 			case E_Init: return Messages::Init
 			{
-				.temp = from<Template>(packet),
-				.players = decodeVec<Messages::Player>(packet)
+				.temp = decodeTemplate(reader),
+				.players = decodeVec<Messages::Player>(reader),
+				.seed = from<uint64_t>(reader),
+				.hash = from<uint64_t>(reader)
 			};
 			// game over
 			case E_End: return Messages::End
 			{
-				.id = from<uint32_t>(packet)
+				.id = from<uint32_t>(reader)
 			};
 			// player select
 			case E_Select: return Messages::Select
 			{
-				.id = from<uint32_t>(packet),
-				.turn = from<bool>(packet)
+				.id = from<uint32_t>(reader),
+				.turn = from<bool>(reader)
 			};
 			// player ignore
 			case E_Ignore: return Messages::Ignore
 			{
-				.id = from<uint32_t>(packet)
+				.id = from<uint32_t>(reader)
 			};
 			// chat message
 			case E_Chat: return Messages::Chat
 			{
-				.text = from<std::string>(packet)
+				.text = from<std::string>(reader)
 			};
 		};
 		return {};
@@ -1,196 +1,495 @@
 #include "game/serialize/moves.hpp"
 #include <iostream>
-#include <typeinfo>
-#include <cassert>
-
-/// Check if an instance of `move` is of subtype `T`, then store pointer into `data`.
-#define IF(T) if (auto* data = dynamic_cast<const T*>(move))
 
 namespace Serialize {
+	/// Move codec.
+	struct Codec {
+		/// Writes move fields.
+		void (*encode)(ByteWriter& writer, const Move* move);
+		/// Reads move fields.
+		Move* (*decode)(ByteReader& reader);
+	};
 
-	/// Encodes a move into a packet.
-	void encodeMove(sf::Packet& packet, const Move* move) {
-		// Encodes cooldown header (Safe)
-		uint8_t cd = static_cast<uint8_t>(move->skill_cooldown);
-		packet << cd;
+	/// Returns move as a specific move type.
+	///
+	/// @tparam T Move type.
+	///
+	/// @param move Move with a matching type tag.
+	template <typename T> static const T& as(const Move* move) {
+		return *static_cast<const T*>(move);
+	};
 
-		if (cd != 0) {
-			packet << move->skill_pos;
-			packet << static_cast<uint8_t>(move->skill_type);
-		};
+	/// Reads an effect type.
+	///
+	/// Fails the reader if the value is out of range.
+	static EffectType decodeEffect(ByteReader& reader) {
+		auto byte = from<uint8_t>(reader);
+		if (byte >= static_cast<int>(EffectType::Count))
+			reader.fail();
+		return static_cast<EffectType>(byte);
+	};
 
-		// -----------------------------------------------------------
-		// ENCODING IS LEFT-TO-RIGHT.
-		// DECODING MUST BE STRICTLY LEFT-TO-RIGHT TOO.
-		// -----------------------------------------------------------
+	/// Reads a region team.
+	///
+	/// Fails the reader if the value is out of range.
+	static Region::Team decodeTeam(ByteReader& reader) {
+		auto byte = from<uint8_t>(reader);
+		if (byte >= Region::Count)
+			reader.fail();
+		return static_cast<Region::Team>(byte);
+	};
 
-		// --- Entity Moves ---
-		IF(Moves::EntityPlace) {
-			packet << (uint8_t)M_EntityPlace;
-			packet << data->entity; 
-			packet << data->var;    
-		}
-		else IF(Moves::EntityWithdraw) {
-			packet << (uint8_t)M_EntityWithdraw;
-			packet << data->pos;
-		}
-		else IF(Moves::EntityEffect) {
-			packet << (uint8_t)M_EntityEffect;
-			packet << data->pos;
-			packet << static_cast<uint8_t>(data->effect);
-			packet << static_cast<int32_t>(data->peach);
+	/// Codec for moves storing only a target position.
+	///
+	/// @tparam T Move type, constructible from a position.
+	template <typename T> static constexpr Codec position_codec = {
+		[](ByteWriter& writer, const Move* move) {
+			encodePos(writer, as<T>(move).dest);
+		},
+		[](ByteReader& reader) -> Move* {
+			return new T(decodePos(reader));
 		}
+	};
 
-		// --- Troop Moves ---
-		else IF(Moves::TroopAttack) {
-			packet << (uint8_t)M_TroopAttack;
-			packet << data->dest;
-		}
-		else IF(Moves::TroopMove) {
-			packet << (uint8_t)M_TroopMove;
-			packet << data->dest;
-		}
-		else IF(Moves::TroopHeal) {
-			packet << (uint8_t)M_TroopHeal;
-			packet << static_cast<sf::Vector2i>(data->mid);
-			packet << static_cast<uint64_t>(data->radius);
-			packet << static_cast<int32_t>(data->heal);
-			packet << static_cast<uint8_t>(data->team);
-		}
+	/// Codec of every move type, indexed by move type.
+	///
+	/// Fields are read into temporaries first,
+	/// as argument evaluation order is unspecified.
+	static const Codec codecs[M_Count] = {
+		// M_EntityPlace
+		{
+			[](ByteWriter& writer, const Move* move) {
+				writer << as<Moves::EntityPlace>(move).entity;
+				writer << as<Moves::EntityPlace>(move).var;
+			},
+			[](ByteReader& reader) -> Move* {
+				auto ent = from<Moves::EntState>(reader);
+				auto var = from<RegionVar>(reader);
+				return new Moves::EntityPlace(std::move(ent), var);
+			}
+		},
+		// M_EntityWithdraw
+		{
+			[](ByteWriter& writer, const Move* move) {
+				encodePos(writer, as<Moves::EntityWithdraw>(move).pos);
+			},
+			[](ByteReader& reader) -> Move* {
+				return new Moves::EntityWithdraw(decodePos(reader));
+			}
+		},
+		// M_EntityEffect
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& data = as<Moves::EntityEffect>(move);
+				encodePos(writer, data.pos);
+				writer << static_cast<uint8_t>(data.effect);
+				encodeVarInt(writer, data.peach);
+			},
+			[](ByteReader& reader) -> Move* {
+				auto pos = decodePos(reader);
+				auto effect = decodeEffect(reader);
+				auto peach = (int)decodeVarInt(reader);
+				if (!reader) return nullptr;
+				return new Moves::EntityEffect(pos, effect, peach);
+			}
+		},
+		// M_TroopMove
+		position_codec<Moves::TroopMove>,
+		// M_TroopMerge
+		position_codec<Moves::TroopMerge>,
+		// M_TroopAttack
+		position_codec<Moves::TroopAttack>,
+		// M_TroopHeal
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& data = as<Moves::TroopHeal>(move);
+				encodePos(writer, data.mid);
+				encodeVar(writer, data.radius);
+				encodeVarInt(writer, data.heal);
+				writer << static_cast<uint8_t>(data.team);
+			},
+			[](ByteReader& reader) -> Move* {
+				auto mid = decodePos(reader);
+				auto radius = (size_t)decodeVar(reader);
+				auto heal = (int)decodeVarInt(reader);
+				auto team = decodeTeam(reader);
+				if (!reader) return nullptr;
+				return new Moves::TroopHeal(mid, radius, heal, team);
+			}
+		},
+		// M_RadiusEffect
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& data = as<Moves::RadiusEffect>(move);
+				encodePos(writer, data.mid);
+				encodeVar(writer, data.radius);
+				writer << static_cast<uint8_t>(data.effect);
+				writer << static_cast<uint8_t>(data.team);
+			},
+			[](ByteReader& reader) -> Move* {
+				auto mid = decodePos(reader);
+				auto radius = (size_t)decodeVar(reader);
+				auto effect = decodeEffect(reader);
+				auto team = decodeTeam(reader);
+				if (!reader) return nullptr;
+				return new Moves::RadiusEffect(mid, radius, effect, team);
+			}
+		},
+		// M_PlantCut
+		{
+			[](ByteWriter& writer, const Move* move) {
+				encodePos(writer, as<Moves::PlantCut>(move).pos);
+			},
+			[](ByteReader& reader) -> Move* {
+				return new Moves::PlantCut(decodePos(reader));
+			}
+		},
+		// M_PlantMod
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& data = as<Moves::PlantMod>(move);
+				encodePos(writer, data.mid);
+				encodeVar(writer, data.radius);
+			},
+			[](ByteReader& reader) -> Move* {
+				auto mid = decodePos(reader);
+				auto radius = (size_t)decodeVar(reader);
+				return new Moves::PlantMod(mid, radius);
+			}
+		},
+		// M_EntityChange
+		{
+			[](ByteWriter& writer, const Move* move) {
+				writer << as<Moves::EntityChange>(move).state;
+			},
+			[](ByteReader& reader) -> Move* {
+				auto* move = new Moves::EntityChange({});
+				move->state = from<Moves::EntState>(reader);
+				return move;
+			}
+		},
+		// M_RegionChange
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& data = as<Moves::RegionChange>(move);
+				encodePos(writer, data.pos);
+				writer << data.state.res();
+				writer << data.state.var();
+				writer << data.state.dead;
+			},
+			[](ByteReader& reader) -> Move* {
+				auto pos = decodePos(reader);
+				auto res = from<RegionRes>(reader);
+				auto var = from<RegionVar>(reader);
+				auto dead = from<bool>(reader);
 
-		// --- Plant Moves ---
-		else IF(Moves::PlantCut) {
-			packet << (uint8_t)M_PlantCut;
-			packet << data->pos;
-		}
-		else IF(Moves::PlantMod) {
-			packet << (uint8_t)M_PlantMod;
-			packet << static_cast<sf::Vector2i>(data->mid);
-			packet << static_cast<uint64_t>(data->radius);
-		}
+				auto* move = new Moves::RegionChange(pos, {});
+				move->state = { res, var, dead };
+				return move;
+			}
+		},
+	};
 
-		// --- Building / Global Moves ---
-		else IF(Moves::RadiusEffect) {
-			packet << (uint8_t)M_RadiusEffect;
-			packet << static_cast<sf::Vector2i>(data->mid);
-			packet << static_cast<uint64_t>(data->radius);
-			packet << static_cast<uint8_t>(data->effect);
-			packet << static_cast<uint8_t>(data->team);
-		}
+	/// Encodes a move.
+	void encodeMove(ByteWriter& writer, const Move* move) {
+		// skill header, only for moves with a cooldown
+		writer << move->skill_cooldown;
+		if (move->skill_cooldown) {
+			encodePos(writer, move->skill_pos);
+			writer << static_cast<uint8_t>(move->skill_type);
+		};
 
-		// --- State Changes ---
-		else IF(Moves::EntityChange) {
-			packet << (uint8_t)M_EntityChange;
-			packet << data->state;
-		}
-		else IF(Moves::RegionChange) {
-			packet << (uint8_t)M_RegionChange;
-			packet << data->state.res();
-			packet << data->state.var();
-			packet << data->state.dead;
-		}
-		else {
-			std::cerr << "CRITICAL: Unknown move type in encodeMove: " 
-					  << typeid(*move).name() << std::endl;
-			assert(false && "Unknown move type serialization");
-		}
+		// move type & fields
+		auto type = move->type();
+		writer << static_cast<uint8_t>(type);
+		codecs[type].encode(writer, move);
 	};
 
-	/// Decodes a move from a packet.
-	std::unique_ptr<Move> decodeMove(sf::Packet& packet) {
-		auto cd = from<uint8_t>(packet);
-		sf::Vector2i pos = cd ? from<sf::Vector2i>(packet) : sf::Vector2i();
-		uint8_t tex = cd ? from<uint8_t>(packet) : 0;
-
-		if (tex >= Skills::Count) return {};
-
-		auto type = from<uint8_t>(packet);
-		if (type >= M_Count) return {};
-
-		Move* res = nullptr;
-		
-		// -------------------------------------------------------------
-		// FIX: Force read order by using temporary variables.
-		// Function arguments `new T(from(p), from(p))` order is UNDEFINED.
-		// -------------------------------------------------------------
-		
-		switch (type) {
-			case M_EntityPlace: {
-				auto ent = from<Moves::EntState>(packet); // Read 1st
-				auto var = from<RegionVar>(packet);       // Read 2nd
-				res = new Moves::EntityPlace(std::move(ent), var);
-			} break;
-
-			case M_EntityWithdraw: {
-				// Only 1 arg, safe.
-				res = new Moves::EntityWithdraw(from<sf::Vector2i>(packet));
-			} break;
-
-			case M_EntityEffect: {
-				auto p = from<sf::Vector2i>(packet);
-				auto e = static_cast<EffectType>(from<uint8_t>(packet));
-				auto v = from<int>(packet);
-				res = new Moves::EntityEffect(p, e, v);
-			} break;
-
-			case M_TroopMove: {
-				res = new Moves::TroopMove(from<sf::Vector2i>(packet));
-			} break;
-
-			case M_TroopAttack: {
-				res = new Moves::TroopAttack(from<sf::Vector2i>(packet));
-			} break;
-
-			case M_TroopHeal: {
-				auto mid  = from<sf::Vector2i>(packet);
-				auto rad  = from<size_t>(packet); // Ensure size_t matches uint64_t from writer
-				auto heal = from<int>(packet);
-				auto team = static_cast<Region::Team>(from<uint8_t>(packet));
-				res = new Moves::TroopHeal(mid, rad, heal, team);
-			} break;
-
-			case M_RadiusEffect: {
-				auto mid  = from<sf::Vector2i>(packet);
-				auto rad  = from<size_t>(packet);
-				auto eff  = static_cast<EffectType>(from<uint8_t>(packet));
-				auto team = static_cast<Region::Team>(from<uint8_t>(packet));
-				res = new Moves::RadiusEffect(mid, rad, eff, team);
-			} break;
-
-			case M_PlantCut: {
-				res = new Moves::PlantCut(from<sf::Vector2i>(packet));
-			} break;
-
-			case M_PlantMod: {
-				auto mid = from<sf::Vector2i>(packet);
-				auto rad = from<size_t>(packet);
-				res = new Moves::PlantMod(mid, rad);
-			} break;
-			
-			case M_EntityChange: {
-				auto* move = new Moves::EntityChange({});
-				move->state = from<Moves::EntState>(packet);
-				res = move;
-			}; break;
+	/// Decodes a move.
+	std::unique_ptr<Move> decodeMove(ByteReader& reader) {
+		// read skill header
+		auto cd = from<uint8_t>(reader);
+		sf::Vector2i pos = cd ? decodePos(reader) : sf::Vector2i();
+		uint8_t skill = cd ? from<uint8_t>(reader) : 0;
+		if (skill >= Skills::Count) return {};
 
-			case M_RegionChange: {
-				// Initializer lists {} guarantee left-to-right evaluation order
-				// so this block was actually okay, but let's keep it consistent.
-				auto r = from<RegionRes>(packet);
-				auto v = from<RegionVar>(packet);
-				auto d = from<bool>(packet);
+		// read move type
+		auto type = from<uint8_t>(reader);
+		if (!reader || type >= M_Count) {
+			std::cerr << "[ERROR] Invalid move type in data: " << (int)type << std::endl;
+			return {};
+		};
 
-				auto* move = new Moves::RegionChange(pos, {});
-				move->state = { r, v, d };
-				res = move;
-			}; break;
+		// read move fields
+		std::unique_ptr<Move> move(codecs[type].decode(reader));
+		if (!reader) return {};
+		if (cd) {
+			move->skill_pos = pos;
+			move->skill_type = static_cast<Skills::Type>(skill);
+			move->skill_cooldown = cd;
 		};
+		return move;
+	};
 
-		if (res) {
-			res->skill_pos = pos;
-			res->skill_type = static_cast<Skills::Type>(tex);
-			res->skill_cooldown = cd;
+	/// Reads a move header without decoding move fields.
+	MoveType peekMove(ByteReader& reader, uint8_t& cooldown) {
+		// skip skill header
+		cooldown = from<uint8_t>(reader);
+		if (cooldown) {
+			decodePos(reader);
+			if (from<uint8_t>(reader) >= Skills::Count) return M_Count;
 		};
-		return std::unique_ptr<Move>(res);
+
+		// read move type
+		auto type = from<uint8_t>(reader);
+		if (!reader || type >= M_Count) return M_Count;
+		return static_cast<MoveType>(type);
+	};
+
+	/// Applied state codec.
+	struct StateCodec {
+		/// Writes applied move fields.
+		void (*encode)(ByteWriter& writer, const Move* move);
+		/// Reads applied move fields back into a move.
+		void (*decode)(ByteReader& reader, Move* move);
+	};
+
+	/// Returns move as a specific mutable move type.
+	///
+	/// @tparam T Move type.
+	///
+	/// @param move Move with a matching type tag.
+	template <typename T> static T& into(Move* move) {
+		return *static_cast<T*>(move);
+	};
+
+	/// Writes a plant with its growth timers.
+	///
+	/// Timers are not a part of the plant encoding,
+	/// but a reverted move has to bring them back.
+	static void storePlant(ByteWriter& writer, const Plant& plant) {
+		writer << plant;
+		writer << plant.stage << plant.spread << plant.fresh;
+	};
+	/// Reads a plant with its growth timers.
+	static Plant restorePlant(ByteReader& reader) {
+		auto plant = from<Plant>(reader);
+		reader >> plant.stage >> plant.spread >> plant.fresh;
+		return plant;
+	};
+
+	/// Writes an entity state, plants with their growth timers.
+	static void storeEntity(ByteWriter& writer, const Moves::EntState& entity) {
+		writer << entity;
+		if (auto* plant = std::get_if<Plant>(&entity))
+			writer << plant->stage << plant->spread << plant->fresh;
+	};
+	/// Reads an entity state, plants with their growth timers.
+	static Moves::EntState restoreEntity(ByteReader& reader) {
+		auto entity = from<Moves::EntState>(reader);
+		if (auto* plant = std::get_if<Plant>(&entity))
+			reader >> plant->stage >> plant->spread >> plant->fresh;
+		return entity;
+	};
+
+	/// Reads a list length.
+	///
+	/// Fails the reader if the list could not fit in the remaining data.
+	static size_t decodeCount(ByteReader& reader) {
+		auto count = (size_t)decodeVar(reader);
+		if (count > reader.remaining()) {
+			reader.fail();
+			return 0;
+		};
+		return count;
+	};
+
+	/// Applied state codec of every move type, indexed by move type.
+	static const StateCodec states[M_Count] = {
+		// M_EntityPlace
+		{
+			[](ByteWriter&, const Move*) {},
+			[](ByteReader&, Move*) {}
+		},
+		// M_EntityWithdraw
+		{
+			[](ByteWriter& writer, const Move* move) {
+				storeEntity(writer, as<Moves::EntityWithdraw>(move).a_state);
+			},
+			[](ByteReader& reader, Move* move) {
+				into<Moves::EntityWithdraw>(move).a_state = restoreEntity(reader);
+			}
+		},
+		// M_EntityEffect
+		{
+			[](ByteWriter& writer, const Move* move) {
+				writer << as<Moves::EntityEffect>(move).a_before;
+			},
+			[](ByteReader& reader, Move* move) {
+				reader >> into<Moves::EntityEffect>(move).a_before;
+			}
+		},
+		// M_TroopMove
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& prev = as<Moves::TroopMove>(move).a_state;
+				writer << static_cast<uint8_t>(prev.team);
+				writer << prev.resources;
+				storeEntity(writer, prev.entity);
+				encodeVar(writer, prev.split.size());
+				for (const RegionRes& res : prev.split)
+					writer << res;
+				writer << static_cast<uint8_t>(prev.oth_skill);
+			},
+			[](ByteReader& reader, Move* move) {
+				auto& prev = into<Moves::TroopMove>(move).a_state;
+				prev.team = decodeTeam(reader);
+				prev.resources = from<RegionRes>(reader);
+				prev.entity = restoreEntity(reader);
+				prev.split.resize(decodeCount(reader));
+				for (RegionRes& res : prev.split)
+					res = from<RegionRes>(reader);
+				auto skill = from<uint8_t>(reader);
+				if (skill >= Skills::Count) reader.fail();
+				prev.oth_skill = static_cast<Skills::Type>(skill);
+			}
+		},
+		// M_TroopMerge
+		{
+			[](ByteWriter& writer, const Move* move) {
+				writer << as<Moves::TroopMerge>(move).a_prev[0];
+				writer << as<Moves::TroopMerge>(move).a_prev[1];
+			},
+			[](ByteReader& reader, Move* move) {
+				auto& data = into<Moves::TroopMerge>(move);
+				data.a_prev[0] = from<Troop>(reader);
+				data.a_prev[1] = from<Troop>(reader);
+			}
+		},
+		// M_TroopAttack
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& data = as<Moves::TroopAttack>(move);
+				encodeVarInt(writer, data.a_dmg.pts);
+				encodeVarInt(writer, data.a_dmg.pow);
+				writer << data.a_dmg.psn;
+				storeEntity(writer, data.a_state);
+				encodeVar(writer, data.a_eff.size());
+				for (EffectType eff : data.a_eff)
+					writer << static_cast<uint8_t>(eff);
+			},
+			[](ByteReader& reader, Move* move) {
+				auto& data = into<Moves::TroopAttack>(move);
+				data.a_dmg.pts = (int)decodeVarInt(reader);
+				data.a_dmg.pow = (int)decodeVarInt(reader);
+				reader >> data.a_dmg.psn;
+				data.a_state = restoreEntity(reader);
+				data.a_eff.resize(decodeCount(reader));
+				for (EffectType& eff : data.a_eff)
+					eff = decodeEffect(reader);
+			}
+		},
+		// M_TroopHeal
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& data = as<Moves::TroopHeal>(move);
+				encodeVar(writer, data.a_target.size());
+				for (const auto& target : data.a_target) {
+					encodePos(writer, target.pos);
+					encodeVarInt(writer, target.hp_before);
+				};
+				encodeVarInt(writer, data.a_cost);
+			},
+			[](ByteReader& reader, Move* move) {
+				auto& data = into<Moves::TroopHeal>(move);
+				data.a_target.resize(decodeCount(reader));
+				for (auto& target : data.a_target) {
+					target.pos = decodePos(reader);
+					target.hp_before = (int)decodeVarInt(reader);
+				};
+				data.a_cost = (int)decodeVarInt(reader);
+			}
+		},
+		// M_RadiusEffect
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& data = as<Moves::RadiusEffect>(move);
+				encodeVar(writer, data.a_target.size());
+				for (sf::Vector2i pos : data.a_target)
+					encodePos(writer, pos);
+			},
+			[](ByteReader& reader, Move* move) {
+				auto& data = into<Moves::RadiusEffect>(move);
+				data.a_target.resize(decodeCount(reader));
+				for (sf::Vector2i& pos : data.a_target)
+					pos = decodePos(reader);
+			}
+		},
+		// M_PlantCut
+		{
+			[](ByteWriter& writer, const Move* move) {
+				storePlant(writer, as<Moves::PlantCut>(move).a_state);
+			},
+			[](ByteReader& reader, Move* move) {
+				into<Moves::PlantCut>(move).a_state = restorePlant(reader);
+			}
+		},
+		// M_PlantMod
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& data = as<Moves::PlantMod>(move);
+				writer << data.a_res;
+				encodeVar(writer, data.a_target.size());
+				for (const Plant& plant : data.a_target)
+					storePlant(writer, plant);
+			},
+			[](ByteReader& reader, Move* move) {
+				auto& data = into<Moves::PlantMod>(move);
+				data.a_res = from<RegionRes>(reader);
+				data.a_target.resize(decodeCount(reader));
+				for (Plant& plant : data.a_target)
+					plant = restorePlant(reader);
+			}
+		},
+		// M_EntityChange
+		{
+			[](ByteWriter& writer, const Move* move) {
+				storeEntity(writer, as<Moves::EntityChange>(move).a_prev);
+			},
+			[](ByteReader& reader, Move* move) {
+				into<Moves::EntityChange>(move).a_prev = restoreEntity(reader);
+			}
+		},
+		// M_RegionChange
+		{
+			[](ByteWriter& writer, const Move* move) {
+				const auto& prev = as<Moves::RegionChange>(move).a_prev;
+				writer << prev.res();
+				writer << prev.var();
+				writer << prev.dead;
+			},
+			[](ByteReader& reader, Move* move) {
+				auto res = from<RegionRes>(reader);
+				auto var = from<RegionVar>(reader);
+				auto dead = from<bool>(reader);
+				into<Moves::RegionChange>(move).a_prev = { res, var, dead };
+			}
+		},
+	};
+
+	/// Encodes applied state of a move.
+	void encodeApplied(ByteWriter& writer, const Move* move) {
+		// skill origin of moves without a cooldown is not a part of the move encoding
+		if (!move->skill_cooldown)
+			encodePos(writer, move->skill_pos);
+		states[move->type()].encode(writer, move);
+	};
+
+	/// Decodes applied state of a move.
+	bool decodeApplied(ByteReader& reader, Move* move) {
+		if (!move->skill_cooldown)
+			move->skill_pos = decodePos(reader);
+		states[move->type()].decode(reader, move);
+		return (bool)reader;
 	};
 };
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include "game/serialize/tileplane.hpp"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <queue>
+
+namespace TilePlane {
+	using Serialize::ByteReader;
+	using Serialize::ByteWriter;
+
+	/// Longest run stored in a single token.
+	static constexpr size_t MaxRun = 256;
+	/// Size of the code length table (two lengths per byte).
+	static constexpr size_t LengthBytes = 128;
+
+	/// Code length of every symbol.
+	using Lengths = std::array<uint8_t, 256>;
+	/// Code of every symbol.
+	using Codes = std::array<uint16_t, 256>;
+
+	/// Decoding table entry.
+	struct Entry {
+		uint8_t symbol = 0; /// Decoded symbol.
+		uint8_t length = 0; /// Code length (0 if the code is unused).
+	};
+
+	/// Splits a plane into run tokens.
+	///
+	/// @param plane Plane bytes.
+	///
+	/// @return Token bytes.
+	static std::vector<uint8_t> tokenize(std::span<const uint8_t> plane) {
+		std::vector<uint8_t> tokens;
+		size_t i = 0;
+		while (i < plane.size()) {
+			uint8_t byte = plane[i];
+			size_t run = 1;
+			while (run < MaxRun && i + run < plane.size() && plane[i + run] == byte)
+				run++;
+
+			tokens.push_back(byte);
+			tokens.push_back((uint8_t)(run - 1));
+			i += run;
+		};
+		return tokens;
+	};
+
+	/// Expands run tokens into a plane.
+	///
+	/// @param tokens Token bytes.
+	/// @param size Token byte count.
+	/// @param plane Target plane.
+	///
+	/// @return Whether the tokens cover the plane exactly.
+	static bool expand(const uint8_t* tokens, size_t size, std::span<uint8_t> plane) {
+		if (size % 2) return false;
+
+		size_t at = 0;
+		for (size_t i = 0; i < size; i += 2) {
+			size_t run = (size_t)tokens[i + 1] + 1;
+			if (run > plane.size() - at) return false;
+			std::fill_n(plane.data() + at, run, tokens[i]);
+			at += run;
+		};
+		return at == plane.size();
+	};
+
+	/// Computes Huffman code lengths, limited to `MaxBits`.
+	///
+	/// If the tree is too deep, weights are flattened and it is rebuilt.
+	///
+	/// @param freq Symbol frequencies.
+	static Lengths codeLengths(const std::array<uint64_t, 256>& freq) {
+		using Item = std::pair<uint64_t, int>;
+		std::array<uint64_t, 256> weight = freq;
+
+		while (true) {
+			Lengths lengths = {};
+
+			// queue used symbols
+			std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+			for (int s = 0; s < 256; s++) {
+				if (weight[s]) queue.push({ weight[s], s });
+			};
+			if (queue.empty()) return lengths;
+			if (queue.size() == 1) {
+				lengths[queue.top().second] = 1;
+				return lengths;
+			};
+
+			// merge lightest nodes (inner nodes are numbered from 256)
+			std::array<int, 511> parent;
+			parent.fill(-1);
+			int next = 256;
+			while (queue.size() > 1) {
+				Item a = queue.top(); queue.pop();
+				Item b = queue.top(); queue.pop();
+				parent[a.second] = next;
+				parent[b.second] = next;
+				queue.push({ a.first + b.first, next++ });
+			};
+
+			// get leaf depths
+			int longest = 0;
+			for (int s = 0; s < 256; s++) {
+				if (!weight[s]) continue;
+				int depth = 0;
+				for (int n = s; parent[n] >= 0; n = parent[n])
+					depth++;
+				lengths[s] = (uint8_t)depth;
+				longest = std::max(longest, depth);
+			};
+			if (longest <= MaxBits) return lengths;
+
+			// flatten weights
+			for (auto& w : weight) {
+				if (w) w = w / 2 + 1;
+			};
+		};
+	};
+
+	/// Assigns canonical codes to code lengths.
+	///
+	/// Codes are given in order of length, then symbol.
+	///
+	/// @param lengths Symbol code lengths.
+	/// @param codes Target codes.
+	///
+	/// @return Whether the lengths form a valid prefix code.
+	static bool canonical(const Lengths& lengths, Codes& codes) {
+		uint32_t code = 0;
+		for (int len = 1; len <= MaxBits; len++) {
+			for (int s = 0; s < 256; s++) {
+				if (lengths[s] != len) continue;
+				if (code >= 1u << len) return false;
+				codes[s] = (uint16_t)code++;
+			};
+			code <<= 1;
+		};
+		return true;
+	};
+
+	/// Writes tokens as a bit stream.
+	///
+	/// @param tokens Token bytes.
+	/// @param lengths Symbol code lengths.
+	/// @param codes Symbol codes.
+	///
+	/// @return Bit stream bytes.
+	static std::vector<uint8_t> pack(const std::vector<uint8_t>& tokens, const Lengths& lengths, const Codes& codes) {
+		std::vector<uint8_t> data;
+		data.reserve(tokens.size() / 2);
+
+		uint64_t bits = 0;
+		int count = 0;
+		for (uint8_t s : tokens) {
+			bits = bits << lengths[s] | codes[s];
+			count += lengths[s];
+			while (count >= 8) {
+				count -= 8;
+				data.push_back((uint8_t)(bits >> count));
+			};
+		};
+		if (count) data.push_back((uint8_t)(bits << (8 - count)));
+		return data;
+	};
+
+	/// Reads tokens from a bit stream.
+	///
+	/// @param data Bit stream bytes.
+	/// @param size Bit stream byte count.
+	/// @param table Decoding table.
+	/// @param tokens Target tokens.
+	///
+	/// @return Whether all tokens were read from valid codes.
+	static bool unpack(const uint8_t* data, size_t size, const std::vector<Entry>& table, std::vector<uint8_t>& tokens) {
+		constexpr uint64_t mask = (1u << MaxBits) - 1;
+
+		uint64_t bits = 0;
+		int avail = 0;
+		size_t at = 0;
+		size_t used = 0;
+		for (uint8_t& token : tokens) {
+			// refill bits (zeros past the end)
+			while (avail <= 56) {
+				bits = bits << 8 | (at < size ? data[at] : 0);
+				at++;
+				avail += 8;
+			};
+
+			// look up the next code
+			Entry entry = table[(bits >> (avail - MaxBits)) & mask];
+			if (!entry.length) return false;
+			avail -= entry.length;
+			used += entry.length;
+			token = entry.symbol;
+		};
+		return used <= size * 8;
+	};
+
+	/// Encodes a tile plane with the smallest method.
+	Method encode(ByteWriter& writer, std::span<const uint8_t> plane) {
+		auto tokens = tokenize(plane);
+
+		// build token code
+		std::array<uint64_t, 256> freq = {};
+		for (uint8_t s : tokens)
+			freq[s]++;
+		Lengths lengths = codeLengths(freq);
+		Codes codes = {};
+		canonical(lengths, codes);
+		auto bits = pack(tokens, lengths, codes);
+
+		// pick the smallest method
+		size_t raw = plane.size();
+		size_t runs = 4 + tokens.size();
+		size_t huff = 4 + LengthBytes + 4 + bits.size();
+		Method method = Raw;
+		if (runs < raw) method = Runs;
+		if (huff < std::min(raw, runs)) method = Huffman;
+
+		// write plane
+		writer << (uint8_t)method;
+		if (method == Raw) {
+			writer.write(plane.data(), plane.size());
+		}
+		else if (method == Runs) {
+			writer << (uint32_t)tokens.size();
+			writer.write(tokens.data(), tokens.size());
+		}
+		else {
+			writer << (uint32_t)tokens.size();
+			for (size_t i = 0; i < 256; i += 2)
+				writer << (uint8_t)(lengths[i] << 4 | lengths[i + 1]);
+			writer << (uint32_t)bits.size();
+			writer.write(bits.data(), bits.size());
+		};
+		return method;
+	};
+
+	/// Decodes a huffman coded plane.
+	///
+	/// @param reader Source reader.
+	/// @param plane Target plane.
+	///
+	/// @return Whether the plane was valid.
+	static bool decodeHuffman(ByteReader& reader, std::span<uint8_t> plane) {
+		uint32_t count = 0, size = 0;
+		reader >> count;
+		const uint8_t* packed = reader.take(LengthBytes);
+		reader >> size;
+		const uint8_t* data = reader.take(size);
+		if (!reader) return false;
+
+		// every token takes at least a bit and covers at most half a run
+		if (count > (size_t)size * 8 || count > plane.size() * 2)
+			return false;
+
+		// read code lengths
+		Lengths lengths;
+		for (size_t i = 0; i < LengthBytes; i++) {
+			lengths[i * 2] = packed[i] >> 4;
+			lengths[i * 2 + 1] = packed[i] & 0xF;
+		};
+		for (uint8_t len : lengths) {
+			if (len > MaxBits) return false;
+		};
+
+		// build decoding table
+		Codes codes = {};
+		if (!canonical(lengths, codes)) return false;
+		std::vector<Entry> table(1 << MaxBits);
+		for (int s = 0; s < 256; s++) {
+			if (!lengths[s]) continue;
+			int shift = MaxBits - lengths[s];
+			std::fill_n(
+				table.begin() + ((size_t)codes[s] << shift),
+				(size_t)1 << shift,
+				Entry{ (uint8_t)s, lengths[s] }
+			);
+		};
+
+		// decode tokens
+		std::vector<uint8_t> tokens(count);
+		if (!unpack(data, size, table, tokens)) return false;
+		return expand(tokens.data(), tokens.size(), plane);
+	};
+
+	/// Decodes a tile plane.
+	bool decode(ByteReader& reader, std::span<uint8_t> plane) {
+		uint8_t method = Count;
+		reader >> method;
+
+		bool valid = false;
+		if (method == Raw) {
+			valid = reader.read(plane.data(), plane.size());
+		}
+		else if (method == Runs) {
+			uint32_t size = 0;
+			reader >> size;
+			const uint8_t* tokens = reader.take(size);
+			valid = reader && expand(tokens, size, plane);
+		}
+		else if (method == Huffman) {
+			valid = decodeHuffman(reader, plane);
+		};
+
+		if (!valid) reader.fail();
+		return valid;
+	};
+};
@@ -1,5 +1,4 @@
 #include "game/spread.hpp"
-#include <list>
 
 /// Default spread check.
 bool Spread::default_check(const Tile&) { return true; };
@@ -9,150 +8,112 @@ void Spread::default_effect(const Tile&) {};
 std::optional<size_t> Spread::default_radius(const Tile&) { return {}; };
 
 /// Default last spread index.
-size_t Spread::_last_idx[2] = { 0, 0 };
-
-/// Resets spread index.
-void Spread::reset() {
-	_last_idx[0] = 0;
-	_last_idx[1] = 0;
-};
+std::atomic<size_t> Spread::_last_idx[2] = { 0, 0 };
 
 /// Generates a unique spread index.
-size_t Spread::index(bool alt) {
-	return ++_last_idx[alt];
+size_t Spread::index(bool alt, size_t count) {
+	return _last_idx[alt].fetch_add(count, std::memory_order_relaxed) + 1;
 };
 
-/// Adds neighboring tiles to spread queue.
-/// 
-/// @param queue Spread queue.
-/// @param hop Blocking spread check.
-/// @param array Tile array.
-/// @param index Spread index.
-/// @param tile Processed tile.
-/// @param alt Whether to use alternative index.
-static inline void _spread(
-	std::list<Spread::Tile>& queue,
-	const HexArray& array,
-	const Spread::Check& hop,
-	size_t index,
-	const Spread::Tile& tile,
-	bool alt
-) {
-	// ignore if no range left
-	if (tile.left == 0) return;
-
-	// spread to each neighbor
-	for (int i = 0; i < 6; i++) {
-		// next tile info
-		Spread::Tile next = {
-			array.atref(
-				array.neighbor(tile.pos, static_cast<HexArray::nbi_t>(i))
-			),
-			tile.left - 1
-		};
-
-		// discard if outside the map
-		if (!next.hex) continue;
-
-		// mark as visited
-		if (next.hex->spread[alt] != index)
-			next.hex->spread[alt] = index;
-		else continue;
-
-		// queue tile if passes blocking check
-		if (hop(next))
-			queue.push_back(next);
-	};
-};
+/// Ensures the queue can store a specific amount of tiles.
+void Spread::Frontier::reserve(size_t count) {
+	// ignore if already large enough
+	if (count <= _buf.size()) return;
 
-/// Applies the spread.
-size_t Spread::apply(const HexArray& array, sf::Vector2i pos, size_t radius) const {
-	// get new spread index
-	size_t idx = index(alt);
-
-	// get origin tile
-	Hex* origin = array.at(pos);
-	if (!origin) return idx;
+	// round capacity up to a power of 2
+	size_t cap = 16;
+	while (cap < count) cap <<= 1;
 
-	// override radius
-	Tile tile = { { origin, pos }, radius };
-	if (auto nr = this->radius(tile))
-		tile.left = radius = *nr;
+	// move queued tiles to the new storage
+	std::vector<Tile> buf(cap);
+	for (size_t i = 0; i < _size; i++)
+		buf[i] = _buf[(_head + i) & _mask];
 
-	// apply effect to origin if needed
-	origin->spread[alt] = idx;
-	if (imm && pass(tile))
-		effect(tile);
-	if (!radius) return idx;
+	// replace storage
+	_buf = std::move(buf);
+	_head = 0;
+	_mask = cap - 1;
+};
 
-	// tile queue
-	std::list<Tile> queue;
+/// Returns current tile capacity.
+size_t Spread::Frontier::capacity() const {
+	return _buf.size();
+};
 
-	// initial spread from origin
-	_spread(queue, array, hop, idx, tile, alt);
+/// Drops all queued tiles.
+void Spread::Frontier::clear() {
+	_head = 0;
+	_size = 0;
+};
 
-	// spreader loop
-	while (!queue.empty()) {
-		// pull next tile
-		Tile tile = queue.front();
-		queue.pop_front();
+/// Shared spread queues of a thread.
+///
+/// One queue per spread index, so `Alt` spreads
+/// applied inside other spreaders keep their own queue.
+static thread_local Spread::Frontier _queues[2];
+/// Whether a shared spread queue is in use.
+static thread_local bool _busy[2] = { false, false };
+
+/// Leases a spread queue.
+Spread::Lease::Lease(bool alt, size_t count) : _alt(alt), _shared(!_busy[alt]) {
+	_queue = _shared ? &_queues[alt] : &_local;
+	_busy[alt] = true;
+
+	// prepare the queue
+	_queue->clear();
+	_queue->reserve(count);
+};
 
-		// apply effect
-		if (pass(tile)) effect(tile);
+/// Releases the shared queue.
+Spread::Lease::~Lease() {
+	if (_shared) _busy[_alt] = false;
+};
 
-		// spread to neighboring tiles
-		_spread(queue, array, hop, idx, tile, alt);
+/// Returns a statically typed view of a spread.
+///
+/// @param spread Type-erased spread.
+static auto _view(const Spread& spread) {
+	return BasicSpread {
+		.hop = std::cref(spread.hop),
+		.pass = std::cref(spread.pass),
+		.effect = std::cref(spread.effect),
+		.imm = spread.imm,
+		.alt = spread.alt
 	};
-
-	// return spread index
-	return idx;
 };
 
-/// Applies the spread.
-Spread::List Spread::applylist(const HexArray& array, sf::Vector2i pos, size_t radius) const {
-	// affected tile coords list
-	List affected;
-
-	// get new spread index
-	size_t idx = index(alt);
-
-	// get origin tile
+/// Applies spread radius override.
+///
+/// @param spread Spread description.
+/// @param array Target tile array.
+/// @param pos Spread origin.
+/// @param radius Maximum spread radius.
+///
+/// @return Overridden spread radius.
+static size_t _radius(const Spread& spread, const HexArray& array, sf::Vector2i pos, size_t radius) {
+	// ignore if no origin tile
 	Hex* origin = array.at(pos);
-	if (!origin) return affected;
+	if (!origin) return radius;
 
 	// override radius
-	Tile tile = { { origin, pos }, radius };
-	if (auto nr = this->radius(tile))
-		tile.left = radius = *nr;
-
-	// apply effect to origin if needed
-	origin->spread[alt] = idx;
-	if (imm && pass(tile)) {
-		effect(tile);
-		affected.push_back(tile.pos);
-	};
-	if (!radius) return affected;
-
-	// tile queue
-	std::list<Tile> queue;
-
-	// initial spread from origin
-	_spread(queue, array, hop, idx, { { origin, pos }, radius }, alt);
-
-	// spreader loop
-	while (!queue.empty()) {
-		// pull next tile
-		Tile tile = queue.front();
-		queue.pop_front();
+	if (auto nr = spread.radius({ { origin, pos }, radius }))
+		return *nr;
+	return radius;
+};
 
-		// apply effect
-		if (pass(tile)) {
-			effect(tile);
-			affected.push_back(tile.pos);
-		};
+/// Applies the spread.
+size_t Spread::apply(const HexArray& array, sf::Vector2i pos, size_t radius) const {
+	return _view(*this).apply(array, pos, _radius(*this, array, pos, radius));
+};
 
-		// spread to neighboring tiles
-		_spread(queue, array, hop, idx, tile, alt);
-	};
+/// Applies the spread.
+Spread::List Spread::applylist(const HexArray& array, sf::Vector2i pos, size_t radius) const {
+	List affected;
+	applylist(array, pos, affected, radius);
 	return affected;
 };
+
+/// Applies the spread.
+size_t Spread::applylist(const HexArray& array, sf::Vector2i pos, List& list, size_t radius) const {
+	return _view(*this).applylist(array, pos, list, _radius(*this, array, pos, radius));
+};
@@ -1,8 +1,8 @@
 #include "game/sync/adapter.hpp"
 
 /// Sends a move list from this adapter.
-void Adapter::send_list(History::SpanList list) {
-	send_list({ list, id });
+void Adapter::send_list(History::SpanList list, uint64_t hash) {
+	send_list({ list, id, hash });
 };
 
 /// Sends an event from this adapter.
@@ -1,12 +1,73 @@
 #include "game/sync/ai.hpp"
 #include "game/bot_ai.hpp"
+#include "flags.hpp"
+#include <chrono>
 
 /// Constructs a bot adapter.
 BotAdapter::BotAdapter(float difficulty):
 	difficulty(difficulty) {};
 
 /// Sends a move list.
-void BotAdapter::send_list(Packet<History::SpanList> list) {};
+void BotAdapter::send_list(Packet<History::SpanList> list) {
+	// wait for the planning thread to release the copy
+	if (_plan.valid()) _plan.wait();
+
+	// ignore returned plans, the copy already has them
+	if (_own && *_own == list.id) {
+		_own = {};
+		return;
+	};
+
+	// apply decoded moves, so sent move objects are left untouched
+	_log.clear();
+	_log.push(list.value);
+	_log.apply(&_copy);
+};
+
+/// Copies the whole map.
+void BotAdapter::resync() {
+	Template::generate(map).construct(&_copy);
+	map->regions.foreach(map, [this](Region& reg, sf::Vector2i pos) {
+		if (const auto& own = _copy.at(pos)->region()) {
+			own->setData(reg.data());
+			_copy.regions.touch(own);
+		};
+	});
+};
+
+/// Starts planning a bot turn.
+void BotAdapter::plan(uint32_t idx) {
+	// copy the map only if the private copy has diverged
+	if (_copy.hash() != map->hash()) resync();
+	_copy.random = map->random;
+
+	Region::Team team = list[idx].team;
+	float diff = difficulty;
+	double time = budget;
+	bool look = diff >= search;
+
+	// plan on the private copy
+	_plan = std::async(std::launch::async, [this, team, diff, time, look, idx]() {
+		auto start = std::chrono::steady_clock::now();
+
+		// generate moves within the budget
+		_copy.history.clear();
+		ai::generate(_copy, team, diff, !look, time);
+
+		// search troop actions with the time left
+		if (look) {
+			ai::SearchConfig config = ai::SearchConfig::scaled(diff);
+			if (time > 0) {
+				double spent = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				config.budget = std::min(config.budget, time - spent);
+			};
+			ai::search(_copy, team, config);
+		};
+		Plan plan = { .moves = _copy.history.release(), .random = _copy.random, .id = idx };
+		if (flags::verify) plan.hash = _copy.hash();
+		return plan;
+	});
+};
 
 /// Receives a move list.
 Adapter::OptPacket<History::UniqList> BotAdapter::recv_list() {
@@ -24,9 +85,17 @@ Adapter::OptPacket<History::UniqList> BotAdapter::recv_list() {
 			return {};
 		};
 
-		// return generated move list
-		auto moves = ai::generate(*map, list[idx].team, difficulty);
-		return Packet<History::UniqList> { .value = std::move(moves), .id = idx };
+		// start planning
+		plan(idx);
+		return {};
+	};
+
+	// return planned move list once ready
+	if (_plan.valid() && _plan.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+		Plan plan = _plan.get();
+		map->random = plan.random;
+		_own = plan.id;
+		return Packet<History::UniqList> { .value = plan.moves.decode(), .id = plan.id, .hash = plan.hash };
 	};
 
 	// no move lists
@@ -36,8 +105,10 @@ Adapter::OptPacket<History::UniqList> BotAdapter::recv_list() {
 /// Sends an event.
 void BotAdapter::send(Packet<Messages::Event> evt) {
 	// game initialization
-	if (auto* data = std::get_if<Messages::Init>(&evt.value))
+	if (auto* data = std::get_if<Messages::Init>(&evt.value)) {
 		list = data->players;
+		Messages::join(&_copy, *data);
+	};
 
 	// player selection
 	if (auto* data = std::get_if<Messages::Select>(&evt.value))
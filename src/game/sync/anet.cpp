@@ -11,12 +11,13 @@ enum PacketType {
 /// Sends a move list.
 void NetAdapter::send_list(Packet<History::SpanList> list) {
 	// serialize move list
-	sf::Packet packet;
-	packet << (uint8_t)MoveList;
-	packet << list.id;
-	packet << (uint32_t)list.value.size();
+	std::vector<uint8_t> data;
+	Serialize::ByteWriter writer(data);
+	writer << (uint8_t)MoveList;
+	writer << list.id;
+	writer << (uint32_t)list.value.size();
 	for (const auto& move : list.value)
-		Serialize::encodeMove(packet, move.get());
+		Serialize::encodeMove(writer, move.get());
 
 	// @todo: send packet
 };
@@ -29,9 +30,10 @@ Adapter::OptPacket<History::UniqList> NetAdapter::recv_list() {
 	// @note don't consume packet
 	std::optional<sf::Packet> packet = {};
 	if (!packet) return {};
+	auto reader = Serialize::readPacket(*packet);
 
 	// switch on packet type
-	switch (Serialize::from<uint8_t>(*packet)) {
+	switch (Serialize::from<uint8_t>(reader)) {
 		case MoveList: break;
 		case EventMessage: return {};
 		default:
@@ -43,12 +45,12 @@ Adapter::OptPacket<History::UniqList> NetAdapter::recv_list() {
 
 	// deserialize move list
 	auto list = Adapter::Packet<History::UniqList>{
-		.id = Serialize::from<uint32_t>(*packet)
+		.id = Serialize::from<uint32_t>(reader)
 	};
-	uint32_t count = Serialize::from<uint32_t>(*packet);
+	uint32_t count = Serialize::from<uint32_t>(reader);
 	for (uint32_t i = 0; i < count; i++) {
 		// deserialize each move
-		list.value.push_back(Serialize::decodeMove(*packet));
+		list.value.push_back(Serialize::decodeMove(reader));
 	};
 	return list;
 };
@@ -56,10 +58,11 @@ Adapter::OptPacket<History::UniqList> NetAdapter::recv_list() {
 /// Sends an event.
 void NetAdapter::send(Packet<Messages::Event> evt) {
 	// serialize message
-	sf::Packet packet;
-	packet << (uint8_t)EventMessage;
-	packet << evt.id;
-	Serialize::encodeMessage(packet, evt.value);
+	std::vector<uint8_t> data;
+	Serialize::ByteWriter writer(data);
+	writer << (uint8_t)EventMessage;
+	writer << evt.id;
+	Serialize::encodeMessage(writer, evt.value);
 
 	// @todo: send packet
 };
@@ -72,9 +75,10 @@ Adapter::OptPacket<Messages::Event> NetAdapter::recv() {
 	// @note don't consume packet
 	std::optional<sf::Packet> packet = {};
 	if (!packet) return {};
+	auto reader = Serialize::readPacket(*packet);
 
 	// switch on packet type
-	switch (Serialize::from<uint8_t>(*packet)) {
+	switch (Serialize::from<uint8_t>(reader)) {
 		case EventMessage: break;
 		case MoveList: return {};
 		default:
@@ -86,9 +90,9 @@ Adapter::OptPacket<Messages::Event> NetAdapter::recv() {
 
 	// deserialize event message
 	auto evt = Adapter::Packet<Messages::Event>{
-		.id = Serialize::from<uint32_t>(*packet)
+		.id = Serialize::from<uint32_t>(reader)
 	};
-	if (auto data = Serialize::decodeMessage(*packet)) {
+	if (auto data = Serialize::decodeMessage(reader)) {
 		evt.value = *data;
 	}
 	else return {};
@@ -0,0 +1,21 @@
+#include "game/sync/messages.hpp"
+
+namespace Messages {
+	/// Seeds the host map and describes it for clients.
+	Init init(Map* map, const std::vector<Player>& players, uint64_t seed) {
+		map->random.seed(seed);
+		return Init{
+			.temp = Template::generate(map),
+			.players = players,
+			.seed = seed,
+			.hash = map->hash()
+		};
+	};
+
+	/// Constructs a client map from a game initialization message.
+	bool join(Map* map, const Init& init) {
+		init.temp.construct(map);
+		map->random.seed(init.seed);
+		return !init.hash || init.hash == map->hash();
+	};
+};
\ No newline at end of file
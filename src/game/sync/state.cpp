@@ -1,5 +1,6 @@
 #include "game/sync/state.hpp"
 #include "game/values/hex_values.hpp"
+#include <random>
 
 /// Constructs a game state object.
 GameState::GameState(Mode mode, Adapter* adapter):
@@ -87,11 +88,12 @@ void GameState::init() {
 		return;
 	};
 
+	// roll a map seed
+	std::random_device device;
+	uint64_t seed = (uint64_t)device() << 32 | device();
+
 	// send initialization packet
-	_adapter->send(Messages::Init{
-		.temp = Template::generate(_map),
-		.players = _plr
-	});
+	_adapter->send(Messages::init(_map, _plr, seed));
 
 	// select first player
 	_idx = 0;
@@ -108,8 +110,8 @@ bool GameState::finish() {
 	if (_state != Play) return false;
 
 	// transmit move list
-	auto list = _map->history.list();
-	_adapter->send_list({ list, _adapter->id });
+	auto list = _map->history.log().decode();
+	_adapter->send_list({ list, _adapter->id, _map->hash() });
 
 	// select next player
 	next();
@@ -159,7 +161,7 @@ void GameState::next() {
 
 		// tick & transmit player regions
 		auto list = logic::turn(_map, player()->team);
-		_adapter->send_list(list);
+		_adapter->send_list(list, _map->hash());
 
 		// check for game over
 		auto count = logic::count(_map, _plr);
@@ -189,7 +191,7 @@ void GameState::next() {
 
 			// tick & transmit the map
 			auto list = logic::global(_map);
-			_adapter->send_list(list);
+			_adapter->send_list(list, _map->hash());
 			turn = true;
 		};
 		_clock.restart();
@@ -219,13 +221,18 @@ void GameState::tick() {
 			};
 
 			// retransmit move list to others
-			_adapter->send_list({ data->value, data->id });
+			_adapter->send_list({ data->value, data->id, data->hash });
 		};
 
 		// sync game map
 		for (const auto& move : data->value)
 			move->apply(_map);
 
+		// check for desync
+		if (data->hash && data->hash != _map->hash()) {
+			fprintf(stderr, "[ERROR] Map desync after move list from player %u.\n", data->id);
+		};
+
 		// select next player
 		next();
 	};
@@ -248,8 +255,10 @@ void GameState::tick() {
 void GameState::proc(const Adapter::Packet<Messages::Event>& event) {
 	// game initialization
 	if (auto* data = std::get_if<Messages::Init>(&event.value)) {
-		// construct game map
-		data->temp.construct(_map);
+		// construct game map & check if it matches the host
+		if (!Messages::join(_map, *data)) {
+			fprintf(stderr, "[ERROR] Map desync after initialization.\n");
+		};
 
 		// store player list
 		_plr = data->players;
@@ -54,7 +54,7 @@ Template Template::generate(const Map* map) {
 	};
 
 	// copy region data
-	Regions::foreach(map, [&temp](Region& reg, sf::Vector2i pos) {
+	map->regions.foreach(map, [&temp](Region& reg, sf::Vector2i pos) {
 		temp.regions.push_back({ reg.res(), pos });
 	});
 
@@ -89,4 +89,7 @@ void Template::construct(Map* map) const {
 		if (hex.region())
 			hex.region()->setRes(rcd.res);
 	};
+
+	// hash constructed map
+	map->rehash();
 };
@@ -97,8 +97,9 @@ Editor::Editor(Game* game, ui::Layer* text_layer): _game(game) {
 			// change type & remove any entities
 			Regions::Ref prev = tile.hex->region();
 			tile.hex->type = Hex::Void;
-			tile.hex->leave();
+			tile.hex->leave(tile.pos);
 			_game->map.removeEntity(tile.hex);
+			_game->map.touch(tile.pos);
 			_game->map.updateRegions(tile, prev, {});
 
 			// update resource table
@@ -116,8 +117,9 @@ Editor::Editor(Game* game, ui::Layer* text_layer): _game(game) {
 			// change type & remove any entities
 			Regions::Ref prev = tile.hex->region();
 			tile.hex->type = Hex::Water;
-			tile.hex->leave();
+			tile.hex->leave(tile.pos);
 			_game->map.removeEntity(tile.hex);
+			_game->map.touch(tile.pos);
 			_game->map.updateRegions(tile, prev, {});
 
 			// update resource table
@@ -136,10 +138,11 @@ Editor::Editor(Game* game, ui::Layer* text_layer): _game(game) {
 			Regions::Ref prev = tile.hex->region();
 			tile.hex->type = Hex::Ground;
 			tile.hex->team = team;
+			_game->map.touch(tile.pos);
 
 			// create new region
-			auto ref = _game->map.regions.create({ .team = team });
-			tile.hex->join(ref);
+			auto ref = _game->map.regions.create(team);
+			tile.hex->join(ref, tile.pos);
 
 			// update regions
 			_game->map.updateRegions(tile, prev, {});
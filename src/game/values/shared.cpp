@@ -50,4 +50,7 @@ namespace Values {
 
 	/// Keyboard pan speed multiplier.
 	const float panSpeed = 240.f;
+
+	/// Default camera zoom from which the map is drawn in low detail.
+	const float lodZoom = 1.5f;
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "game/zobrist.hpp"
+
+namespace Zobrist {
+	/// Key feature tags.
+	enum Tag : uint64_t {
+		T_Base = 1, /// Tile type & team.
+		T_Troop,    /// Troop state.
+		T_Build,    /// Building state.
+		T_Plant,    /// Plant state.
+		T_Timers,   /// Entity skill timers.
+		T_Effect,   /// Applied entity effect.
+		T_Region,   /// Region state.
+		T_Member,   /// Region membership.
+	};
+
+	/// Mixes a value into a key.
+	///
+	/// Uses splitmix64 finalizer.
+	///
+	/// @param key Current key.
+	/// @param value Mixed value.
+	static uint64_t mix(uint64_t key, uint64_t value) {
+		uint64_t z = key ^ (value + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2));
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	};
+
+	/// Returns a key of a feature.
+	///
+	/// @param tag Feature tag.
+	/// @param index Tile index.
+	/// @param value Feature value.
+	static uint64_t key(Tag tag, uint64_t index, uint64_t value) {
+		return mix(mix(mix(0, tag), index), value);
+	};
+
+	/// Returns a key of an entity state.
+	///
+	/// @param tag Entity kind tag.
+	/// @param index Tile index.
+	/// @param entity Entity reference.
+	/// @param type Entity type.
+	static uint64_t entity(Tag tag, size_t index, const Entity& entity, int type) {
+		// entity type & hitpoints
+		uint64_t k = key(tag, index, (uint64_t)type | (uint64_t)(uint32_t)entity.hp << 8);
+
+		// skill timers
+		uint64_t timers = 0;
+		for (int i = 0; i < 4; i++)
+			timers |= (uint64_t)entity.timers[i] << (i * 8);
+		k ^= key(T_Timers, index, timers);
+
+		// applied effects (order independent)
+		for (EffectType effect : entity.effectList())
+			k ^= key(T_Effect, index, static_cast<uint64_t>(effect));
+		return k;
+	};
+
+	/// Returns a key of a tile state.
+	uint64_t tile(size_t index, const Hex& hex) {
+		uint64_t k = key(T_Base, index, (uint64_t)hex.type | (uint64_t)hex.team << 8);
+
+		// entity state
+		if (hex.troop)
+			k ^= entity(T_Troop, index, *hex.troop, hex.troop->type);
+		if (hex.build)
+			k ^= entity(T_Build, index, *hex.build, hex.build->type);
+		if (hex.plant)
+			k ^= entity(T_Plant, index, *hex.plant, hex.plant->type);
+		return k;
+	};
+
+	/// Returns a membership key of a tile.
+	uint64_t member(sf::Vector2i pos) {
+		return key(T_Member, (uint64_t)(uint32_t)pos.x | (uint64_t)(uint32_t)pos.y << 32, 0);
+	};
+
+	/// Returns a key of a region state.
+	uint64_t region(const Region& reg) {
+		uint64_t k = key(T_Region, reg.members, (uint64_t)reg.team | (uint64_t)(uint32_t)reg.tiles << 8);
+		k = mix(k, (uint64_t)(uint32_t)reg.money | (uint64_t)(uint32_t)reg.berry << 32);
+		k = mix(k, (uint64_t)(uint32_t)reg.peach | (uint64_t)(uint32_t)reg.farms << 32);
+		k = mix(k, (uint64_t)(uint32_t)reg.tents | (uint64_t)reg.dead << 32);
+		return k;
+	};
+};
@@ -38,11 +38,14 @@ int main() {
 			if (!flags::stats) return;
 
 			std::string format = std::format(
-				"{}Q {}T {}B {}R",
+				"{}Q {}V {}T {}B {}R {}/{}C",
 				stats.quads,
+				stats.vertices,
 				stats.text + 1,
 				stats.batches,
-				stats.inters
+				stats.inters,
+				stats.cached,
+				stats.rebuilt
 			);
 			drawStats.setString(format);
 			drawStats.setPosition({ ui::window.size().x - drawStats.getLocalBounds().size.x - 4, 0 });
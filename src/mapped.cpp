@@ -0,0 +1,97 @@
+#include "mapped.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// Unmaps the file.
+MappedFile::~MappedFile() { close(); };
+
+#ifdef _WIN32
+
+/// Maps a file into memory.
+bool MappedFile::open(const std::filesystem::path& path) {
+	close();
+
+	// open the file
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	_file = file;
+
+	// get file size
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		close();
+		return false;
+	};
+
+	// map the file
+	_map = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!_map) {
+		close();
+		return false;
+	};
+	_data = (const uint8_t*)MapViewOfFile(_map, FILE_MAP_READ, 0, 0, 0);
+	if (!_data) {
+		close();
+		return false;
+	};
+	_size = (size_t)size.QuadPart;
+	return true;
+};
+
+/// Unmaps the file.
+void MappedFile::close() {
+	if (_data) UnmapViewOfFile(_data);
+	if (_map) CloseHandle(_map);
+	if (_file) CloseHandle(_file);
+	_data = nullptr;
+	_map = nullptr;
+	_file = nullptr;
+	_size = 0;
+};
+
+#else
+
+/// Maps a file into memory.
+bool MappedFile::open(const std::filesystem::path& path) {
+	close();
+
+	// open the file
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+
+	// get file size
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		::close(fd);
+		return false;
+	};
+
+	// map the file
+	// the mapping stays valid after the descriptor is closed
+	void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED) return false;
+
+	_data = (const uint8_t*)data;
+	_size = (size_t)info.st_size;
+	return true;
+};
+
+/// Unmaps the file.
+void MappedFile::close() {
+	if (_data) munmap((void*)_data, _size);
+	_data = nullptr;
+	_size = 0;
+};
+
+#endif
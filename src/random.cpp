@@ -1,29 +1,103 @@
 #include "random.hpp"
-#include <stdlib.h>
 
 namespace Random {
-	/// Reset generator and sets a seed.
-	void seed(size_t value) {
-		srand((unsigned int)value);
+	/// Rotates bits to the left.
+	static inline uint64_t rotl(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	};
+
+	/// Constructs a generator.
+	Generator::Generator(uint64_t value) { seed(value); };
+
+	/// Resets generator and sets a seed.
+	void Generator::seed(uint64_t value) {
+		// expand seed with splitmix64
+		for (uint64_t& s : _state) {
+			uint64_t z = (value += 0x9e3779b97f4a7c15ull);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			s = z ^ (z >> 31);
+		};
+	};
+
+	/// Returns an independent generator stream.
+	Generator Generator::stream(size_t index) const {
+		Generator gen = *this;
+		for (size_t i = 0; i < index; i++)
+			gen._jump();
+		return gen;
+	};
+
+	/// Advances the state by 2^128 steps.
+	void Generator::_jump() {
+		static const uint64_t table[4] = {
+			0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+			0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+		};
+
+		uint64_t s[4] = { 0, 0, 0, 0 };
+		for (uint64_t word : table) {
+			for (int b = 0; b < 64; b++) {
+				if (word & (1ull << b)) {
+					s[0] ^= _state[0];
+					s[1] ^= _state[1];
+					s[2] ^= _state[2];
+					s[3] ^= _state[3];
+				};
+				u64();
+			};
+		};
+		for (int i = 0; i < 4; i++)
+			_state[i] = s[i];
+	};
+
+	/// Returns a random unsigned 64-bit number.
+	uint64_t Generator::u64() {
+		uint64_t result = rotl(_state[1] * 5, 7) * 9;
+		uint64_t t = _state[1] << 17;
+
+		_state[2] ^= _state[0];
+		_state[3] ^= _state[1];
+		_state[1] ^= _state[2];
+		_state[0] ^= _state[3];
+		_state[2] ^= t;
+		_state[3] = rotl(_state[3], 45);
+
+		return result;
 	};
 
 	/// Returns a random unsigned 8-bit number.
-	uint8_t u8() { return rand() & 0xff; };
+	uint8_t Generator::u8() { return (uint8_t)(u64() >> 56); };
 	/// Returns a random unsigned 16-bit number.
-	uint16_t u16() { return u8() | (uint16_t)u8() << 8; };
+	uint16_t Generator::u16() { return (uint16_t)(u64() >> 48); };
 	/// Returns a random unsigned 32-bit number.
-	uint32_t u32() { return u16() | (uint32_t)u16() << 16; };
-	/// Returns a random unsigned 64-bit number.
-	uint64_t u64() { return u32() | (uint64_t)u32() << 32; };
+	uint32_t Generator::u32() { return (uint32_t)(u64() >> 32); };
+
+	/// Fills an array with random unsigned 64-bit numbers.
+	void Generator::fill(uint64_t* data, size_t count) {
+		// keep state in locals for the whole batch
+		uint64_t s0 = _state[0], s1 = _state[1], s2 = _state[2], s3 = _state[3];
+		for (size_t i = 0; i < count; i++) {
+			data[i] = rotl(s1 * 5, 7) * 9;
+			uint64_t t = s1 << 17;
+			s2 ^= s0;
+			s3 ^= s1;
+			s1 ^= s2;
+			s0 ^= s3;
+			s2 ^= t;
+			s3 = rotl(s3, 45);
+		};
+		_state[0] = s0; _state[1] = s1; _state[2] = s2; _state[3] = s3;
+	};
 
 	/// Returns a random float in range `[0, 1)`.
-	float uniform() { return (float)u32() / UINT32_MAX; };
+	float Generator::uniform() { return (float)(u64() >> 40) * 0x1p-24f; };
 
 	/// Returns whether a chance succeeds.
-	bool chance(float value) { return uniform() < value; };
+	bool Generator::chance(float value) { return uniform() < value; };
 
 	/// Rolls a chance with pity.
-	bool pity(float value, uint8_t& fail, uint8_t max) {
+	bool Generator::pity(float value, uint8_t& fail, uint8_t max) {
 		// bonus chance per fail
 		float slope = (1.f - value) / max;
 
@@ -34,4 +108,30 @@ namespace Random {
 		fail = roll ? 0 : fail + 1;
 		return roll;
 	};
-};
\ No newline at end of file
+
+	/// Generator of the calling thread.
+	static thread_local Generator _local;
+
+	/// Reset generator of the calling thread and sets a seed.
+	void seed(size_t value) { _local.seed(value); };
+
+	/// Returns a random unsigned 8-bit number.
+	uint8_t u8() { return _local.u8(); };
+	/// Returns a random unsigned 16-bit number.
+	uint16_t u16() { return _local.u16(); };
+	/// Returns a random unsigned 32-bit number.
+	uint32_t u32() { return _local.u32(); };
+	/// Returns a random unsigned 64-bit number.
+	uint64_t u64() { return _local.u64(); };
+
+	/// Returns a random float in range `[0, 1)`.
+	float uniform() { return _local.uniform(); };
+
+	/// Returns whether a chance succeeds.
+	bool chance(float value) { return _local.chance(value); };
+
+	/// Rolls a chance with pity.
+	bool pity(float value, uint8_t& fail, uint8_t max) {
+		return _local.pity(value, fail, max);
+	};
+};
@@ -8,9 +8,12 @@ namespace ui {
 	void RenderStats::operator|=(const RenderStats& oth) {
 		quads += oth.quads;
 		triangles += oth.triangles;
+		vertices += oth.vertices;
 		text += oth.text;
 		batches += oth.batches;
 		inters += oth.inters;
+		cached += oth.cached;
+		rebuilt += oth.rebuilt;
 	};
 
 	/// Constructs a new render buffer.
@@ -19,7 +22,7 @@ namespace ui {
 
 	/// Clears buffer contents.
 	void RenderBuffer::clear() {
-		// reset buffers
+		// reset buffers, keeping their capacity
 		_arr.clear();
 		_txt.clear();
 		_fis.clear();
@@ -30,20 +33,14 @@ namespace ui {
 
 	/// Queues a triangle for rendering.
 	void RenderBuffer::triangle(sf::Vertex a, sf::Vertex b, sf::Vertex c) {
-		_arr.push_back(a);
-		_arr.push_back(b);
-		_arr.push_back(c);
+		_arr.insert(_arr.end(), { a, b, c });
 		_inf.triangles++;
 	};
 
 	/// Queues a quad for rendering.
 	void RenderBuffer::quad(sf::Vertex a, sf::Vertex b, sf::Vertex c, sf::Vertex d) {
-		_arr.push_back(a);
-		_arr.push_back(b);
-		_arr.push_back(c);
-		_arr.push_back(a);
-		_arr.push_back(c);
-		_arr.push_back(d);
+		// write both triangles at once
+		_arr.insert(_arr.end(), { a, b, c, a, c, d });
 		_inf.quads++;
 	};
 
@@ -70,12 +67,113 @@ namespace ui {
 		);
 	};
 
+	/// Queues cached vertices for rendering.
+	void RenderBuffer::cached(std::span<const sf::Vertex> vertices, sf::Vector2f offset, bool rebuilt) {
+		size_t start = _arr.size();
+		_arr.insert(_arr.end(), vertices.begin(), vertices.end());
+		for (size_t i = start; i < _arr.size(); i++)
+			_arr[i].position += offset;
+
+		_inf.quads += vertices.size() / 6;
+		if (rebuilt) _inf.rebuilt++;
+		else _inf.cached++;
+	};
+
+	/// Returns queued vertices.
+	std::span<const sf::Vertex> RenderBuffer::vertices() const {
+		return _arr;
+	};
+
 	/// Queues a text line for rendering.
 	void RenderBuffer::text(const sf::Text& text) {
 		_txt.push_back(text);
 		_inf.text++;
 	};
 
+	/// Queues a glyph quad.
+	///
+	/// @param target Target buffer.
+	/// @param transform Text transform.
+	/// @param pos Glyph origin.
+	/// @param color Glyph color.
+	/// @param glyph Glyph data.
+	/// @param shear Italic shear.
+	static void glyphQuad(
+		RenderBuffer& target, const sf::Transform& transform,
+		sf::Vector2f pos, sf::Color color,
+		const sf::Glyph& glyph, float shear
+	) {
+		// glyph bounds with atlas padding
+		const sf::Vector2f pad = { 1.f, 1.f };
+		sf::Vector2f p1 = glyph.bounds.position - pad;
+		sf::Vector2f p2 = glyph.bounds.position + glyph.bounds.size + pad;
+		sf::Vector2f t1 = sf::Vector2f(glyph.textureRect.position) - pad;
+		sf::Vector2f t2 = sf::Vector2f(glyph.textureRect.position + glyph.textureRect.size) + pad;
+
+		// sheared corner in target space
+		auto at = [&](float x, float y) {
+			return transform.transformPoint(pos + sf::Vector2f(x - shear * y, y));
+		};
+		target.quad(
+			{ at(p1.x, p1.y), color, { t1.x, t1.y } },
+			{ at(p1.x, p2.y), color, { t1.x, t2.y } },
+			{ at(p2.x, p2.y), color, { t2.x, t2.y } },
+			{ at(p2.x, p1.y), color, { t2.x, t1.y } }
+		);
+	};
+
+	/// Queues a text line as glyph quads.
+	void RenderBuffer::glyphs(const sf::Text& text) {
+		const sf::Font& font = text.getFont();
+		unsigned int size = text.getCharacterSize();
+		uint32_t style = text.getStyle();
+
+		// leave line decorations to sf::Text
+		if (style & (sf::Text::Underlined | sf::Text::StrikeThrough)) {
+			this->text(text);
+			forward(nullptr);
+			return;
+		};
+
+		// get text layout parameters
+		bool bold = style & sf::Text::Bold;
+		float shear = (style & sf::Text::Italic) ? 0.209f : 0.f;
+		float outline = text.getOutlineThickness();
+		float space = font.getGlyph(U' ', size, bold).advance;
+		float letter = space / 3.f * (text.getLetterSpacing() - 1.f);
+		float line = font.getLineSpacing(size) * text.getLineSpacing();
+		space += letter;
+
+		// draw outline first, then fill
+		size_t start = _arr.size();
+		for (int pass = outline != 0.f ? 0 : 1; pass < 2; pass++) {
+			sf::Color color = pass ? text.getFillColor() : text.getOutlineColor();
+			sf::Vector2f pos = { 0.f, (float)size };
+			char32_t prev = 0;
+
+			for (char32_t c : text.getString()) {
+				if (c == U'\r') continue;
+				pos.x += font.getKerning(prev, c, size, bold);
+				prev = c;
+
+				// handle whitespace
+				if (c == U' ') { pos.x += space; continue; };
+				if (c == U'\t') { pos.x += space * 4; continue; };
+				if (c == U'\n') { pos = { 0.f, pos.y + line }; continue; };
+
+				// queue glyph, fill glyph advance is used in both passes
+				const sf::Glyph& glyph = font.getGlyph(c, size, bold);
+				glyphQuad(*this, text.getTransform(), pos, color, pass ? glyph : font.getGlyph(c, size, bold, outline), shear);
+				pos.x += glyph.advance + letter;
+			};
+		};
+
+		// forward with font atlas
+		_inf.text++;
+		if (_arr.size() != start)
+			forward(&font.getTexture(size));
+	};
+
 	/// Sets next forward scissor area.
 	void RenderBuffer::scissor(sf::IntRect area) {
 		// intersect scissor with old area
@@ -140,7 +238,6 @@ namespace ui {
 		auto text_it = _txt.begin();
 
 		// batched draw calls
-		size_t batch_count = 0;
 		for (auto it = _fis.begin(); it != _fis.end(); it++) {
 			// get object count
 			size_t vert_count = it->vert_idx - vert_idx;
@@ -156,7 +253,6 @@ namespace ui {
 				_opt.texture = it->texture;
 				target.draw(_arr.data() + vert_idx, vert_count, sf::PrimitiveType::Triangles, _opt);
 				vert_idx = it->vert_idx;
-				batch_count++;
 			};
 
 			// draw text
@@ -181,8 +277,21 @@ namespace ui {
 #endif
 
 		// return layer stats
+		return stats();
+	};
+
+	/// Returns statistics of queued contents.
+	RenderStats RenderBuffer::stats() const {
 		RenderStats stats = _inf;
-		stats.batches = batch_count;
+		stats.vertices = _arr.size();
+
+		// count forwards with vertices & text draw calls
+		size_t vert_idx = 0;
+		for (const auto& fi : _fis) {
+			if (fi.vert_idx != vert_idx) stats.batches++;
+			vert_idx = fi.vert_idx;
+		};
+		stats.batches += _txt.size();
 		return stats;
 	};
 
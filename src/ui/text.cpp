@@ -76,8 +76,7 @@ namespace ui {
 		});
 
 		// render text
-		target.text(_text);
-		target.forward(nullptr);
+		target.glyphs(_text);
 	};
 
 	/// Constructs a text element.
@@ -0,0 +1,89 @@
+#include "workers.hpp"
+#include <algorithm>
+
+/// Starts worker threads.
+Workers::Workers(size_t count) {
+	// use every hardware thread by default
+	if (count == 0)
+		count = std::max(1u, std::thread::hardware_concurrency());
+
+	// start threads for every worker except the caller
+	for (size_t i = 1; i < count; i++)
+		_threads.emplace_back(&Workers::_loop, this, i);
+};
+
+/// Stops worker threads.
+Workers::~Workers() {
+	{
+		std::lock_guard lock(_mutex);
+		_stop = true;
+	};
+	_wake.notify_all();
+
+	// wait for threads to exit
+	for (auto& thread : _threads)
+		thread.join();
+};
+
+/// Returns worker count.
+size_t Workers::count() const {
+	return _threads.size() + 1;
+};
+
+/// Runs a batch of tasks.
+void Workers::run(size_t count, const Task& task) {
+	// run on caller thread if nothing to share
+	if (_threads.empty() || count < 2) {
+		for (size_t i = 0; i < count; i++)
+			task(i, 0);
+		return;
+	};
+
+	// publish the batch
+	{
+		std::lock_guard lock(_mutex);
+		_task = &task;
+		_count = count;
+		_next = 0;
+		_busy = _threads.size();
+		_batch++;
+	};
+	_wake.notify_all();
+
+	// take part in the batch
+	_work(0);
+
+	// wait for other workers
+	std::unique_lock lock(_mutex);
+	_done.wait(lock, [this]() { return _busy == 0; });
+	_task = nullptr;
+};
+
+/// Runs unclaimed tasks of current batch.
+void Workers::_work(size_t worker) {
+	size_t idx;
+	while ((idx = _next.fetch_add(1)) < _count)
+		(*_task)(idx, worker);
+};
+
+/// Worker thread loop.
+void Workers::_loop(size_t worker) {
+	size_t batch = 0;
+	while (1) {
+		// wait for a new batch
+		{
+			std::unique_lock lock(_mutex);
+			_wake.wait(lock, [&]() { return _stop || _batch != batch; });
+			if (_stop) return;
+			batch = _batch;
+		};
+
+		// run batch tasks
+		_work(worker);
+
+		// report batch completion
+		std::lock_guard lock(_mutex);
+		if (--_busy == 0)
+			_done.notify_one();
+	};
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+// licznik alokacji: podmieniony globalny operator new
+// dolaczac tylko w jednym pliku kazdego testu
+#include <cstdlib>
+#include <new>
+
+inline size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+	allocations++;
+	if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,205 @@
+#include "game/loader.hpp"
+#include "game/bot_ai.hpp"
+#include "game/move_log.hpp"
+#include "game/logic/turn_logic.hpp"
+#include "game/sync/ai.hpp"
+#include "flags.hpp"
+#include "timing.hpp"
+#include <cassert>
+#include <cstdio>
+#include <thread>
+
+using namespace Serialize;
+
+// zapisuje log ruchow do bajtow
+static std::vector<uint8_t> bytes(const MoveLog& log) {
+	std::vector<uint8_t> out;
+	ByteWriter writer(out);
+	log.write(writer);
+	return out;
+}
+
+// rozgrywa kilka rund botow i zwraca log wszystkich ruchow
+static MoveLog play(const Template& temp, size_t parallel_min, double& time) {
+	ai::parallel_min = parallel_min;
+	Map map;
+	temp.construct(&map);
+	map.random = Random::Generator(11);
+	MoveLog log;
+	auto t0 = std::chrono::steady_clock::now();
+	for (int round = 0; round < 20; round++) {
+		for (Region::Team team : ai::teams(map, Region::Unclaimed)) {
+			map.history.clear();
+			ai::generate(map, team, 0.8f);
+			log.push(map.history.log());
+			log.push(logic::turn(&map, team));
+		}
+		log.push(logic::global(&map));
+	}
+	time = ms_since(t0);
+	return log;
+}
+
+// ocena kandydatow na watkach daje te same ruchy co na jednym watku
+static void test_parallel(const char* name) {
+	auto file = Loader::load(name);
+	assert(file);
+	double serial_time, parallel_time;
+	MoveLog serial = play(file->temp, ~0ull, serial_time);
+	MoveLog parallel = play(file->temp, 0, parallel_time);
+	assert(serial.size() > 0);
+	assert(bytes(serial) == bytes(parallel));
+	std::printf("bot_tests: %s %zu moves, serial %.1f ms, parallel %.1f ms\n",
+		name, serial.size(), serial_time, parallel_time);
+}
+
+// tablica transpozycji zwraca tylko pewne wyniki
+static void test_table() {
+	ai::SearchTable table(100);
+	assert(table.size() == 128);
+	assert(!table.find(5));
+
+	ai::SearchAction best = { { 1, 2 }, { 3, 4 }, 1 };
+	table.store(5, 3, 40, 0, 100, best);
+	const auto* entry = table.find(5);
+	assert(entry && entry->bound == ai::SearchTable::Exact);
+	assert(entry->best == best);
+
+	// wynik dokladny wystarcza do glebokosci zapisu
+	assert(table.cutoff(5, 3, -1000, 1000) == 40);
+	assert(table.cutoff(5, 2, -1000, 1000) == 40);
+	assert(!table.cutoff(5, 4, -1000, 1000));
+
+	// dolne ograniczenie tnie tylko powyzej bety
+	table.store(6, 2, 150, 0, 100, best);
+	assert(table.find(6)->bound == ai::SearchTable::Lower);
+	assert(table.cutoff(6, 2, 0, 120) == 150);
+	assert(!table.cutoff(6, 2, 0, 200));
+
+	// gorne ograniczenie tnie tylko ponizej alfy
+	table.store(7, 2, -10, 0, 100, best);
+	assert(table.find(7)->bound == ai::SearchTable::Upper);
+	assert(table.cutoff(7, 2, -5, 100) == -10);
+	assert(!table.cutoff(7, 2, -20, 100));
+
+	// pozycja z tym samym slotem zastepuje poprzednia
+	table.store(5 + 128, 1, 7, 0, 100, {});
+	assert(!table.find(5));
+	assert(table.find(5 + 128)->best.empty());
+	assert(!table.cutoff(5, 1, -1000, 1000));
+}
+
+// przeszukiwanie cofa wszystkie proby i zostawia tylko wybrane ruchy
+static void test_search(const char* name) {
+	auto file = Loader::load(name);
+	assert(file);
+
+	// rozgrywka do polowy, zeby bylo czym ruszac
+	Map map;
+	file->temp.construct(&map);
+	map.random = Random::Generator(5);
+	MoveLog log;
+	std::vector<Region::Team> teams = ai::teams(map, Region::Unclaimed);
+	for (int round = 0; round < 8; round++) {
+		for (Region::Team team : teams) {
+			map.history.clear();
+			ai::generate(map, team, 0.8f);
+			log.push(map.history.log());
+			log.push(logic::turn(&map, team));
+		}
+		log.push(logic::global(&map));
+	}
+	uint64_t before = map.hash();
+	Random::Generator random = map.random;
+
+	// przeszukiwanie na malym budzecie
+	ai::SearchConfig config;
+	config.budget = 0.05;
+	config.depth = 2;
+	config.table = 1 << 12;
+	ai::SearchStats stats;
+	map.history.clear();
+	ai::search(map, teams[0], config, &stats);
+	assert(stats.nodes > 0);
+	assert(stats.moves == map.history.count().first);
+	assert(map.random.u64() == random.u64());
+
+	// przyrostowy hash zgadza sie z przeliczonym od zera
+	uint64_t after = map.hash();
+	map.rehash();
+	assert(map.hash() == after);
+
+	// te same ruchy na swiezej kopii daja ta sama mape
+	Map copy;
+	file->temp.construct(&copy);
+	log.apply(&copy);
+	assert(copy.hash() == before);
+	MoveLog chosen;
+	chosen.push(map.history.log());
+	chosen.apply(&copy);
+	assert(copy.hash() == after);
+
+	// cofniecie wybranych ruchow przywraca mape sprzed przeszukiwania
+	while (map.history.count().first)
+		map.history.undo();
+	assert(map.hash() == before);
+
+	// ponowienie z zakodowanej historii daje ta sama mape
+	while (map.history.count().second)
+		map.history.redo();
+	assert(map.history.count().first == stats.moves);
+	assert(map.hash() == after);
+	std::printf("bot_tests: %s search %zu nodes, %zu hits, %zu moves\n", name, stats.nodes, stats.hits, stats.moves);
+}
+
+// bot na najwyzszym poziomie planuje z przeszukiwaniem na kopii mapy
+static void test_adapter() {
+	auto file = Loader::load(MAP_PATH "test_map.dat");
+	assert(file);
+	bool verify = flags::verify;
+	flags::verify = true;
+
+	Map map;
+	file->temp.construct(&map);
+	BotAdapter bot(1.f);
+	Adapter& base = bot;
+	bot.map = &map;
+	bot.budget = 0.1;
+	std::vector<Messages::Player> players;
+	for (Region::Team team : ai::teams(map, Region::Unclaimed))
+		players.push_back({ .team = team });
+	base.send(Messages::init(&map, players, 3));
+
+	// gracz 0 czeka, boty planuja po kolei
+	for (int round = 0; round < 4; round++) {
+		for (uint32_t idx = 1; idx < players.size(); idx++) {
+			base.send(Messages::Select{ .id = idx });
+			std::optional<Adapter::Packet<History::UniqList>> got;
+			while (!(got = bot.recv_list()))
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			for (auto& move : got->value)
+				move->apply(&map);
+			assert(got->hash == map.hash());
+			bot.send_list({ got->value, got->id, got->hash });
+
+			auto list = logic::turn(&map, players[idx].team);
+			bot.send_list({ list, 0, map.hash() });
+		}
+	}
+	flags::verify = verify;
+}
+
+int main() {
+	size_t parallel_min = ai::parallel_min;
+	for (const char* name : { MAP_PATH "test_map.dat", MAP_PATH "river.dat", MAP_PATH "triple.dat" })
+		test_parallel(name);
+	ai::parallel_min = parallel_min;
+
+	test_table();
+	for (const char* name : { MAP_PATH "test_map.dat", MAP_PATH "triple.dat" })
+		test_search(name);
+	test_adapter();
+
+	std::printf("bot_tests: ok\n");
+	return 0;
+}
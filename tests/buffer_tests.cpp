@@ -0,0 +1,104 @@
+#include "game/serialize/buffer.hpp"
+#include <cassert>
+
+using namespace Serialize;
+
+int main() {
+	// liczby zapisywane big endian, jak w sf::Packet
+	std::vector<uint8_t> data;
+	{
+		ByteWriter writer(data);
+		writer << (uint8_t)0x12 << (int16_t)-2 << (uint32_t)0xA1B2C3D4 << true;
+		assert(writer);
+		assert(writer.size() == 8);
+	}
+	const uint8_t expect[] = { 0x12, 0xFF, 0xFE, 0xA1, 0xB2, 0xC3, 0xD4, 0x01 };
+	assert(data.size() == sizeof(expect));
+	for (size_t i = 0; i < sizeof(expect); i++)
+		assert(data[i] == expect[i]);
+
+	// odczyt w miejscu daje te same wartosci
+	{
+		ByteReader reader(data.data(), data.size());
+		uint8_t a = 0; int16_t b = 0; uint32_t c = 0; bool d = false;
+		reader >> a >> b >> c >> d;
+		assert(reader && reader.end());
+		assert(a == 0x12 && b == -2 && c == 0xA1B2C3D4 && d);
+	}
+
+	// napisy z 32-bitowa dlugoscia, takze puste
+	data.clear();
+	{
+		ByteWriter writer(data);
+		writer << std::string("hex") << std::string() << (int64_t)-5;
+	}
+	assert(data.size() == 4 + 3 + 4 + 8);
+	{
+		ByteReader reader(data.data(), data.size());
+		std::string s1, s2 = "x";
+		int64_t n = 0;
+		reader >> s1 >> s2 >> n;
+		assert(reader && reader.end());
+		assert(s1 == "hex" && s2.empty() && n == -5);
+	}
+
+	// zapis dopisuje do istniejacej zawartosci wektora
+	{
+		ByteWriter writer(data);
+		writer << (uint16_t)7;
+		assert(writer.size() == 2);
+		assert(writer.data() == data.data() + data.size() - 2);
+	}
+
+	// tryb liczenia: dokladny rozmiar bez zapisu
+	size_t size = encodedSize([](ByteWriter& writer) {
+		writer << (uint32_t)1 << std::string("abc") << (uint8_t)2;
+	});
+	assert(size == 4 + 4 + 3 + 1);
+
+	// stala pamiec: przepelnienie ustawia blad i ignoruje kolejne zapisy
+	uint8_t fixed[5] = {};
+	{
+		ByteWriter writer(std::span<uint8_t>(fixed, 4));
+		writer << (uint32_t)0x01020304;
+		assert(writer && writer.size() == 4);
+		writer << (uint8_t)9;
+		assert(!writer);
+		assert(writer.size() == 4);
+		assert(fixed[4] == 0);
+	}
+
+	// odczyt poza koncem: blad trwaly, wartosc bez zmian
+	{
+		const uint8_t bytes[] = { 0x00, 0x01, 0x02 };
+		ByteReader reader(bytes, sizeof(bytes));
+		uint16_t a = 0;
+		uint32_t b = 77;
+		reader >> a;
+		assert(reader && a == 1);
+		reader >> b;
+		assert(!reader && b == 77);
+		uint8_t c = 5;
+		reader >> c;
+		assert(!reader && c == 5);
+	}
+
+	// napis dluzszy niz dane jest odrzucany
+	{
+		const uint8_t bytes[] = { 0x00, 0x00, 0x10, 0x00, 'a' };
+		ByteReader reader(bytes, sizeof(bytes));
+		std::string s = "keep";
+		reader >> s;
+		assert(!reader && s == "keep");
+	}
+
+	// pusty czytnik
+	{
+		ByteReader reader;
+		assert(reader.end());
+		uint8_t x = 3;
+		reader >> x;
+		assert(!reader && x == 3);
+	}
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include "game/spread.hpp"
+#include "timing.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// poprzedni uklad: znaczniki odwiedzin trzymane wewnatrz kazdego pola
+struct LegacyHex : Hex {
+	size_t spread[2] = { 0, 0 };
+};
+
+static void run(int side, int iterations) {
+	HexArray arr;
+	arr.empty({ side, side });
+	std::vector<LegacyHex> legacy((size_t)side * side);
+	for (int y = 0; y < side; ++y) {
+		for (int x = 0; x < side; ++x) {
+			if (auto* h = arr.at({ x, y })) h->type = (x + y) % 7 ? Hex::Ground : Hex::Water;
+			legacy[arr.index({ x, y })].type = (x + y) % 7 ? Hex::Ground : Hex::Water;
+		}
+	}
+
+	// jedno przejscie, zeby plansza miala znaczniki
+	size_t visited = 0;
+	BasicSpread bs = { .effect = [&visited](const Spread::Tile&) { visited++; } };
+	size_t idx = bs.apply(arr, { side / 2, side / 2 });
+	for (int y = 0; y < side; ++y)
+		for (int x = 0; x < side; ++x)
+			if (arr.contains({ x, y })) legacy[arr.index({ x, y })].spread[0] = arr.mark({ x, y }, Spread::Def);
+
+	// stary uklad: skan znacznikow co sizeof(LegacyHex) bajtow
+	size_t old_hits = 0;
+	auto t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		for (const LegacyHex& hex : legacy)
+			old_hits += hex.spread[0] == idx;
+	double ms_old = ms_since(t0);
+
+	// nowy uklad: skan gestej plaszczyzny znacznikow
+	size_t new_hits = 0;
+	const size_t* marks = arr.marks(Spread::Def);
+	t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		for (size_t j = 0; j < arr.count(); ++j)
+			new_hits += marks[j] == idx;
+	double ms_new = ms_since(t0);
+
+	// punkt odniesienia: skan typu pola przez widok Hex
+	size_t solid = 0;
+	t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		for (int y = 0; y < side; ++y)
+			for (int x = 0; x < side; ++x)
+				if (Hex* hex = arr.at({ x, y })) solid += hex->solid();
+	double ms_hex = ms_since(t0);
+
+	std::printf("perf_hexscan: %4dx%-4d %4d iters | marks aos %8.2f ms | marks soa %8.2f ms | x%.2f | hex view %8.2f ms\n",
+		side, side, iterations, ms_old, ms_new, ms_new > 0 ? ms_old / ms_new : 0.0, ms_hex);
+
+	// oba uklady musza znalezc te same pola (przejscie + pole startowe)
+	if (old_hits != new_hits || new_hits != (visited + 1) * iterations || solid == 0) std::exit(1);
+}
+
+int main() {
+	std::printf("perf_hexscan: sizeof(Hex) %zu, sizeof(LegacyHex) %zu\n", sizeof(Hex), sizeof(LegacyHex));
+	run(256, 200);
+	run(1024, 10);
+	run(2048, 4);
+	return 0;
+}
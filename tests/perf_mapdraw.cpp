@@ -0,0 +1,205 @@
+#include "game/map.hpp"
+#include "game/values/hex_values.hpp"
+#include "alloc_counter.hpp"
+#include "timing.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+// okno 4K przy maksymalnym oddaleniu kamery (maxZoom w Game)
+static const sf::Vector2i window = { 3840, 2160 };
+static const float zoom = 2.0f;
+
+// poprzednie liczenie krawedzi: sprawdzanie sasiadow przy kazdym rysowaniu
+static uint8_t legacy_edges(const Map& map, sf::Vector2i pos) {
+	const Hex* hex = map.at(pos);
+	if (hex->elevated()) return Draw::MapMesh::BorderMask | Draw::MapMesh::SideMask;
+
+	uint8_t mask = 0;
+	if (hex->type == Hex::Ground) {
+		for (int i = 0; i < 6; i++) {
+			const Hex* nb = map.at(map.neighbor(pos, static_cast<Map::nbi_t>(i)));
+			if (!nb || nb->type != Hex::Ground || nb->team != hex->team || nb->elevated())
+				mask |= 1 << i;
+		}
+	}
+	const Hex* n2 = map.at(map.neighbor(pos, Map::LowerRight));
+	const Hex* n3 = map.at(map.neighbor(pos, Map::LowerLeft));
+	if (!n2 || !n2->solid() || !n3 || !n3->solid()) mask |= Draw::MapMesh::SideMask;
+	return mask;
+}
+
+// maski zgadzaja sie z liczeniem od zera na calej mapie
+static void check_edges(const Map& map) {
+	for (int y = 0; y < map.size().y; y++)
+		for (int x = 0; x < map.size().x; x++)
+			if (map.at({ x, y }))
+				assert(map.edges({ x, y }) == legacy_edges(map, { x, y }));
+}
+
+// mapa z obszarami druzyn, woda, pustym marginesem i oddzialami
+static void build(Map& map, sf::Vector2i size) {
+	map.resize({ {}, size });
+	for (int y = 0; y < size.y; y++) {
+		for (int x = 0; x < size.x; x++) {
+			Hex* hex = map.at({ x, y });
+			if (!hex) continue;
+			int edge = std::min(std::min(x, y), std::min(size.x - 1 - x, size.y - 1 - y));
+			if (edge < 2) continue;
+			bool water = edge < 4 || (x * 31 + y * 17) % 23 == 0;
+			hex->type = water ? Hex::Water : Hex::Ground;
+			if (!water) hex->team = (Region::Team)((x / 7 + y / 5) % 6);
+		}
+	}
+	for (int y = 0; y < size.y; y++) {
+		for (int x = 0; x < size.x; x++) {
+			Hex* hex = map.at({ x, y });
+			if (!hex || hex->type != Hex::Ground || (x * 13 + y * 7) % 6) continue;
+			Troop troop;
+			troop.pos = { x, y };
+			troop.type = (Troop::Type)((x + y) % Troop::Count);
+			troop.hp = 1;
+			map.setTroop(troop);
+		}
+	}
+	map.rehash();
+}
+
+// kamera na srodku mapy przy danym przyblizeniu
+static void look(Map& map, float zoom) {
+	sf::Vector2i view = sf::Vector2i(sf::Vector2f(window) * zoom);
+	map.camera = { map.backplane().getCenter() - view / 2, view };
+	map.zoom = zoom;
+}
+
+static double frame(Map& map, ui::RenderBuffer& buffer) {
+	auto t0 = std::chrono::steady_clock::now();
+	buffer.clear();
+	map.draw(buffer, 0.5f);
+	return ms_since(t0);
+}
+
+int main() {
+	Map map;
+	build(map, { 160, 120 });
+	check_edges(map);
+
+	// pelne szczegoly przy maksymalnym oddaleniu
+	look(map, zoom);
+	map.lodZoom = std::numeric_limits<float>::infinity();
+	sf::Vector2i view = map.camera.size;
+	ui::RenderBuffer buffer;
+
+	// widoczne pola
+	sf::Vector2i t0 = map.camera.position.componentWiseDiv(Values::tileOff) - sf::Vector2i(1, 1);
+	sf::Vector2i t1 = (map.camera.position + map.camera.size).componentWiseDiv(Values::tileOff) + sf::Vector2i(3, 3);
+	size_t visible = 0;
+	for (int y = t0.y; y < t1.y; y++)
+		for (int x = t0.x; x < t1.x; x++)
+			visible += map.at({ x, y }) != nullptr;
+
+	// maski krawedzi: sprawdzanie sasiadow vs odczyt gotowej maski
+	const int rounds = 200;
+	unsigned sum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		for (int y = t0.y; y < t1.y; y++)
+			for (int x = t0.x; x < t1.x; x++)
+				if (map.at({ x, y })) sum += legacy_edges(map, { x, y });
+	double probe = ms_since(start) / rounds;
+	unsigned read = 0;
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		for (int y = t0.y; y < t1.y; y++)
+			for (int x = t0.x; x < t1.x; x++)
+				if (map.at({ x, y })) read += map.edges({ x, y });
+	double lookup = ms_since(start) / rounds;
+	assert(sum == read);
+
+	// pierwsza klatka buduje wszystkie segmenty
+	double cold = frame(map, buffer);
+
+	// pelna przebudowa segmentow (zmiana zaznaczenia) z gotowymi maskami
+	double rebuild = 0;
+	for (int r = 0; r < 20; r++) {
+		map.newSelectionIndex();
+		map.stopSelection();
+		rebuild += frame(map, buffer) / 20;
+	}
+
+	// klatki bez zmian
+	double idle = 0;
+	for (int r = 0; r < 100; r++)
+		idle += frame(map, buffer) / 100;
+
+	// klatki bez zmian nie alokuja, takze z podniesionym polem i w uproszczeniu
+	sf::Vector2i mid = map.size() / 2;
+	map.lift(mid);
+	map.at(mid)->elevation = 1.f;
+	for (float lod : { std::numeric_limits<float>::infinity(), 0.f }) {
+		map.lodZoom = lod;
+		frame(map, buffer);
+		size_t before = allocations;
+		for (int r = 0; r < 10; r++)
+			frame(map, buffer);
+		assert(allocations == before);
+	}
+	map.at(mid)->elevation = 0.f;
+	map.lodZoom = std::numeric_limits<float>::infinity();
+	frame(map, buffer);
+
+	// klatki ze zmiana druzyny kilku pol
+	double touched = 0;
+	for (int r = 0; r < 100; r++) {
+		for (int i = 0; i < 4; i++) {
+			sf::Vector2i pos = mid + sf::Vector2i((r * 7 + i * 13) % 40 - 20, (r * 5 + i * 3) % 30 - 15);
+			Hex* hex = map.at(pos);
+			if (!hex || hex->type != Hex::Ground) continue;
+			hex->team = (Region::Team)((hex->team + 1) % 6);
+			map.touch(pos);
+		}
+		touched += frame(map, buffer) / 100;
+	}
+	check_edges(map);
+
+	// podniesione pole i jego opuszczenie
+	map.lift(mid);
+	map.at(mid)->elevation = 0.5f;
+	frame(map, buffer);
+	check_edges(map);
+	map.at(mid)->elevation = 0.f;
+	frame(map, buffer);
+	check_edges(map);
+
+	// poziomy przyblizenia: pelne szczegoly vs uproszczone rysowanie
+	struct Level { ui::RenderStats stats; double ms = 0; };
+	const float zooms[] = { 0.5f, 1.0f, 1.5f, 2.0f };
+	Level levels[std::size(zooms)][2];
+	for (size_t z = 0; z < std::size(zooms); z++) {
+		for (int lod = 0; lod < 2; lod++) {
+			look(map, zooms[z]);
+			map.lodZoom = lod ? 0.f : std::numeric_limits<float>::infinity();
+			frame(map, buffer);
+			for (int r = 0; r < 20; r++)
+				levels[z][lod].ms += frame(map, buffer) / 20;
+			levels[z][lod].stats = buffer.stats();
+		}
+		assert(levels[z][1].stats.vertices < levels[z][0].stats.vertices);
+		assert(levels[z][1].stats.batches < levels[z][0].stats.batches);
+	}
+
+	std::printf("perf_mapdraw: %dx%d tiles, %dx%d view, %zu visible tiles\n",
+		map.size().x, map.size().y, view.x, view.y, visible);
+	std::printf("  edges  : probe %.3f ms, lookup %.3f ms per view\n", probe, lookup);
+	std::printf("  draw   : cold %.2f ms, rebuild %.2f ms, idle %.2f ms, touched %.2f ms\n",
+		cold, rebuild, idle, touched);
+	for (size_t z = 0; z < std::size(zooms); z++) {
+		const auto& full = levels[z][0];
+		const auto& lod = levels[z][1];
+		std::printf("  zoom %.1f: full %zu V %zu B %.2f ms, lod %zu V %zu B %.2f ms\n", zooms[z],
+			full.stats.vertices, full.stats.batches, full.ms, lod.stats.vertices, lod.stats.batches, lod.ms);
+	}
+	return 0;
+}
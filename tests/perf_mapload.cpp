@@ -0,0 +1,154 @@
+#include "game/serialize/mapfile.hpp"
+#include "game/serialize/tileplane.hpp"
+#include "mapped.hpp"
+#include "timing.hpp"
+#include <SFML/Network/Packet.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// syntetyczna plansza: bajt na pole (team << 4 | type)
+static std::vector<uint8_t> synth(int side) {
+	std::vector<uint8_t> plane((size_t)side * side);
+	for (int y = 0; y < side; ++y)
+		for (int x = 0; x < side; ++x)
+			plane[(size_t)y * side + x] = (uint8_t)(((x / 64 + y / 64) % 9) << 4 | ((x + y) % 7 ? 2 : 1));
+	return plane;
+}
+
+// plansza podobna do map z gry: pusty margines, woda przy brzegu, obszary druzyn
+static std::vector<uint8_t> synth_map(int side) {
+	std::vector<uint8_t> plane((size_t)side * side);
+	int margin = side / 16;
+	for (int y = 0; y < side; ++y) {
+		for (int x = 0; x < side; ++x) {
+			int edge = std::min(std::min(x, y), std::min(side - 1 - x, side - 1 - y));
+			uint8_t byte = 0;
+			if (edge >= margin + 32) byte = (uint8_t)(((x / 160 + y / 96) % 9) << 4 | ((x * 31 + y * 17) % 101 ? 2 : 1));
+			else if (edge >= margin) byte = 1;
+			plane[(size_t)y * side + x] = byte;
+		}
+	}
+	return plane;
+}
+
+static void write_file(const std::filesystem::path& path, const void* data, size_t size) {
+	std::ofstream str(path, std::ios::binary);
+	str.write((const char*)data, size);
+}
+
+int main() {
+	const int side = 4096;
+	auto plane = synth(side);
+	auto dir = std::filesystem::temp_directory_path();
+	auto legacy_path = dir / "perf_mapload_legacy.dat";
+	auto chunk_path = dir / "perf_mapload_chunked.dat";
+
+	// stary format: sygnatura + rozmiar + bajty pol w sf::Packet
+	{
+		sf::Packet packet;
+		for (char c : { 'h', 'e', 'x', '?' }) packet << (uint8_t)c;
+		packet << (int32_t)side << (int32_t)side;
+		for (uint8_t byte : plane) packet << byte;
+		write_file(legacy_path, packet.getData(), packet.getDataSize());
+	}
+
+	// nowy format: plaszczyzna pol jako jeden chunk
+	{
+		MapFormat::Writer writer;
+		uint8_t* data = writer.chunk(MapFormat::Tiles, 8 + plane.size());
+		MapFormat::write32(data, side);
+		MapFormat::write32(data + 4, side);
+		std::copy(plane.begin(), plane.end(), data + 8);
+		auto file = writer.finish();
+		write_file(chunk_path, file.data(), file.size());
+	}
+
+	// odczyt starego formatu: ifstream -> vector -> sf::Packet -> operator>> na bajt
+	std::vector<uint16_t> legacy_tiles;
+	auto t0 = std::chrono::steady_clock::now();
+	{
+		std::ifstream str(legacy_path, std::ios::binary);
+		std::vector<char> buffer(std::istreambuf_iterator<char>(str), {});
+		sf::Packet packet;
+		packet.append(buffer.data(), buffer.size());
+		uint8_t sign[4];
+		for (uint8_t& c : sign) packet >> c;
+		int32_t w, h;
+		packet >> w >> h;
+		legacy_tiles.resize((size_t)w * h);
+		for (uint16_t& tile : legacy_tiles) {
+			uint8_t byte;
+			packet >> byte;
+			tile = (uint16_t)((byte >> 4) << 8 | (byte & 0x3));
+		}
+	}
+	double ms_legacy = ms_since(t0);
+
+	// odczyt nowego formatu: mmap -> walidacja CRC -> dekodowanie plaszczyzny w miejscu
+	std::vector<uint16_t> tiles;
+	t0 = std::chrono::steady_clock::now();
+	{
+		MappedFile file;
+		bool mapped = file.open(chunk_path);
+		assert(mapped);
+		MapFormat::View view;
+		bool valid = view.open(file.data(), file.size());
+		assert(valid);
+		auto* chunk = view.chunk(MapFormat::Tiles);
+		assert(chunk);
+		uint32_t w = MapFormat::read32(chunk->data);
+		uint32_t h = MapFormat::read32(chunk->data + 4);
+		tiles.resize((size_t)w * h);
+		const uint8_t* src = chunk->data + 8;
+		for (uint16_t& tile : tiles) {
+			uint8_t byte = *src++;
+			tile = (uint16_t)((byte >> 4) << 8 | (byte & 0x3));
+		}
+		(void)mapped; (void)valid;
+	}
+	double ms_chunked = ms_since(t0);
+
+	// oba odczyty musza dac te same pola
+	if (tiles != legacy_tiles) return 1;
+
+	// uszkodzony plik musi zostac odrzucony
+	{
+		MapFormat::Writer writer;
+		writer.chunk(MapFormat::Tiles, plane.data(), 64);
+		auto file = writer.finish();
+		file[20] ^= 1;
+		MapFormat::View view;
+		if (view.open(file.data(), file.size())) return 1;
+	}
+
+	// skompresowana plaszczyzna pol 2048x2048
+	const int map_side = 2048;
+	auto map_plane = synth_map(map_side);
+	std::vector<uint8_t> packed;
+	Serialize::ByteWriter writer(packed);
+	auto method = TilePlane::encode(writer, map_plane);
+
+	std::vector<uint8_t> unpacked(map_plane.size());
+	t0 = std::chrono::steady_clock::now();
+	{
+		Serialize::ByteReader reader(packed.data(), packed.size());
+		if (!TilePlane::decode(reader, unpacked)) return 1;
+	}
+	double ms_plane = ms_since(t0);
+	if (unpacked != map_plane) return 1;
+
+	std::filesystem::remove(legacy_path);
+	std::filesystem::remove(chunk_path);
+
+	std::printf("perf_mapload: %dx%d tiles\n", side, side);
+	std::printf("  legacy (sf::Packet) : %.2f ms\n", ms_legacy);
+	std::printf("  chunked (mmap + CRC): %.2f ms\n", ms_chunked);
+	std::printf("  tile plane %dx%d: %zu -> %zu bytes (method %d), decode %.2f ms\n",
+		map_side, map_side, map_plane.size(), packed.size(), (int)method, ms_plane);
+	return 0;
+}
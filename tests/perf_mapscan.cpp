@@ -0,0 +1,96 @@
+#include "game/loader.hpp"
+#include "game/influence.hpp"
+#include "game/template.hpp"
+#include "game/logic/turn_logic.hpp"
+#include "timing.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// duza plansza: bloki druzyn, woda co kilka pol
+static Template synth(int side) {
+	const Region::Team teams[] = { Region::Red, Region::Blue, Region::Green, Region::Yellow };
+	Template temp;
+	temp.clear({ side, side });
+	for (int y = 0; y < side; ++y) {
+		for (int x = 0; x < side; ++x) {
+			if ((x * 31 + y * 17) % 23 == 0) temp.at(x, y) = { Hex::Water };
+			else temp.at(x, y) = { Hex::Ground, teams[(x / 48 + y / 32) % 4] };
+		}
+	}
+	return temp;
+}
+
+// mierzy prawdziwe pelne skany mapy oraz skan druzyn przez Hex i przez gesta plaszczyzne
+static void run(const char* name, const Template& temp, int iterations) {
+	Map map;
+	auto t0 = std::chrono::steady_clock::now();
+	temp.construct(&map);
+	double ms_construct = ms_since(t0);
+
+	t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		map.rehash();
+	double ms_rehash = ms_since(t0) / iterations;
+
+	Influence influence;
+	t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		influence.build(map);
+	double ms_influence = ms_since(t0) / iterations;
+
+	size_t regions = 0;
+	t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		regions += Template::generate(&map).regions.size();
+	double ms_generate = ms_since(t0) / iterations;
+
+	// skan liczacy pola druzyn przez widok Hex (tak jak logic::scan)
+	size_t hex_solid = 0;
+	t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		hex_solid += logic::scan(&map).total;
+	double ms_scan = ms_since(t0) / iterations;
+
+	// gorna granica zysku z podzialu: ten sam skan po gestej kopii typu i druzyny
+	std::vector<uint8_t> plane(map.count(), 0);
+	for (int y = 0; y < map.size().y; ++y)
+		for (int x = 0; x < map.size().x; ++x)
+			if (Hex* hex = map.at({ x, y })) plane[map.index({ x, y })] = (uint8_t)(hex->solid() << 7 | hex->team);
+	size_t counts[Region::Count] = {};
+	t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		for (uint8_t byte : plane)
+			counts[byte & 0x7f] += byte >> 7;
+	double ms_plane = ms_since(t0) / iterations;
+
+	// przyrostowe liczniki, z ktorych korzysta tura
+	std::vector<Messages::Player> players;
+	for (int i = 1; i < Region::Count; ++i)
+		players.push_back({ .team = static_cast<Region::Team>(i) });
+	t0 = std::chrono::steady_clock::now();
+	size_t counted = 0;
+	for (int i = 0; i < iterations; ++i)
+		counted += logic::count(&map, players).total;
+	double ms_count = ms_since(t0) / iterations;
+
+	std::printf("perf_mapscan: %-9s %4dx%-4d | construct %7.3f | rehash %6.3f | influence %6.3f | generate %6.3f"
+		" | scan hex %6.3f plane %6.3f | count %6.4f ms\n",
+		name, map.size().x, map.size().y, ms_construct, ms_rehash, ms_influence, ms_generate, ms_scan, ms_plane, ms_count);
+
+	// oba skany widza te same pola
+	size_t total = 0;
+	for (size_t c : counts) total += c;
+	if (!regions || !counted || total != hex_solid) std::exit(1);
+}
+
+int main() {
+	for (const char* name : { "island", "river", "test_map", "triple" }) {
+		auto file = Loader::load(std::string(MAP_PATH) + name + ".dat");
+		if (!file) std::exit(1);
+		run(name, file->temp, 1000);
+	}
+	run("synth", synth(512), 5);
+	run("synth", synth(1024), 2);
+	return 0;
+}
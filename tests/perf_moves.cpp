@@ -0,0 +1,223 @@
+#include "game/loader.hpp"
+#include "game/bot_ai.hpp"
+#include "game/move_log.hpp"
+#include "game/logic/turn_logic.hpp"
+#include "game/serialize/moves.hpp"
+#include "timing.hpp"
+#include <cassert>
+#include <cstdio>
+
+using namespace Serialize;
+
+// poprzedni koder: lancuch dynamic_cast i pola stalej szerokosci
+static void legacy_encode(ByteWriter& writer, const Move* move) {
+	writer << move->skill_cooldown;
+	if (move->skill_cooldown) {
+		writer << (int16_t)move->skill_pos.x << (int16_t)move->skill_pos.y;
+		writer << (uint8_t)move->skill_type;
+	}
+	auto pos = [&](sf::Vector2i vec) { writer << (int16_t)vec.x << (int16_t)vec.y; };
+	if (auto* data = dynamic_cast<const Moves::EntityPlace*>(move)) {
+		writer << (uint8_t)M_EntityPlace << data->entity << data->var;
+	} else if (auto* data = dynamic_cast<const Moves::EntityWithdraw*>(move)) {
+		writer << (uint8_t)M_EntityWithdraw; pos(data->pos);
+	} else if (auto* data = dynamic_cast<const Moves::EntityEffect*>(move)) {
+		writer << (uint8_t)M_EntityEffect; pos(data->pos);
+		writer << (uint8_t)data->effect << (int32_t)data->peach;
+	} else if (auto* data = dynamic_cast<const Moves::TroopAttack*>(move)) {
+		writer << (uint8_t)M_TroopAttack; pos(data->dest);
+	} else if (auto* data = dynamic_cast<const Moves::TroopMove*>(move)) {
+		writer << (uint8_t)M_TroopMove; pos(data->dest);
+	} else if (auto* data = dynamic_cast<const Moves::TroopMerge*>(move)) {
+		writer << (uint8_t)M_TroopMerge; pos(data->dest);
+	} else if (auto* data = dynamic_cast<const Moves::TroopHeal*>(move)) {
+		writer << (uint8_t)M_TroopHeal; pos(data->mid);
+		writer << (uint64_t)data->radius << (int32_t)data->heal << (uint8_t)data->team;
+	} else if (auto* data = dynamic_cast<const Moves::PlantCut*>(move)) {
+		writer << (uint8_t)M_PlantCut; pos(data->pos);
+	} else if (auto* data = dynamic_cast<const Moves::PlantMod*>(move)) {
+		writer << (uint8_t)M_PlantMod; pos(data->mid);
+		writer << (uint64_t)data->radius;
+	} else if (auto* data = dynamic_cast<const Moves::RadiusEffect*>(move)) {
+		writer << (uint8_t)M_RadiusEffect; pos(data->mid);
+		writer << (uint64_t)data->radius << (uint8_t)data->effect << (uint8_t)data->team;
+	} else if (auto* data = dynamic_cast<const Moves::EntityChange*>(move)) {
+		writer << (uint8_t)M_EntityChange << data->state;
+	} else if (auto* data = dynamic_cast<const Moves::RegionChange*>(move)) {
+		writer << (uint8_t)M_RegionChange << data->state.res() << data->state.var() << data->state.dead;
+	}
+}
+
+int main() {
+	auto file = Loader::load(MAP_PATH "test_map.dat");
+	assert(file);
+	if (!file) return 1;
+
+	// rozgrywka botow nagrywana do logu ruchow
+	Map map;
+	file->temp.construct(&map);
+	map.random = Random::Generator(1);
+	std::vector<Messages::Player> players;
+	for (Region::Team team : ai::teams(map, Region::Unclaimed))
+		players.push_back({ .team = team });
+
+	MoveLog log;
+	uint32_t turns = 0;
+	bool over = false;
+	for (turns = 1; turns <= 1000 && !over; turns++) {
+		for (const auto& player : players) {
+			map.history.clear();
+			ai::generate(map, player.team, 0.5f);
+			log.push(map.history.log());
+			log.push(logic::turn(&map, player.team));
+			if (logic::win(logic::count(&map, players)) != Region::Unclaimed) {
+				over = true;
+				break;
+			}
+		}
+		if (!over) log.push(logic::global(&map));
+	}
+	assert(log.size() > 0);
+
+	// round-trip: dekodowanie i ponowne kodowanie daje te same bajty
+	auto moves = log.decode();
+	for (const auto& move : moves) {
+		assert(move);
+		(void)move;
+	}
+	MoveLog again;
+	again.push(moves);
+	std::vector<uint8_t> a, b;
+	{
+		ByteWriter wa(a), wb(b);
+		log.write(wa);
+		again.write(wb);
+	}
+	assert(a == b);
+
+	// kopiowanie zakodowanych ruchow miedzy logami i zdejmowanie ostatniego
+	MoveLog copy;
+	for (size_t i = 0; i < log.size(); i++)
+		copy.push(log, i);
+	copy.pop();
+	copy.push(log, log.size() - 1);
+	MoveLog joined;
+	joined.push(copy);
+	std::vector<uint8_t> c;
+	{
+		ByteWriter wc(c);
+		joined.write(wc);
+	}
+	assert(c == a && joined.bytes() == log.bytes());
+
+	// odczyt zapisanych bajtow daje ten sam log
+	MoveLog read;
+	ByteReader reader(a.data(), a.size());
+	bool valid = read.read(reader);
+	assert(valid && reader.end());
+	assert(read.size() == log.size() && read.bytes() == log.bytes());
+
+	// uciety zapis nie zmienia logu
+	ByteReader cut(a.data(), a.size() / 2);
+	valid = read.read(cut);
+	assert(!valid);
+	assert(read.size() == log.size() && read.bytes() == log.bytes());
+	(void)valid;
+
+	// wartosci enum spoza zakresu odrzucaja ruch
+	{
+		Moves::RadiusEffect effect({ 3, 4 }, 2, EffectType::Stunned, Region::Red);
+		std::vector<uint8_t> bytes;
+		{
+			ByteWriter writer(bytes);
+			encodeMove(writer, &effect);
+		}
+		ByteReader ok(bytes.data(), bytes.size());
+		assert(decodeMove(ok));
+
+		bytes[bytes.size() - 1] = 0xff; // druzyna
+		ByteReader team(bytes.data(), bytes.size());
+		assert(!decodeMove(team));
+
+		bytes[bytes.size() - 1] = Region::Red;
+		bytes[bytes.size() - 2] = 0xff; // efekt
+		ByteReader kind(bytes.data(), bytes.size());
+		assert(!decodeMove(kind));
+	}
+
+	// odczyt logu sprawdza tylko naglowki, bledne pola wychodza przy dekodowaniu
+	{
+		MoveLog single;
+		Moves::RadiusEffect effect({ 3, 4 }, 2, EffectType::Stunned, Region::Red);
+		single.push(&effect);
+		std::vector<uint8_t> bytes;
+		{
+			ByteWriter writer(bytes);
+			single.write(writer);
+		}
+		bytes[bytes.size() - 1] = 0xff; // druzyna
+
+		MoveLog broken;
+		ByteReader in(bytes.data(), bytes.size());
+		bool header = broken.read(in);
+		assert(header && in.end() && broken.size() == 1);
+		assert(broken.at(0).tag == M_RadiusEffect);
+		assert(!broken.decode(0));
+		(void)header;
+	}
+
+	// odtworzenie rozgrywki na swiezej mapie
+	Map replay;
+	file->temp.construct(&replay);
+	log.apply(&replay);
+	bool match = replay.hash() == map.hash();
+
+	// przepustowosc: nowy koder tablicowy do wielokrotnie uzywanego bufora
+	const int rounds = 10;
+	auto t0 = std::chrono::steady_clock::now();
+	size_t bytes = 0;
+	std::vector<uint8_t> buffer;
+	for (int r = 0; r < rounds; r++) {
+		buffer.clear();
+		ByteWriter writer(buffer);
+		for (const auto& move : moves)
+			encodeMove(writer, move.get());
+		bytes = writer.size();
+	}
+	double encode = ms_since(t0) / 1000.0;
+
+	// rozmiar z przebiegu liczacego zgadza sie z zapisem
+	size_t counted = encodedSize([&](ByteWriter& writer) {
+		for (const auto& move : moves)
+			encodeMove(writer, move.get());
+	});
+	assert(counted == bytes);
+	(void)counted;
+
+	t0 = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++) {
+		auto list = log.decode();
+		assert(list.size() == moves.size());
+	}
+	double decode = ms_since(t0) / 1000.0;
+
+	// przepustowosc: poprzedni koder
+	t0 = std::chrono::steady_clock::now();
+	size_t legacy_bytes = 0;
+	for (int r = 0; r < rounds; r++) {
+		buffer.clear();
+		ByteWriter writer(buffer);
+		for (const auto& move : moves)
+			legacy_encode(writer, move.get());
+		legacy_bytes = writer.size();
+	}
+	double legacy = ms_since(t0) / 1000.0;
+
+	double count = (double)moves.size();
+	std::printf("perf_moves: %zu moves in %u turns (replay %s)\n", moves.size(), turns - 1, match ? "matches" : "differs");
+	std::printf("  legacy : %.2f bytes/move, encode %.0f moves/s\n", legacy_bytes / count, count * rounds / legacy);
+	std::printf("  table  : %.2f bytes/move, encode %.0f moves/s, decode %.0f moves/s\n",
+		bytes / count, count * rounds / encode, count * rounds / decode);
+	std::printf("  log    : %.2f bytes/move with records\n", log.bytes() / count);
+	return 0;
+}
@@ -0,0 +1,211 @@
+#include <pool>
+#include <refpool>
+#include "alloc_counter.hpp"
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+// element puli z referencja do innego elementu (jak laczenie regionow)
+struct Node {
+	int value = 0;
+	RefPool<Node>::Share link;
+};
+
+// poprzednia implementacja (zbior usunietych indeksow) jako punkt odniesienia
+struct LegacyPool {
+	std::vector<int> storage;
+	std::set<size_t> deleted;
+
+	size_t add(int item) {
+		if (deleted.empty()) {
+			storage.push_back(item);
+			return storage.size() - 1;
+		}
+		size_t idx = *deleted.begin();
+		deleted.erase(deleted.begin());
+		storage[idx] = item;
+		return idx;
+	}
+	void pop(size_t idx) {
+		if (idx + 1 == storage.size()) {
+			storage.pop_back();
+			while (!deleted.empty() && *deleted.rbegin() + 1 == storage.size()) {
+				deleted.erase(std::next(deleted.rbegin()).base());
+				storage.pop_back();
+			}
+			return;
+		}
+		deleted.insert(idx);
+	}
+	long long sum() const {
+		long long total = 0;
+		auto it = deleted.cbegin();
+		for (size_t i = 0; i < storage.size(); i++) {
+			if (it != deleted.cend() && *it == i) { it++; continue; }
+			total += storage[i];
+		}
+		return total;
+	}
+};
+
+// losowe operacje na Pool porownywane z modelem
+static void stress_pool(unsigned seed) {
+	std::mt19937 rng(seed);
+	Pool<int> pool;
+	std::vector<Pool<int>::Item> items;
+	std::map<size_t, int> model;
+
+	for (int step = 0; step < 200000; step++) {
+		if (items.empty() || rng() % 3) {
+			int value = (int)(rng() % 1000000);
+			items.push_back(pool.add(value));
+			model[items.back().index()] = value;
+		}
+		else {
+			size_t i = rng() % items.size();
+			model.erase(items[i].index());
+			std::swap(items[i], items.back());
+			items.pop_back();
+		}
+
+		// okresowo sprawdz iteracje, licznik i wartosci
+		if (step % 997 == 0) {
+			assert(pool.count() == items.size());
+			for (auto& item : items)
+				assert(model[item.index()] == *item);
+			long long sum = 0, expect = 0;
+			size_t seen = 0;
+			auto it = pool.iter();
+			while (int* ptr = it.next()) {
+				sum += *ptr;
+				seen++;
+			}
+			for (auto& [idx, value] : model) expect += value;
+			assert(seen == model.size() && sum == expect);
+		}
+	}
+
+	// usuwanie podczas iteracji
+	auto it = pool.iter();
+	while (int* ptr = it.next()) {
+		for (size_t i = 0; i < items.size(); i++) {
+			if (&*items[i] == ptr) {
+				std::swap(items[i], items.back());
+				items.pop_back();
+				break;
+			}
+		}
+	}
+	assert(pool.count() == 0 && items.empty());
+}
+
+// losowe operacje na RefPool z kopiami referencji i lancuchami powiazan
+static void stress_refpool(unsigned seed) {
+	std::mt19937 rng(seed);
+	RefPool<Node> pool;
+	std::vector<RefPool<Node>::Share> refs;
+
+	for (int step = 0; step < 200000; step++) {
+		int op = rng() % 4;
+		if (refs.empty() || op == 0) {
+			refs.push_back(pool.add({ .value = step }));
+		}
+		else if (op == 1) {
+			// kopia referencji
+			refs.push_back(refs[rng() % refs.size()]);
+		}
+		else if (op == 2) {
+			// powiazanie dwoch elementow
+			auto& a = refs[rng() % refs.size()];
+			auto& b = refs[rng() % refs.size()];
+			if (a != b && !b->link) a->link = b;
+		}
+		else {
+			size_t i = rng() % refs.size();
+			std::swap(refs[i], refs.back());
+			refs.pop_back();
+		}
+
+		// okresowo sprawdz, czy kazdy osiagalny element jest zywy
+		if (step % 997 == 0) {
+			std::set<Node*> live;
+			for (auto& ref : refs) {
+				for (const RefPool<Node>::Share* now = &ref; *now; now = &(*now)->link)
+					if (!live.insert(&**now).second) break;
+			}
+			size_t seen = 0;
+			auto it = pool.iter();
+			while (Node* node = it.next()) {
+				assert(live.count(node));
+				seen++;
+			}
+			assert(seen == live.size() && pool.count() == live.size());
+		}
+	}
+	refs.clear();
+	assert(pool.count() == 0);
+}
+
+// przelewanie elementow: dodawanie i usuwanie w losowej kolejnosci
+static void bench(size_t live, int rounds) {
+	std::mt19937 rng(1234);
+	std::vector<size_t> order(live);
+	for (size_t i = 0; i < live; i++) order[i] = rng() % live;
+
+	// stara implementacja
+	LegacyPool legacy;
+	std::vector<size_t> lidx;
+	for (size_t i = 0; i < live; i++) lidx.push_back(legacy.add((int)i));
+	size_t lallocs = allocations;
+	auto t0 = std::chrono::steady_clock::now();
+	long long lsum = 0;
+	for (int r = 0; r < rounds; r++) {
+		for (size_t i : order) {
+			legacy.pop(lidx[i]);
+			lidx[i] = legacy.add((int)i);
+		}
+		lsum += legacy.sum();
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	lallocs = allocations - lallocs;
+
+	// nowa implementacja
+	Pool<int> pool;
+	std::vector<Pool<int>::Item> items;
+	items.reserve(live);
+	for (size_t i = 0; i < live; i++) items.push_back(pool.add((int)i));
+	size_t allocs = allocations;
+	auto t2 = std::chrono::steady_clock::now();
+	long long psum = 0;
+	for (int r = 0; r < rounds; r++) {
+		for (size_t i : order) {
+			items[i] = Pool<int>::Item();
+			items[i] = pool.add((int)i);
+		}
+		auto it = pool.iter();
+		while (int* ptr = it.next()) psum += *ptr;
+	}
+	auto t3 = std::chrono::steady_clock::now();
+	allocs = allocations - allocs;
+
+	auto ms_old = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() / 1000.0;
+	auto ms_new = std::chrono::duration_cast<std::chrono::microseconds>(t3 - t2).count() / 1000.0;
+	std::printf("perf_pool: %7zu items %3d rounds | set %9.2f ms (%zu allocs) | free list %9.2f ms (%zu allocs) | x%.2f\n",
+		live, rounds, ms_old, lallocs, ms_new, allocs, ms_new > 0 ? ms_old / ms_new : 0.0);
+
+	// te same elementy, bez alokacji w stanie ustalonym
+	if (lsum != psum || allocs != 0) std::exit(1);
+}
+
+int main() {
+	stress_pool(7);
+	stress_refpool(11);
+	bench(1000, 200);
+	bench(100000, 5);
+	return 0;
+}
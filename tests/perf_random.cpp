@@ -2,21 +2,68 @@
 #include <chrono>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// poprzednia implementacja: 4 wywolania rand() na liczbe 32-bitowa
+static uint32_t legacy_u32() {
+	auto u8 = []() -> uint32_t { return rand() & 0xff; };
+	return u8() | u8() << 8 | u8() << 16 | u8() << 24;
+}
+
+template <typename F>
+static long long measure(F&& f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
 
 int main() {
 	const int iterations = 5'000'000;
 	Random::seed(1234);
+	srand(1234);
 
-	auto start = std::chrono::steady_clock::now();
+	// rand()
+	uint32_t acc_legacy = 0;
+	long long ms_legacy = measure([&]() {
+		for (int i = 0; i < iterations; ++i)
+			acc_legacy ^= legacy_u32();
+	});
+
+	// Random::u32() (generator watku)
 	uint32_t acc = 0;
-	for (int i = 0; i < iterations; ++i)
-		acc ^= Random::u32();
-	auto end = std::chrono::steady_clock::now();
+	long long ms = measure([&]() {
+		for (int i = 0; i < iterations; ++i)
+			acc ^= Random::u32();
+	});
+
+	// Random::Generator::u64()
+	Random::Generator gen(1234);
+	uint64_t acc_gen = 0;
+	long long ms_gen = measure([&]() {
+		for (int i = 0; i < iterations; ++i)
+			acc_gen ^= gen.u64();
+	});
+
+	// Random::Generator::fill()
+	Random::Generator batch(1234);
+	std::vector<uint64_t> buf(4096);
+	uint64_t acc_fill = 0;
+	long long ms_fill = measure([&]() {
+		for (int i = 0; i < iterations; i += (int)buf.size()) {
+			batch.fill(buf.data(), buf.size());
+			for (uint64_t v : buf) acc_fill ^= v;
+		}
+	});
 
-	auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-	// prosta sanity-check: wynik powinien by niezerowy
-	if (acc == 0) return 1;
+	// prosta sanity-check: wynik powinien byc niezerowy
+	if (acc == 0 || acc_legacy == 0 || acc_gen == 0 || acc_fill == 0) return 1;
 
-	std::printf("perf_random: %d iters in %lld ms\n", iterations, static_cast<long long>(ms));
+	std::printf("perf_random: %d iters\n", iterations);
+	std::printf("  rand() x4      : %lld ms\n", ms_legacy);
+	std::printf("  Random::u32    : %lld ms\n", ms);
+	std::printf("  Generator::u64 : %lld ms\n", ms_gen);
+	std::printf("  Generator::fill: %lld ms\n", ms_fill);
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,99 @@
+#include "game/spread.hpp"
+#include "alloc_counter.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+// poprzednia implementacja (kolejka std::list + lista std::deque) jako punkt odniesienia
+static size_t legacy_apply(const Spread& sp, const HexArray& arr, sf::Vector2i pos) {
+	size_t idx = Spread::index(sp.alt);
+	Hex* origin = arr.at(pos);
+	if (!origin) return 0;
+	size_t* marks = arr.marks(sp.alt);
+	marks[arr.index(pos)] = idx;
+
+	size_t visited = 0;
+	std::list<Spread::Tile> queue;
+	queue.push_back({ { origin, pos }, ~0ull });
+	bool first = true;
+	while (!queue.empty()) {
+		Spread::Tile tile = queue.front();
+		queue.pop_front();
+		if (!first && sp.pass(tile)) {
+			sp.effect(tile);
+			visited++;
+		}
+		first = false;
+
+		for (int i = 0; i < 6; i++) {
+			Spread::Tile next = { arr.atref(arr.neighbor(tile.pos, static_cast<HexArray::nbi_t>(i))), tile.left - 1 };
+			if (!next.hex || marks[arr.index(next.pos)] == idx) continue;
+			marks[arr.index(next.pos)] = idx;
+			if (sp.hop(next)) queue.push_back(next);
+		}
+	}
+	return visited;
+}
+
+static void run(int side, int iterations) {
+	HexArray arr;
+	arr.empty({ side, side });
+	for (int y = 0; y < side; ++y)
+		for (int x = 0; x < side; ++x)
+			if (auto* h = arr.at({ x, y })) h->type = Hex::Ground;
+
+	size_t hits = 0;
+	Spread sp;
+	sp.hop = [](const Spread::Tile& tile) { return tile.hex->solid(); };
+	sp.effect = [&hits](const Spread::Tile&) { hits++; };
+	sf::Vector2i mid = { side / 2, side / 2 };
+
+	// stara implementacja
+	auto t0 = std::chrono::steady_clock::now();
+	size_t legacy = 0;
+	for (int i = 0; i < iterations; ++i)
+		legacy += legacy_apply(sp, arr, mid);
+	auto t1 = std::chrono::steady_clock::now();
+
+	// rozgrzewka: bufor kolejki zostaje przydzielony raz
+	sp.apply(arr, mid);
+
+	// nowa implementacja
+	hits = 0;
+	size_t allocs = allocations;
+	auto t2 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		sp.apply(arr, mid);
+	auto t3 = std::chrono::steady_clock::now();
+	allocs = allocations - allocs;
+
+	// predykaty typowane statycznie (bez std::function)
+	size_t fast = 0;
+	BasicSpread bs = {
+		.hop = [](const Spread::Tile& tile) { return tile.hex->solid(); },
+		.effect = [&fast](const Spread::Tile&) { fast++; }
+	};
+	size_t bs_allocs = allocations;
+	auto t4 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i)
+		bs.apply(arr, mid);
+	auto t5 = std::chrono::steady_clock::now();
+	bs_allocs = allocations - bs_allocs;
+
+	auto ms_old = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() / 1000.0;
+	auto ms_new = std::chrono::duration_cast<std::chrono::microseconds>(t3 - t2).count() / 1000.0;
+	auto ms_bs = std::chrono::duration_cast<std::chrono::microseconds>(t5 - t4).count() / 1000.0;
+	std::printf("perf_spread: %4dx%-4d %4d iters | list %9.2f ms | ring %9.2f ms | static %9.2f ms | x%.2f | allocs %zu\n",
+		side, side, iterations, ms_old, ms_new, ms_bs, ms_bs > 0 ? ms_old / ms_bs : 0.0, allocs + bs_allocs);
+
+	// wszystkie implementacje musza odwiedzic te same pola, bez alokacji w stanie ustalonym
+	if (hits != legacy || fast != legacy || allocs != 0 || bs_allocs != 0) std::exit(1);
+}
+
+int main() {
+	run(64, 400);
+	run(256, 25);
+	run(1024, 2);
+	return 0;
+}
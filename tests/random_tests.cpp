@@ -32,5 +32,33 @@ int main() {
 	assert(r3 == true);
 	assert(fail == 0);
 
+	// generator: ten sam seed daje ten sam ciag
+	Random::Generator g1(42), g2(42);
+	for (int i = 0; i < 16; ++i)
+		assert(g1.u64() == g2.u64());
+
+	// generator: fill daje te same liczby co kolejne u64()
+	uint64_t batch[8];
+	g1.fill(batch, 8);
+	for (uint64_t v : batch)
+		assert(v == g2.u64());
+
+	// generator: strumienie sa niezalezne i nie zmieniaja stanu
+	Random::Generator s1 = g1.stream(1), s2 = g1.stream(2);
+	uint64_t a = s1.u64(), b = s2.u64();
+	assert(a != b);
+	assert(g1.u64() == g2.u64());
+	assert(g1.stream(0).u64() == g2.u64());
+
+	// generator: host i klient z tym samym seedem losuja to samo,
+	// a kopia nie przesuwa stanu
+	Random::Generator host, client;
+	host.seed(0x1234abcdull);
+	uint64_t peek = Random::Generator(host).u64();
+	client.seed(0x1234abcdull);
+	assert(Random::Generator(client).u64() == peek);
+	for (int i = 0; i < 16; ++i)
+		assert(host.u64() == client.u64());
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "game/map.hpp"
+#include "game/template.hpp"
+#include "game/moves/troop_move.hpp"
+#include <cassert>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <vector>
+
+// ruch zajmujacy pole, z informacja czy wojsko zostalo dostawione
+struct Capture {
+	sf::Vector2i from;
+	bool placed = false;
+};
+
+// zajmuje pole wojskiem stojacym na sasiednim polu, tak jak gracz
+static Capture capture(Map& map, sf::Vector2i from, sf::Vector2i pos) {
+	Capture cap = { from };
+	if (!map.at(from)->troop) {
+		Troop troop;
+		troop.type = Troop::Knight;
+		troop.pos = from;
+		map.setTroop(troop);
+		cap.placed = true;
+	}
+	auto* move = new Moves::TroopMove(pos);
+	move->skill_pos = from;
+	map.history.add(move);
+	return cap;
+}
+
+// cofa zajecie pola i zdejmuje dostawione wojsko
+static void undo(Map& map, const Capture& cap) {
+	map.history.undo();
+	if (cap.placed) map.removeEntity(map.at(cap.from));
+}
+
+// liczba regionow druzyny widocznych w indeksie
+static size_t indexed(Map& map, Region::Team team) {
+	size_t count = 0;
+	map.regions.foreach(&map, team, [&](Region& reg, sf::Vector2i) {
+		assert(!reg.link);
+		(void)reg;
+		count++;
+	});
+	return count;
+}
+
+// etykieta regionu kazdego pola: najmniejszy indeks pola w regionie
+static std::vector<int> labels(Map& map) {
+	std::map<const Region*, int> first;
+	std::vector<int> out(map.count(), -1);
+	for (int y = 0; y < map.size().y; y++) {
+		for (int x = 0; x < map.size().x; x++) {
+			Hex* hex = map.at({ x, y });
+			if (!hex || !hex->region()) continue;
+			auto [it, added] = first.insert({ &*hex->region(), y * map.size().x + x });
+			out[y * map.size().x + x] = it->second;
+		}
+	}
+	return out;
+}
+
+// porownuje mape z mapa zbudowana od zera przez enumerate()
+static void check_rebuild(Map& map) {
+	Map fresh;
+	Template::generate(&map).construct(&fresh);
+	assert(labels(map) == labels(fresh));
+	assert(map.hash() == fresh.hash());
+
+	// liczniki pol zgadzaja sie z polami regionu
+	std::map<const Region*, int> tiles;
+	std::set<const Region*> teams[Region::Count];
+	for (int y = 0; y < map.size().y; y++) {
+		for (int x = 0; x < map.size().x; x++) {
+			Hex* hex = map.at({ x, y });
+			if (!hex || !hex->region()) continue;
+			const auto& reg = hex->region();
+			assert(reg->team == hex->team);
+			tiles[&*reg]++;
+			teams[reg->team].insert(&*reg);
+		}
+	}
+	for (const auto& [reg, count] : tiles)
+		assert(reg->tiles == count);
+
+	// indeks zawiera tylko zywe regiony
+	for (int i = 0; i < Region::Count; i++)
+		assert(indexed(map, static_cast<Region::Team>(i)) == teams[i].size());
+}
+
+// pusta mapa 9x9 jednej druzyny (parzyste wiersze sa o pole krotsze)
+static Template field(Region::Team team) {
+	Template temp;
+	temp.clear({ 9, 9 });
+	for (int y = 0; y < 9; y++)
+		for (int x = 0; x < 9; x++)
+			temp.at(x, y) = { Hex::Ground, team };
+	return temp;
+}
+
+// gwiazda z trzech ramion rozdzielona po zajeciu srodka
+static void test_split() {
+	sf::Vector2i mid = { 4, 4 };
+	sf::Vector2i ends[3];
+	Template temp = field(Region::Blue);
+	temp.at(mid.x, mid.y).team = Region::Red;
+	for (int arm = 0; arm < 3; arm++) {
+		sf::Vector2i pos = mid;
+		for (int i = 0; i <= arm; i++) {
+			pos = Map::neighbor(pos, static_cast<Map::nbi_t>(arm * 2));
+			temp.at(pos.x, pos.y).team = Region::Red;
+		}
+		ends[arm] = pos;
+	}
+
+	Map map;
+	temp.construct(&map);
+	Regions::Ref red = map.at(mid)->region();
+	assert(red->tiles == 7);
+	red->setRes({ .money = 10, .berry = 4 });
+	map.regions.touch(red);
+	uint64_t before = map.hash();
+	check_rebuild(map);
+
+	// zajecie srodka dzieli region na trzy czesci
+	Capture cap = capture(map, Map::neighbor(mid, static_cast<Map::nbi_t>(1)), mid);
+	check_rebuild(map);
+	assert(map.at(mid)->team == Region::Blue);
+	assert(indexed(map, Region::Red) == 3);
+	RegionRes total;
+	for (int arm = 0; arm < 3; arm++) {
+		const auto& part = map.at(ends[arm])->region();
+		assert(part->tiles == arm + 1);
+		assert(part->money >= 3 && part->money <= 4);
+		total.add(*part);
+	}
+	assert(total.money == 10 && total.berry == 4);
+
+	// najwieksza czesc zostaje w poprzednim regionie
+	assert(map.at(ends[2])->region() == red);
+	assert(map.at(ends[0])->region() != red);
+	assert(map.at(ends[1])->region() != red);
+
+	// cofniecie laczy czesci z powrotem
+	undo(map, cap);
+	check_rebuild(map);
+	assert(indexed(map, Region::Red) == 1);
+	assert(map.at(mid)->region()->tiles == 7);
+	assert(map.at(mid)->region()->money == 10);
+	assert(map.hash() == before);
+}
+
+// dwa regiony laczone przez zajecie pola miedzy nimi
+static void test_merge() {
+	sf::Vector2i mid = { 4, 4 };
+	sf::Vector2i left = Map::neighbor(mid, static_cast<Map::nbi_t>(3));
+	sf::Vector2i far = Map::neighbor(left, static_cast<Map::nbi_t>(3));
+	sf::Vector2i right = Map::neighbor(mid, static_cast<Map::nbi_t>(0));
+	Template temp = field(Region::Blue);
+	for (sf::Vector2i pos : { left, far, right })
+		temp.at(pos.x, pos.y).team = Region::Red;
+
+	Map map;
+	temp.construct(&map);
+	map.at(left)->region()->setRes({ .money = 6 });
+	map.at(right)->region()->setRes({ .money = 4, .peach = 2 });
+	map.regions.touch(map.at(left)->region());
+	map.regions.touch(map.at(right)->region());
+	uint64_t before = map.hash();
+	assert(indexed(map, Region::Red) == 2);
+
+	// polaczony region ma wszystkie pola i zasoby
+	Capture cap = capture(map, right, mid);
+	check_rebuild(map);
+	assert(indexed(map, Region::Red) == 1);
+	const auto& reg = map.at(far)->region();
+	assert(reg == map.at(right)->region());
+	assert(reg->tiles == 4);
+	assert(reg->money == 10 && reg->peach == 2);
+
+	// cofniecie przywraca oba regiony z ich zasobami
+	undo(map, cap);
+	check_rebuild(map);
+	assert(indexed(map, Region::Red) == 2);
+	assert(map.at(left)->region() != map.at(right)->region());
+	assert(map.at(left)->region()->money == 6);
+	assert(map.at(right)->region()->money == 4);
+	assert(map.at(right)->region()->peach == 2);
+	assert(map.hash() == before);
+}
+
+// losowe zajecia i cofniecia porownywane z pelnym enumerate()
+static void test_random(uint64_t seed) {
+	Random::Generator random(seed);
+	const Region::Team teams[] = { Region::Red, Region::Blue, Region::Green };
+
+	Template temp;
+	temp.clear({ 12, 12 });
+	for (int y = 0; y < 12; y++) {
+		for (int x = 0; x < 12; x++) {
+			if (random.uniform() < 0.1f) temp.at(x, y) = { Hex::Water };
+			else temp.at(x, y) = { Hex::Ground, teams[random.u64() % 3] };
+		}
+	}
+
+	Map map;
+	temp.construct(&map);
+	uint64_t start = map.hash();
+	std::vector<int> start_labels = labels(map);
+
+	std::vector<Capture> done;
+	for (int step = 0; step < 400; step++) {
+		// czasem cofnij ostatnie zajecie
+		if (!done.empty() && random.uniform() < 0.3f) {
+			undo(map, done.back());
+			done.pop_back();
+			check_rebuild(map);
+			continue;
+		}
+
+		// zajmij losowe pole z sasiedniego pola innej druzyny
+		sf::Vector2i pos = { (int)(random.u64() % 12), (int)(random.u64() % 12) };
+		if (!map.at(pos) || !map.at(pos)->solid()) continue;
+		int nbi = (int)(random.u64() % 6);
+		for (int i = 0; i < 6; i++) {
+			sf::Vector2i from = Map::neighbor(pos, static_cast<Map::nbi_t>((nbi + i) % 6));
+			Hex* hex = map.at(from);
+			if (!hex || !hex->solid() || hex->team == map.at(pos)->team) continue;
+			done.push_back(capture(map, from, pos));
+			break;
+		}
+		check_rebuild(map);
+	}
+
+	// cofniecie wszystkiego przywraca mape poczatkowa
+	while (!done.empty()) {
+		undo(map, done.back());
+		done.pop_back();
+	}
+	check_rebuild(map);
+	assert(labels(map) == start_labels);
+	assert(map.hash() == start);
+}
+
+int main() {
+	test_split();
+	test_merge();
+	for (uint64_t seed = 1; seed <= 8; seed++)
+		test_random(seed);
+
+	std::printf("region_tests: ok\n");
+	return 0;
+}
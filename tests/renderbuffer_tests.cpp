@@ -0,0 +1,57 @@
+#include "ui/buffer.hpp"
+#include "alloc_counter.hpp"
+#include <cassert>
+
+static const sf::Texture atlas, icons;
+
+// klatka podobna do interfejsu: panele, ikony, przyciete elementy i geometria z pamieci podrecznej
+static void frame(ui::RenderBuffer& buffer, const std::vector<sf::Vertex>& cache) {
+	buffer.clear();
+	for (int panel = 0; panel < 40; panel++) {
+		buffer.quad({ { panel * 10, 0 }, { 100, 40 } }, {}, sf::Color::Black);
+		buffer.forward(nullptr);
+
+		buffer.scissor({ { panel * 10, 0 }, { 100, 40 } });
+		for (int icon = 0; icon < 8; icon++)
+			buffer.quad({ { icon * 8, 4 }, { 8, 8 } }, { { icon * 16, 0 }, { 16, 16 } });
+		buffer.triangle({ { 0, 0 } }, { { 0, 8 } }, { { 8, 8 } });
+		buffer.forward(&icons);
+		buffer.unscissor();
+	}
+	buffer.cached(cache, { 4.f, 4.f }, false);
+	buffer.forward(&atlas);
+	buffer.cached(cache, { 8.f, 8.f }, false);
+	buffer.forward(&atlas);
+}
+
+int main() {
+	std::vector<sf::Vertex> cache(6 * 100);
+	ui::RenderBuffer buffer;
+
+	// pierwsza klatka rezerwuje pamiec
+	frame(buffer, cache);
+	auto first = buffer.stats();
+	assert(first.quads == 40 * 9 + 200);
+	assert(first.triangles == 40);
+	assert(first.vertices == first.quads * 6 + first.triangles * 3);
+	assert(first.cached == 2);
+
+	// kolejne forwardy z ta sama tekstura lacza sie w jedna partie
+	assert(first.batches == 40 * 2 + 1);
+
+	// kolejne klatki nie alokuja
+	for (int i = 0; i < 10; i++) {
+		size_t before = allocations;
+		frame(buffer, cache);
+		auto stats = buffer.stats();
+		assert(allocations == before);
+		assert(stats.vertices == first.vertices && stats.batches == first.batches);
+		(void)stats;
+	}
+
+	// zawartosc bufora po wyczyszczeniu
+	buffer.clear();
+	assert(buffer.vertices().empty());
+	assert(buffer.stats().batches == 0);
+	return 0;
+}
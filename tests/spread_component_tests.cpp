@@ -1,5 +1,8 @@
 #include "game/spread.hpp"
+#include "game/radius.hpp"
 #include "game/array.hpp"
+#include "workers.hpp"
+#include <algorithm>
 #include <cassert>
 
 int main() {
@@ -25,5 +28,70 @@ int main() {
 		assert(!(p == sf::Vector2i{ 1, 1 })); // origin nie powinien by w visited
 		assert(HexArray::distance(p, { 1, 1 }) == 1);
 	}
+
+	// wersja typowana statycznie musi odwiedzic te same pola
+	int fast = 0;
+	BasicSpread bs = { .effect = [&](const Spread::Tile&) { fast++; } };
+	auto fast_visited = bs.applylist(arr, { 1, 1 }, 1);
+	assert(fast == hits);
+	assert(fast_visited == visited);
+
+	// konwersja do Spread zachowuje predykaty
+	Spread erased = bs;
+	auto erased_visited = erased.applylist(arr, { 1, 1 }, 1);
+	assert(fast == 2 * hits);
+	assert(erased_visited == visited);
+
+	// widoki mapy na watkach roboczych odwiedzaja te same pola
+	Workers workers(4);
+	std::vector<HexArray> views(workers.count());
+	for (size_t i = 1; i < views.size(); ++i) {
+		views[i] = arr.view();
+		assert(views[i].views(arr));
+	}
+	std::vector<Spread::List> lists(64);
+	workers.run(lists.size(), [&](size_t i, size_t worker) {
+		BasicSpread<> spr;
+		lists[i] = spr.applylist(worker ? views[worker] : arr, { 1, 1 }, 1);
+	});
+	for (const auto& list : lists)
+		assert(list == visited);
+
+	// tablice przesuniec: pierscien r ma 6r pol dla obu parzystosci wierszy
+	for (int row = 0; row < 2; ++row) {
+		for (size_t r = 1; r <= Radius::Max; ++r) {
+			assert(Radius::ring(r, row).size() == 6 * r);
+			for (auto off : Radius::ring(r, row))
+				assert(HexArray::distance({ 0, row }, sf::Vector2i{ 0, row } + off) == (int)r);
+		}
+		assert(Radius::disk(2, row).size() == 18);
+	}
+
+	// zapytanie o promien odwiedza te same pola co spread, takze przy krawedzi mapy
+	HexArray big;
+	big.empty({ 9, 9 });
+	for (sf::Vector2i mid : { sf::Vector2i{ 0, 0 }, sf::Vector2i{ 4, 3 }, sf::Vector2i{ 8, 7 }, sf::Vector2i{ 7, 8 } }) {
+		for (size_t r = 0; r <= 4; ++r) {
+			auto spread_list = BasicSpread<>{}.applylist(big, mid, r);
+			Spread::List radius_list;
+			Radius::each(big, mid, r, [&](const Spread::Tile& tile) {
+				assert(tile.left == r - (size_t)HexArray::distance(mid, tile.pos));
+				radius_list.push_back(tile.pos);
+			});
+			auto order = [](sf::Vector2i a, sf::Vector2i b) { return a.y != b.y ? a.y < b.y : a.x < b.x; };
+			std::sort(spread_list.begin(), spread_list.end(), order);
+			std::sort(radius_list.begin(), radius_list.end(), order);
+			assert(spread_list == radius_list);
+
+			// wersja wsadowa zwraca te same pola pierscien po pierscieniu
+			size_t batched = 0;
+			Radius::rings(big, mid, r, [&](size_t dist, std::span<const Spread::Tile> tiles) {
+				for (const auto& tile : tiles)
+					assert(HexArray::distance(mid, tile.pos) == (int)dist);
+				batched += tiles.size();
+			});
+			assert(batched == radius_list.size());
+		}
+	}
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "game/loader.hpp"
+#include "game/bot_ai.hpp"
+#include "game/serialize/messages.hpp"
+#include <cassert>
+#include <cstdio>
+
+using namespace Serialize;
+
+// przesyla wiadomosc przez koder i dekoder, tak jak adapter
+static Messages::Init transmit(const Messages::Init& init) {
+	std::vector<uint8_t> bytes;
+	{
+		ByteWriter writer(bytes);
+		encodeMessage(writer, init);
+	}
+	ByteReader reader(bytes.data(), bytes.size());
+	auto evt = decodeMessage(reader);
+	assert(evt && reader.end());
+	return std::get<Messages::Init>(*evt);
+}
+
+int main() {
+	for (const char* name : { MAP_PATH "test_map.dat", MAP_PATH "river.dat", MAP_PATH "triple.dat" }) {
+		auto file = Loader::load(name);
+		assert(file);
+		if (!file) return 1;
+
+		// host wykonuje ruchy botow przed startem, zeby regiony byly laczone
+		// i dzielone (bez logiki tur, szablon nie przenosi martwych regionow)
+		Map host;
+		file->temp.construct(&host);
+		host.random = Random::Generator(7);
+		std::vector<Messages::Player> players;
+		for (Region::Team team : ai::teams(host, Region::Unclaimed))
+			players.push_back({ .team = team });
+		for (int round = 0; round < 5; round++) {
+			for (const auto& player : players) {
+				host.history.clear();
+				ai::generate(host, player.team, 0.5f);
+			}
+		}
+
+		// klient odtwarza mape hosta z wiadomosci
+		Messages::Init init = Messages::init(&host, players, 0x1234abcdull);
+		assert(init.hash == host.hash());
+		Map client;
+		bool joined = Messages::join(&client, transmit(init));
+		assert(joined);
+		assert(client.hash() == host.hash());
+
+		// generatory po seedzie losuja to samo
+		for (int i = 0; i < 16; i++)
+			assert(client.random.u64() == host.random.u64());
+
+		// rozjechany szablon jest wykrywany
+		Messages::Init bad = transmit(init);
+		for (int i = 0; i < bad.temp.size().x * bad.temp.size().y; i++) {
+			HexBase& tile = bad.temp.at(i % bad.temp.size().x, i / bad.temp.size().x);
+			if (tile.type == Hex::Ground) {
+				tile.team = static_cast<Region::Team>((tile.team + 1) % Region::Count);
+				break;
+			}
+		}
+		Map other;
+		joined = Messages::join(&other, bad);
+		assert(!joined);
+
+		// wiadomosc bez hasha nie jest sprawdzana
+		bad.hash = 0;
+		joined = Messages::join(&other, bad);
+		assert(joined);
+		(void)joined;
+	}
+
+	std::printf("sync_tests: ok\n");
+	return 0;
+}
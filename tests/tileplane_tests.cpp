@@ -0,0 +1,116 @@
+#include "game/serialize/tileplane.hpp"
+#include <cassert>
+
+using namespace Serialize;
+
+// kodowanie i dekodowanie planszy, zwraca wybrana metode
+static TilePlane::Method roundtrip(const std::vector<uint8_t>& plane, size_t* size = nullptr) {
+	std::vector<uint8_t> data;
+	ByteWriter writer(data);
+	auto method = TilePlane::encode(writer, plane);
+	assert(writer);
+	if (size) *size = data.size();
+
+	std::vector<uint8_t> out(plane.size(), 0xEE);
+	ByteReader reader(data.data(), data.size());
+	bool valid = TilePlane::decode(reader, out);
+	assert(valid && reader && reader.end());
+	assert(out == plane);
+	(void)valid;
+	return method;
+}
+
+int main() {
+	// pusta plansza
+	assert(roundtrip({}) == TilePlane::Raw);
+
+	// szum bez powtorzen zostaje bez kompresji
+	{
+		std::vector<uint8_t> plane(4096);
+		uint32_t seed = 12345;
+		for (auto& byte : plane) {
+			seed = seed * 1103515245 + 12345;
+			byte = (uint8_t)(seed >> 16);
+		}
+		assert(roundtrip(plane) == TilePlane::Raw);
+	}
+
+	// kilka dlugich serii: same serie sa najmniejsze
+	{
+		std::vector<uint8_t> plane(1000, 0x00);
+		std::fill(plane.begin() + 300, plane.end(), 0x12);
+		size_t size = 0;
+		assert(roundtrip(plane, &size) == TilePlane::Runs);
+		assert(size == 1 + 4 + 2 * 5);
+	}
+
+	// duza mapa z obszarami druzyn: serie + huffman
+	{
+		const int side = 512;
+		std::vector<uint8_t> plane((size_t)side * side);
+		for (int y = 0; y < side; y++)
+			for (int x = 0; x < side; x++)
+				plane[(size_t)y * side + x] = (uint8_t)(((x / 40 + y / 24) % 5) << 4 | ((x * 7 + y) % 13 ? 2 : 1));
+		size_t size = 0;
+		assert(roundtrip(plane, &size) == TilePlane::Huffman);
+		assert(size < plane.size() / 4);
+	}
+
+	// bardzo nierowne czestosci (fibonacci) wymuszaja ograniczenie dlugosci kodow
+	{
+		std::vector<uint32_t> count = { 1, 1 };
+		while (count.size() < 24) count.push_back(count[count.size() - 1] + count[count.size() - 2]);
+		std::vector<uint8_t> plane;
+		bool left = true;
+		while (left) {
+			left = false;
+			for (size_t s = 0; s < count.size(); s++) {
+				if (!count[s]) continue;
+				plane.push_back((uint8_t)s);
+				count[s]--;
+				left = true;
+			}
+		}
+		roundtrip(plane);
+	}
+
+	// uszkodzone dane sa odrzucane
+	{
+		std::vector<uint8_t> plane(2000, 0x21);
+		for (size_t i = 0; i < plane.size(); i += 37) plane[i] = 0x13;
+		std::vector<uint8_t> data;
+		ByteWriter writer(data);
+		TilePlane::encode(writer, plane);
+
+		// obciete dane
+		{
+			std::vector<uint8_t> out(plane.size());
+			ByteReader reader(data.data(), data.size() - 1);
+			assert(!TilePlane::decode(reader, out) && !reader);
+		}
+		// zly rozmiar planszy
+		{
+			std::vector<uint8_t> out(plane.size() + 1);
+			ByteReader reader(data.data(), data.size());
+			assert(!TilePlane::decode(reader, out) && !reader);
+		}
+		// nieznana metoda
+		{
+			std::vector<uint8_t> bad = data;
+			bad[0] = TilePlane::Count;
+			std::vector<uint8_t> out(plane.size());
+			ByteReader reader(bad.data(), bad.size());
+			assert(!TilePlane::decode(reader, out) && !reader);
+		}
+		// za dlugie kody
+		{
+			std::vector<uint8_t> bad = data;
+			assert(bad[0] == TilePlane::Huffman);
+			bad[5] = 0xFF;
+			std::vector<uint8_t> out(plane.size());
+			ByteReader reader(bad.data(), bad.size());
+			assert(!TilePlane::decode(reader, out) && !reader);
+		}
+	}
+	return 0;
+}
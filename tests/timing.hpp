@@ -0,0 +1,9 @@
+#pragma once
+
+// pomiar czasu w testach wydajnosci
+#include <chrono>
+
+// milisekundy od podanej chwili
+inline double ms_since(std::chrono::steady_clock::time_point t0) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
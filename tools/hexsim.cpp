@@ -0,0 +1,270 @@
+#include "game/loader.hpp"
+#include "game/bot_ai.hpp"
+#include "game/logic/turn_logic.hpp"
+#include "game/move_log.hpp"
+#include "game/serialize/moves.hpp"
+#include "workers.hpp"
+#include "flags.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/// Headless bot-vs-bot simulation runner.
+///
+/// Usage: `hexsim <map.dat> [games] [turn limit] [difficulty] [seed]`
+///
+/// Runs independent games in parallel on all cores and reports
+/// throughput, win rates and per-phase timings.
+/// Set `HEXSIM_VERIFY` to check tile counters & region index against full map scans.
+/// Set `HEXSIM_SEARCH` to move troops with the lookahead search, optionally
+/// to a per-turn time budget in milliseconds (scaled by difficulty otherwise).
+/// Set `HEXSIM_LOG` to record all moves into compact move logs and report their size.
+
+/// Team names.
+static const char* team_names[Region::Count] = {
+	"unclaimed", "red", "orange", "yellow", "green",
+	"aqua", "blue", "purple", "pink",
+};
+
+/// Simulation phases.
+enum Phase {
+	AI,     /// Bot move generation.
+	Turn,   /// Player turn transition.
+	Win,    /// Game over check.
+	Global, /// Global turn transition.
+	PhaseCount
+};
+
+/// Phase names.
+static const char* phase_names[PhaseCount] = {
+	"ai::generate", "logic::turn", "logic::win", "logic::global"
+};
+
+/// Move log statistics.
+struct LogStats {
+	size_t moves = 0;   /// Logged move count.
+	size_t bytes = 0;   /// Compact log size (in bytes).
+	size_t objects = 0; /// Shallow size of move objects (in bytes).
+	double encode = 0;  /// Time spent encoding (in seconds).
+	double decode = 0;  /// Time spent decoding (in seconds).
+};
+
+/// Simulated game result.
+struct Result {
+	Region::Team winner = Region::Unclaimed; /// Victorious team.
+	uint32_t turns = 0;                      /// Played turn count.
+	size_t moves = 0;                        /// Bot move count.
+	ai::SearchStats search;                  /// Lookahead search statistics.
+	LogStats log;                            /// Move log statistics.
+	double time[PhaseCount] = {};            /// Time spent in each phase (in seconds).
+};
+
+/// Simulation settings.
+struct Settings {
+	Template temp;           /// Map template.
+	uint32_t limit = 500;    /// Turn limit.
+	float diff = 0.5f;       /// Bot difficulty.
+	uint64_t seed = 1;       /// Base seed.
+	bool search = false;     /// Whether to use lookahead search.
+	bool log = false;        /// Whether to record move logs.
+	ai::SearchConfig config; /// Lookahead search settings.
+};
+
+/// Measures time elapsed since a point in time.
+///
+/// @param start Starting point, restarted after the measurement.
+///
+/// @return Elapsed time in seconds.
+static double elapsed(std::chrono::steady_clock::time_point& start) {
+	auto now = std::chrono::steady_clock::now();
+	double time = std::chrono::duration<double>(now - start).count();
+	start = now;
+	return time;
+};
+
+/// Shallow object size of every move type.
+static const size_t move_sizes[Serialize::M_Count] = {
+	sizeof(Moves::EntityPlace), sizeof(Moves::EntityWithdraw), sizeof(Moves::EntityEffect),
+	sizeof(Moves::TroopMove), sizeof(Moves::TroopMerge), sizeof(Moves::TroopAttack), sizeof(Moves::TroopHeal),
+	sizeof(Moves::RadiusEffect), sizeof(Moves::PlantCut), sizeof(Moves::PlantMod),
+	sizeof(Moves::EntityChange), sizeof(Moves::RegionChange),
+};
+
+/// Records a move list into a compact log.
+///
+/// @param stats Log statistics.
+/// @param list Recorded moves.
+static void record(LogStats& stats, History::SpanList list) {
+	auto clock = std::chrono::steady_clock::now();
+
+	// encode & decode the list
+	MoveLog log;
+	log.push(list);
+	stats.encode += elapsed(clock);
+	auto moves = log.decode();
+	stats.decode += elapsed(clock);
+
+	// sum up sizes
+	stats.moves += log.size();
+	stats.bytes += log.bytes();
+	for (size_t i = 0; i < log.size(); i++) {
+		if (log.at(i).tag < Serialize::M_Count)
+			stats.objects += move_sizes[log.at(i).tag];
+	};
+};
+
+/// Plays a single game to completion.
+///
+/// @param set Simulation settings.
+/// @param index Game index.
+///
+/// @return Game result.
+static Result play(const Settings& set, size_t index) {
+	Result res;
+
+	// construct the map
+	Map map;
+	set.temp.construct(&map);
+	map.random = Random::Generator(set.seed).stream(index);
+
+	// add a bot for every team
+	std::vector<Messages::Player> players;
+	for (Region::Team team : ai::teams(map, Region::Unclaimed))
+		players.push_back({ .name = team_names[team], .team = team });
+	if (players.empty()) return res;
+
+	// play until someone wins
+	auto clock = std::chrono::steady_clock::now();
+	for (res.turns = 1; res.turns <= set.limit; res.turns++) {
+		for (const auto& player : players) {
+			// generate bot moves
+			map.history.clear();
+			ai::generate(map, player.team, set.diff, !set.search);
+			if (set.search)
+				ai::search(map, player.team, set.config, &res.search);
+			res.moves += map.history.count().first;
+			res.time[AI] += elapsed(clock);
+			if (set.log) {
+				record(res.log, map.history.log().decode());
+				elapsed(clock);
+			};
+
+			// tick player regions
+			auto changes = logic::turn(&map, player.team);
+			res.time[Turn] += elapsed(clock);
+			if (set.log) {
+				record(res.log, changes);
+				elapsed(clock);
+			};
+
+			// check for game over
+			res.winner = logic::win(logic::count(&map, players));
+			res.time[Win] += elapsed(clock);
+			if (res.winner != Region::Unclaimed)
+				return res;
+		};
+
+		// tick the map
+		auto changes = logic::global(&map);
+		res.time[Global] += elapsed(clock);
+		if (set.log) {
+			record(res.log, changes);
+			elapsed(clock);
+		};
+	};
+
+	// turn limit reached
+	res.turns = set.limit;
+	return res;
+};
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		fprintf(stderr, "usage: hexsim <map.dat> [games] [turn limit] [difficulty] [seed]\n");
+		return 1;
+	};
+
+	// load map template
+	auto file = Loader::load(argv[1]);
+	if (!file) return 1;
+
+	// read settings
+	Settings set;
+	set.temp = file->temp;
+	size_t games = argc > 2 ? strtoull(argv[2], nullptr, 10) : 16;
+	if (argc > 3) set.limit = (uint32_t)strtoul(argv[3], nullptr, 10);
+	if (argc > 4) set.diff = strtof(argv[4], nullptr);
+	if (argc > 5) set.seed = strtoull(argv[5], nullptr, 10);
+	if (getenv("HEXSIM_VERIFY")) flags::verify = true;
+	if (getenv("HEXSIM_LOG")) set.log = true;
+	if (const char* budget = getenv("HEXSIM_SEARCH")) {
+		set.search = true;
+		set.config = ai::SearchConfig::scaled(set.diff);
+		if (double ms = strtod(budget, nullptr); ms > 0)
+			set.config.budget = ms / 1000.0;
+	};
+
+	// run games in parallel
+	Workers workers;
+	std::vector<Result> results(games);
+	auto start = std::chrono::steady_clock::now();
+	workers.run(games, [&](size_t i, size_t) {
+		results[i] = play(set, i);
+	});
+	double wall = elapsed(start);
+
+	// sum up results
+	Result total;
+	size_t wins[Region::Count] = {};
+	for (const Result& res : results) {
+		total.turns += res.turns;
+		total.moves += res.moves;
+		total.search.add(res.search);
+		total.log.moves += res.log.moves;
+		total.log.bytes += res.log.bytes;
+		total.log.objects += res.log.objects;
+		total.log.encode += res.log.encode;
+		total.log.decode += res.log.decode;
+		for (int p = 0; p < PhaseCount; p++)
+			total.time[p] += res.time[p];
+		wins[res.winner]++;
+	};
+	double cpu = 0;
+	for (int p = 0; p < PhaseCount; p++)
+		cpu += total.time[p];
+
+	// print report
+	printf("hexsim: %s, %zu games on %zu threads in %.3f s\n",
+		file->name.c_str(), games, workers.count(), wall);
+	printf("  turns/s : %.1f\n", total.turns / wall);
+	printf("  moves/s : %.1f\n", total.moves / wall);
+	printf("  turns   : %.1f per game\n", games ? (double)total.turns / games : 0.0);
+	if (set.search) {
+		printf("search:\n");
+		printf("  nodes/s : %.1f\n", total.search.rate());
+		printf("  nodes   : %zu (%zu table hits)\n", total.search.nodes, total.search.hits);
+		printf("  actions : %zu\n", total.search.moves);
+		printf("  depth   : %d\n", total.search.depth);
+	};
+	if (set.log && total.log.moves) {
+		const LogStats& log = total.log;
+		printf("move log:\n");
+		printf("  moves   : %zu\n", log.moves);
+		printf("  log     : %.1f bytes/move\n", (double)log.bytes / log.moves);
+		printf("  objects : %.1f bytes/move (without heap payloads)\n", (double)log.objects / log.moves);
+		printf("  encode  : %.1f moves/s\n", log.encode > 0 ? log.moves / log.encode : 0.0);
+		printf("  decode  : %.1f moves/s\n", log.decode > 0 ? log.moves / log.decode : 0.0);
+	};
+	printf("wins:\n");
+	for (int t = 0; t < Region::Count; t++) {
+		if (!wins[t]) continue;
+		printf("  %-9s: %zu (%.1f%%)\n", t ? team_names[t] : "none",
+			wins[t], 100.0 * wins[t] / games);
+	};
+	printf("phases:\n");
+	for (int p = 0; p < PhaseCount; p++) {
+		printf("  %-13s: %.3f s (%.1f%%)\n", phase_names[p],
+			total.time[p], cpu > 0 ? 100.0 * total.time[p] / cpu : 0.0);
+	};
+	return 0;
+};